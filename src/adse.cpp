@@ -33,6 +33,9 @@
  */
 
 #include <vector>
+#include <chrono>
+#include <sstream>
+#include <memory>
 
 #include "applications/sdfgraph.hpp"
 #include "platform/platform.hpp"
@@ -43,6 +46,8 @@
 #include "execution/execution.cpp"
 #include "presolving/presolver.cpp"
 #include "settings/input_reader.hpp"
+#include "settings/input_cache.hpp"
+#include "settings/batch_jobs.hpp"
 #include "cp_model/schedulability.hpp"
 #include "validation/validation.hpp"
 
@@ -54,26 +59,26 @@ using namespace Gecode;
 using namespace Int;
 
 
-int main(int argc, const char* argv[]) {
-
-  cout << "DeSyDe - Analytical Design Space Exploration Tool\n";
+/**
+ * Runs one design space exploration with the inputs and settings of cfg.
+ * The input documents, the platform and the SDF graphs are taken from the
+ * cache, so that consecutive runs of a batch parse them only once.
+ */
+int runDSE(Config& cfg, InputCache& cache) {
   int exit_status = 0;
+  auto load_start = chrono::steady_clock::now();
+  size_t snapshot_hits = cache.snapshotHits(), snapshot_writes = cache.snapshotWrites();
+  cache.setSnapshotDir(cfg.settings().snapshot_dir);
 
-  Config cfg;
+    //objects of this job, freed when it ends (the model first); the cached ones belong to the cache
+    unique_ptr<TaskSet> taskset;
+    unique_ptr<Platform> tdnPlatform; //the TDN configuration modifies the platform, it is not cached
+    unique_ptr<SDFGraph> tdnGraph;
+    unique_ptr<Applications> appset;
+    unique_ptr<Mapping> map;
+    unique_ptr<SDFPROnlineModel> model;
 
-  try {
-    if (cfg.parse(argc, argv))
-      return 0;
-  } catch (DeSyDe::Exception& ex) {
-    cout << ex.toString() << endl;
-    return 1;
-  }
-
-  try {
-    
-	  
-	  TaskSet* taskset;
-	  Platform* platform;
+	  Platform* platform = nullptr;
     string platform_path;
 	  string WCET_path;
 	  string desConst_path;
@@ -82,27 +87,26 @@ int main(int argc, const char* argv[]) {
        /// Reading taskset
       size_t found_taskset=path.find("taskset");
       if(found_taskset != string::npos){
-        XMLdoc xml(path);
         LOG_INFO("Parsing taskset XML files...");
-        xml.read(false);
-        taskset =  new TaskSet(xml);
+        taskset.reset(new TaskSet(*cache.document(path)));
         if (taskset->getNumberOfTasks() > 0) {
           taskset->SetRMPriorities();
           LOG_INFO(tools::toString(*taskset));
         } else {
           LOG_INFO("did not import any periodic tasks!");
         }
-      }else{
-        taskset =  new TaskSet();
       }
 	   /// Reading platform
        size_t found_platform=path.find("platform");
        if(found_platform != string::npos){
-			XMLdoc xml(path);
       platform_path = path;
 			LOG_INFO("Parsing platform XML file...");
-			xml.read(false);
-			platform =  new Platform(xml);
+			if(!cfg.settings().configTDN){
+			  platform = cache.platform(path);
+			}else{ //the TDN configuration modifies the platform
+			  tdnPlatform.reset(new Platform(*cache.document(path)));
+			  platform = tdnPlatform.get();
+			}
 			LOG_INFO(tools::toString(*platform));
 	   }
 	   /// Storing WCET xml path
@@ -124,6 +128,8 @@ int main(int argc, const char* argv[]) {
 			 LOG_INFO("Storing mappingRules XML file...");
 	   }
      }
+    if(!taskset)
+      taskset.reset(new TaskSet());
 	
     
     vector<SDFGraph*> sdfs;
@@ -132,55 +138,57 @@ int main(int argc, const char* argv[]) {
       for (const auto& path : cfg.settings().inputs_paths) {
        
          if(path.find("/sdfs/") != string::npos){		
-             XMLdoc xml(path);
-             xml.readXSD("sdf3", "noNamespaceSchemaLocation");
-             sdfs.push_back(new SDFGraph(xml));
+             sdfs.push_back(cache.sdfGraph(path, cfg.settings().group_firings));
          }
        }
      }else{ //create an SDF based on platform
-        XMLdoc xml(platform_path); //because the SDFGraph class has an XMLdoc as a reference member
-        sdfs.push_back(new SDFGraph(platform, xml));
+        //the cached document outlives the graph, which keeps a reference to it
+        tdnGraph.reset(new SDFGraph(platform, *cache.document(platform_path)));
+        sdfs.push_back(tdnGraph.get());
      }
 
     LOG_INFO("Creating an application object ... ");
-    Applications* appset;
     if(desConst_path != ""){
-      XMLdoc xml_const(desConst_path);
-      xml_const.read(false);
-      appset = new Applications(sdfs, taskset, xml_const);
+      appset.reset(new Applications(sdfs, taskset.get(), *cache.document(desConst_path)));
     }else{
-      appset = new Applications(sdfs, taskset);
+      appset.reset(new Applications(sdfs, taskset.get()));
     }
     LOG_INFO(tools::toString(*appset));
 
 	LOG_INFO("Creating a mapping object ... \n" );
-    Mapping* map;
     
+    const vector<vector<vector<int>>>* wcet_table = nullptr;
     if(!cfg.settings().configTDN){
-      XMLdoc xml_wcet(WCET_path);
-      xml_wcet.read(false);
+      wcet_table = cache.wcetTable(WCET_path, appset.get(), platform);
+    }
+    if(wcet_table){
+      map.reset(new Mapping(appset.get(), platform, *wcet_table,
+                            desConst_path != "" ? cache.document(desConst_path) : nullptr,
+                            mappingRules_path != "" ? cache.document(mappingRules_path) : nullptr));
+    }else if(!cfg.settings().configTDN){
+      XMLdoc xml_wcet(WCET_path); //not read, the WCETs are streamed from the file
       if(mappingRules_path != ""){
-        XMLdoc xml_mapRules(mappingRules_path);
-        xml_mapRules.read(false);
+        XMLdoc& xml_mapRules = *cache.document(mappingRules_path);
         if(desConst_path != ""){
-          XMLdoc xml_const(desConst_path);
-          xml_const.read(false);
-          map = new Mapping(appset, platform, xml_wcet, xml_const, xml_mapRules);
+          map.reset(new Mapping(appset.get(), platform, xml_wcet, *cache.document(desConst_path), xml_mapRules));
         }else{
-          map = new Mapping(appset, platform, xml_wcet, xml_mapRules);
+          map.reset(new Mapping(appset.get(), platform, xml_wcet, xml_mapRules));
         }
       }else{
         if(desConst_path != ""){
-          XMLdoc xml_const(desConst_path);
-          xml_const.read(false);
-          map = new Mapping(appset, platform, xml_wcet, xml_const);
+          map.reset(new Mapping(appset.get(), platform, xml_wcet, *cache.document(desConst_path)));
         }else{
-          map = new Mapping(appset, platform, xml_wcet);
+          map.reset(new Mapping(appset.get(), platform, xml_wcet));
         }
       }
+      cache.storeWCETTable(WCET_path, appset.get(), platform, map->getWCETTable());
     }else{
-      map = new Mapping(appset, platform);
+      map.reset(new Mapping(appset.get(), platform));
     }
+    LOG_INFO("Inputs loaded in " + tools::toString(chrono::duration_cast<chrono::milliseconds>(
+                 chrono::steady_clock::now() - load_start).count()) + " ms ("
+             + tools::toString(cache.snapshotHits() - snapshot_hits) + " objects from snapshots, "
+             + tools::toString(cache.snapshotWrites() - snapshot_writes) + " snapshots written)");
     
     if(appset->n_IPTTasks()>0){
       LOG_INFO("Sorting pr tasks based on utilization ... ");
@@ -190,15 +198,13 @@ int main(int argc, const char* argv[]) {
 
     //PRESOLVING +++
     
-    SDFPROnlineModel* model;
-    
     if(cfg.doPresolve() || cfg.doMultiStep()){
 
       LOG_INFO("Creating PRESOLVING and MULTI-STEP execution object ... ");
       Presolver<OneProcModel, SDFPROnlineModel> presolver(cfg);
 
       LOG_INFO("Running PRESOLVING and MULTI-STEP object ... ");
-      model = (SDFPROnlineModel*)presolver.presolve(map);
+      model.reset((SDFPROnlineModel*)presolver.presolve(map.get()));
 
       if(cfg.doPresolve()){
         LOG_INFO("Presolver found " + tools::toString(presolver.getMappingResults().size()) + " isolated mappings.");
@@ -208,7 +214,7 @@ int main(int argc, const char* argv[]) {
       LOG_INFO("No PRESOLVER specified.");
       
       if(!cfg.settings().configTDN){
-        model = new SDFPROnlineModel(map, &cfg);
+        model.reset(new SDFPROnlineModel(map.get(), &cfg));
       }
     }
 
@@ -218,19 +224,98 @@ int main(int argc, const char* argv[]) {
     //SDFPROnlineModel* model = new SDFPROnlineModel(map, &cfg);
 //
     LOG_INFO("Creating an execution object ... ");
-    Execution<SDFPROnlineModel> execObj(model, cfg);
+    Execution<SDFPROnlineModel> execObj(model.get(), cfg);
     
+    vector<uint64_t> input_hashes; //identify the inputs of checkpoints
+    if(cfg.settings().checkpoint_interval > 0 || cfg.settings().resume){
+      for(const auto& path : cfg.settings().inputs_paths){
+        input_hashes.push_back(cache.contentHash(path));
+      }
+    }
     LOG_INFO("Running the model object ... ");
-    execObj.Execute(map);
+    execObj.Execute(map.get(), input_hashes);
 
 //    Validation* val = new Validation(map, cfg);
 //    val->Validate();
 
     return exit_status;
+}
+
+/**
+ * Runs the jobs of a batch file or server, reusing the parsed inputs.
+ * One result line is reported per job.
+ */
+int runBatch(const Config& cfg) {
+  InputCache cache;
+  BatchJobs jobs(cfg.settings().batch_path, cfg.settings().batch_socket);
+  if(!cfg.settings().batch_socket.empty())
+    LOG_INFO("Serving batch jobs on \'" + cfg.settings().batch_socket + "\'");
+
+  int n_jobs = 0, n_failed = 0;
+  string job;
+  while(jobs.next(job)){
+    n_jobs++;
+    auto start = chrono::steady_clock::now();
+    size_t hits = cache.hits(), misses = cache.misses();
+    string status = "ok", output;
+    try {
+      vector<string> args = BatchJobs::arguments(job);
+      vector<const char*> argv;
+      for(auto& a : args)
+        argv.push_back(a.c_str());
+      Config job_cfg;
+      if(job_cfg.parse(argv.size(), argv.data())){
+        status = "skipped";
+      }else{
+        output = job_cfg.settings().output_path;
+        LOG_INFO("Batch job " + tools::toString(n_jobs) + ": " + job);
+        if(runDSE(job_cfg, cache))
+          status = "failed";
+      }
+    } catch (DeSyDe::Exception& ex) {
+      cout << ex.toString() << endl;
+      status = "error";
+    } catch (std::exception& ex) {
+      cout << ex.what() << endl;
+      status = "error";
+    }
+    if(status != "ok" && status != "skipped")
+      n_failed++;
+    auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    stringstream result;
+    result << "job " << n_jobs << " " << status << " " << ms << " ms"
+           << " (inputs reused: " << cache.hits() - hits << ", parsed: " << cache.misses() - misses << ")";
+    if(!output.empty())
+      result << " output: " << output;
+    jobs.report(result.str());
+  }
+  LOG_INFO("Batch finished: " + tools::toString(n_jobs) + " jobs, " + tools::toString(n_failed) + " failed.");
+  return n_failed > 0;
+}
+
+int main(int argc, const char* argv[]) {
+
+  cout << "DeSyDe - Analytical Design Space Exploration Tool\n";
+
+  Config cfg;
+
+  try {
+    if (cfg.parse(argc, argv))
+      return 0;
   } catch (DeSyDe::Exception& ex) {
     cout << ex.toString() << endl;
     return 1;
   }
 
-}
+  try {
+    if (cfg.doBatch())
+      return runBatch(cfg);
 
+    InputCache cache;
+    return runDSE(cfg, cache);
+  } catch (DeSyDe::Exception& ex) {
+    cout << ex.toString() << endl;
+    return 1;
+  }
+
+}
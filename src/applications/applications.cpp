@@ -10,8 +10,7 @@ Applications::Applications() {
 }
 
 Applications::~Applications() {
-  for (size_t i=0; i<sdfApps.size(); i++)
-    delete sdfApps[i];
+  //the SDF graphs and the task set belong to the caller (possibly the InputCache)
   for (size_t i=0; i<desContr.size(); i++)
     delete desContr[i];
 }
@@ -384,16 +383,6 @@ bool Applications::isPreemtable(size_t id){
   return false;
 }
 
-//get all possible hyperperiods
-vector<int> Applications::getHyperperiods(){
-  if(n_iptTasks>0){
-    return iptApps->getHyperperiods();
-  }else{
-    vector<int> h_periods;
-    return h_periods;
-  }
-}
-
 //get maximum hyperperiod
 int Applications::getMaxHyperperiod(){
   if(n_iptTasks>0)
@@ -454,6 +443,14 @@ int Applications::getParentActor(size_t id){
   }
 }
 
+size_t Applications::getFirings(size_t id){
+  if(isSDF(id)){
+    int app = getSDFGraph(id);
+    return sdfApps[app]->getFirings(id-offsets[app]);
+  }
+  return 1;
+}
+
 //get the instance of parentActor id with the highest index (the "last" one)
 int Applications::getLastFiring(size_t id){
   if(id>=n_sdfParentActors){
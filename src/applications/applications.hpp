@@ -43,11 +43,11 @@ using namespace std;
 class Applications {
 
 protected:
-  vector<SDFGraph*> sdfApps;
+  vector<SDFGraph*> sdfApps; //not owned
   vector<DesignConstraints*> desContr;
   //keep track of difference between local id and global id of sdf actors
   vector<size_t> offsets;
-  TaskSet* iptApps;
+  TaskSet* iptApps; //not owned
 
   size_t n_sdfActors;
   size_t n_sdfParentActors;
@@ -117,8 +117,6 @@ public:
   int getDeadline(size_t id);
   //task preemptable?
   bool isPreemtable(size_t id);
-  //get all possible hyperperiods
-  vector<int> getHyperperiods();
   //get maximum hyperperiod
   int getMaxHyperperiod();
   //get maximum number of instances of task id
@@ -142,6 +140,8 @@ public:
   size_t getSDFGraph(size_t id);
   //get the actor from which id originates (if SDF firing)
   int getParentActor(size_t id);  
+  //get the number of firings of its parent actor that entity id executes (1 unless firings are grouped)
+  size_t getFirings(size_t id);
   //get the instance of actor id with the highest index (the "last" 
   int getLastFiring(size_t id);
   //get a list of predecessors of program entity id
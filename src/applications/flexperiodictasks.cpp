@@ -94,12 +94,10 @@ using namespace std;
     unsigned t = tasks.size();
     unsigned n = (int)pow(2.0, (double)t) - 1;
     for(unsigned i=1; i<=n; i++){
-      cout << " i: " << std::bitset<8>(i) << endl;
       vector<vector<int>> periods;
       for(unsigned j=0; j<t; j++){
         if(std::bitset<32>(i)[j]){
           periods.push_back(tasks[j].period);
-          cout << "  " << j << " is in." << endl;
         }
       }
       vector<int> lcm_periods(1, 1);
@@ -114,20 +112,8 @@ using namespace std;
         }
       }
       h_periods.push_back(lcm_periods);
-      cout << "  determined " << lcm_periods.size() << " hyperperiods." << endl;
       periods.clear();
     }
-    int combSum = 0;
-    for(unsigned j=0; j<h_periods.size(); j++){
-      //cout << std::bitset<8>(j) << " ";
-      //for(unsigned i=0; i<h_periods[j].size(); i++){
-        //cout << h_periods[j][i] << " | ";
-      //}
-      //cout << endl;
-      combSum += h_periods[j].size();
-    }
-    cout << "Resulting number of combinations = " << combSum << endl;
-    
     return h_periods;
   }
   
@@ -60,34 +60,6 @@ int TaskSet::getPeriod(int id) {
   return tasks[id]->period;
 }
 
-vector<int> TaskSet::getHyperperiods() {
-  vector<int> h_periods;
-  int t = tasks.size();
-  int n = (int)pow(2.0, (double)t) - 1;
-  for (int i=1; i<=n; i++){
-    vector<int> periods;
-    for (int j=1; j<=t; j++){
-      int mask = (int)pow(2.0, (double)(j-1));
-      if((i&mask)==mask){ 
-	int x = (int)(log((double)mask)/log(2));
-	periods.push_back(tasks[x]->period);
-      }
-    }
-    if(periods.size()==1){
-      h_periods.push_back(periods[0]);
-    }else{
-      int lcm=1;
-      for (size_t j=0; j<periods.size(); j++){
-	lcm = boost::math::lcm(lcm, periods[j]);
-      }
-      h_periods.push_back(lcm);
-    }
-    periods.clear();
-  }
-  if(h_periods.size() != (unsigned) n) cout << "TaskSet::getHyperperiods() went wrong.\n";
-  return h_periods;
-}
-
 int TaskSet::getDeadline(int id){
   return tasks[id]->deadline;
 }
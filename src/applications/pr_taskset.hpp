@@ -49,7 +49,6 @@ public:
     int getNumberOfTasks();
     int getPhase(int id);
     int getPeriod(int id);
-    vector<int> getHyperperiods();
     int getDeadline(int id);
     int getMemCons(int id); 
     int getCodeSize(int id);
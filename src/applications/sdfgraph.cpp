@@ -3,7 +3,7 @@
 #include <math.h>
 #include <algorithm>
 
-SDFGraph::SDFGraph(XMLdoc& xmlAppGraph) : xml(xmlAppGraph) {
+SDFGraph::SDFGraph(XMLdoc& xmlAppGraph, bool groupFirings) : xml(xmlAppGraph) {
   
   //Initializations
   parentActors 	     = 0;
@@ -15,15 +15,111 @@ SDFGraph::SDFGraph(XMLdoc& xmlAppGraph) : xml(xmlAppGraph) {
 
   _d = new dictionaries();
   buildDictionaries();
-  transform();
+  transform(groupFirings);
   createPathMatrix();
   if (_d) delete _d;
 
+  if (groupFirings) {
+    for (size_t a = 0; a < actors.size(); a++) {
+      if (precedes(a, a))
+        THROW_EXCEPTION(InvalidArgumentException, "group-firings",
+            "actor " + actors[a]->name + " of " + graphName + " depends on itself within an iteration;"
+            " its firings cannot be grouped. Disable the option for this graph.");
+    }
+  }
+
   LOG_DEBUG("SDFGraph intermediate representation built successfully");
   //LOG_DEBUG(getString());
 
 }
 
+SDFGraph::SDFGraph(XMLdoc& doc, tools::SnapshotReader& snap): xml(doc) {
+  period_constraint  = 0;
+  latency_constraint = 0;
+  _d = nullptr;
+
+  snap.get(graphName);
+  snap.get(parentActors);
+  size_t n_act = snap.getInt();
+  for(size_t i=0; i<n_act; i++){
+    SDFActor* a = new SDFActor();
+    snap.get(a->id);
+    snap.get(a->name);
+    snap.get(a->parent_id);
+    snap.get(a->parent_name);
+    snap.get(a->codeSize);
+    snap.get(a->dataSize);
+    snap.get(a->firings);
+    actors.push_back(a);
+  }
+  size_t n_ch = snap.getInt();
+  for(size_t i=0; i<n_ch; i++){
+    SDFChannel* ch = new SDFChannel();
+    snap.get(ch->id);
+    snap.get(ch->name);
+    snap.get(ch->source);
+    snap.get(ch->src_name);
+    snap.get(ch->prod);
+    snap.get(ch->destination);
+    snap.get(ch->dst_name);
+    snap.get(ch->cons);
+    snap.get(ch->initTokens);
+    snap.get(ch->tokenSize);
+    snap.get(ch->messageSize);
+    snap.get(ch->cost);
+    snap.get(ch->oldIds);
+    channels.push_back(ch);
+  }
+  pathWords = (actors.size() + 63) / 64;
+  pathMatrix.clear();
+  tokenFreePathMatrix.clear();
+  for(size_t w=0; w<actors.size() * pathWords; w++){
+    pathMatrix.push_back(snap.getInt());
+  }
+  for(size_t w=0; w<actors.size() * pathWords; w++){
+    tokenFreePathMatrix.push_back(snap.getInt());
+  }
+  indexChannels();
+  LOG_INFO("   ...application " + graphName + " (snapshot)");
+}
+
+void SDFGraph::save(tools::SnapshotWriter& snap) const {
+  snap.put(graphName);
+  snap.put(parentActors);
+  snap.put(actors.size());
+  for(auto a : actors){
+    snap.put(a->id);
+    snap.put(a->name);
+    snap.put(a->parent_id);
+    snap.put(a->parent_name);
+    snap.put(a->codeSize);
+    snap.put(a->dataSize);
+    snap.put(a->firings);
+  }
+  snap.put(channels.size());
+  for(auto ch : channels){
+    snap.put(ch->id);
+    snap.put(ch->name);
+    snap.put(ch->source);
+    snap.put(ch->src_name);
+    snap.put(ch->prod);
+    snap.put(ch->destination);
+    snap.put(ch->dst_name);
+    snap.put(ch->cons);
+    snap.put(ch->initTokens);
+    snap.put(ch->tokenSize);
+    snap.put(ch->messageSize);
+    snap.put(ch->cost);
+    snap.put(ch->oldIds);
+  }
+  for(auto w : pathMatrix){
+    snap.put((int64_t) w);
+  }
+  for(auto w : tokenFreePathMatrix){
+    snap.put((int64_t) w);
+  }
+}
+
 SDFGraph::SDFGraph(Platform* platform, XMLdoc& doc): xml(doc) {
   graphName = "TDNconfigG";
   parentActors 	     = platform->nodes();
@@ -42,7 +138,9 @@ SDFGraph::SDFGraph(Platform* platform, XMLdoc& doc): xml(doc) {
   }
   
   //create path matrix
-  pathMatrix.assign(actors.size() * actors.size(), simplePath());
+  pathWords = (actors.size() + 63) / 64;
+  pathMatrix.assign(actors.size() * pathWords, 0);
+  tokenFreePathMatrix.assign(actors.size() * pathWords, 0);
   
   //generate channels between all actors
   size_t id = 0;
@@ -61,12 +159,15 @@ SDFGraph::SDFGraph(Platform* platform, XMLdoc& doc): xml(doc) {
       channels[id]->tokenSize = platform->getFlitSize();
       channels[id]->messageSize = channels[id]->tokenSize;
       
-      pathMatrix[src * actors.size() + dst].exists = 1;
-      pathMatrix[src * actors.size() + dst].initTokens = channels[id]->initTokens;
+      pathMatrix[src * pathWords + dst / 64] |= 1ULL << (dst % 64);
+      if(!channels[id]->initTokens){
+        tokenFreePathMatrix[src * pathWords + dst / 64] |= 1ULL << (dst % 64);
+      }
       
       id++;
     }
   }
+  indexChannels();
   LOG_DEBUG("Path matrix of generated SDFG for TDN configuration:\n"+printPathMatrix());
 }
 
@@ -149,7 +250,7 @@ void SDFGraph::calculateRepetitionVector(vector<rational<int>>& firing, string a
   }
 }
 
-void SDFGraph::transform(){
+void SDFGraph::transform(bool groupFirings){
   auto& actor_id = _d->actor_id;
 
   LOG_DEBUG("Calculating repetition vector for " + graphName);
@@ -180,7 +281,12 @@ void SDFGraph::transform(){
 
   //Initiate corresponding transformation method
   bool isHSDF = all_of(rep_vec.begin(), rep_vec.end(), [](int i){return i==1;});
-  isHSDF ? transformFromHSDF() : transformFromSDF(rep_vec);
+  if (isHSDF)
+    transformFromHSDF();
+  else if (groupFirings)
+    transformGrouped(rep_vec);
+  else
+    transformFromSDF(rep_vec);
   
   //print graph into debug log file
   LOG_DEBUG("All " + tools::toString(actors.size()) + " actors of graph " + graphName +":");
@@ -188,7 +294,8 @@ void SDFGraph::transform(){
     LOG_DEBUG("actor " + tools::toString(i->id) + ": " + i->name
               + ", parent(id): " + i->parent_name + "(" + tools::toString(i->parent_id) +")"
               + "; code size: " + tools::toString(i->codeSize) 
-              + "; data size: " + tools::toString(i->dataSize));
+              + "; data size: " + tools::toString(i->dataSize)
+              + "; firings: " + tools::toString(i->firings));
   }
   
   LOG_DEBUG("All " + tools::toString(channels.size()) + " channels of graph " + graphName +":");
@@ -318,6 +425,79 @@ void SDFGraph::transformFromSDF(const vector<int>& rp) {
   }
 }
 
+void SDFGraph::transformGrouped(const vector<int>& rp) {
+  auto& rate     = _d->rate;
+  auto& actor_id = _d->actor_id;
+  auto& actor_sz = _d->actor_sz;
+  auto& chan_sz  = _d->chan_sz;
+  auto& init_tok = _d->init_tok;
+
+  LOG_DEBUG("Transforming graph " + graphName + " from SDF, grouping the firings of each actor...");
+
+  parentActors = actor_id.size();
+  actors.resize(parentActors);
+  auto actor_nodes = xml.xpathNodes("///sdf/actor");
+  for (auto& gA : actor_nodes) {
+    string a_name = xml.getProp(gA, "name");
+    int id = actor_id[a_name];
+    SDFActor* a = new SDFActor();
+    a->id          = id;
+    a->name        = a_name;
+    a->parent_id   = id;
+    a->parent_name = a_name;
+    a->codeSize    = actor_sz[a_name];
+    a->dataSize    = actor_sz[a_name];
+    a->firings     = rp[id];
+    actors[id] = a;
+  }
+
+  //one channel per pair of actors, parallel channels are combined
+  map<pair<int, int>, SDFChannel*> combined;
+  auto chan_nodes = xml.xpathNodes("///sdf/channel");
+  for (size_t i = 0; i < chan_nodes.size(); i++) {
+    auto gC = chan_nodes[i];
+    string ch_name = xml.getProp(gC, "name");
+    string src_act = xml.getProp(gC, "srcActor");
+    string dst_act = xml.getProp(gC, "dstActor");
+    string src_prt = xml.getProp(gC, "srcPort");
+
+    int srcId  = actor_id[src_act];
+    int dstId  = actor_id[dst_act];
+    //tokens produced (and consumed) on the channel per iteration
+    int tokens = rp[srcId] * rate[src_act][src_prt];
+    //a grouped firing of the consumer needs the tokens of a whole iteration
+    int delays = init_tok[ch_name] / tokens;
+    if (srcId == dstId)
+      delays = max(delays, 1); //the firings of an actor are sequential anyway
+
+    auto it = combined.find(make_pair(srcId, dstId));
+    if (it != combined.end()) {
+      SDFChannel* c = it->second;
+      c->initTokens   = min(c->initTokens, delays);
+      c->prod        += tokens;
+      c->cons        += tokens;
+      c->messageSize += tokens * chan_sz[ch_name];
+      c->oldIds.push_back(i);
+      continue;
+    }
+    SDFChannel* c = new SDFChannel();
+    c->id          = channels.size();
+    c->name        = ch_name;
+    c->source      = srcId;
+    c->src_name    = src_act;
+    c->prod        = tokens;
+    c->destination = dstId;
+    c->dst_name    = dst_act;
+    c->cons        = tokens;
+    c->initTokens  = delays;
+    c->tokenSize   = chan_sz[ch_name];
+    c->messageSize = tokens * c->tokenSize;
+    c->oldIds.push_back(i);
+    channels.push_back(c);
+    combined[make_pair(srcId, dstId)] = c;
+  }
+}
+
 void SDFGraph::transformFromHSDF() {
     auto& rate = _d->rate;
     auto& actor_id = _d->actor_id;
@@ -457,46 +637,99 @@ void SDFGraph::transformFromHSDF() {
     }
 }
 
-void SDFGraph::createPathMatrix() {
-    using namespace boost;
-    typedef adjacency_list<vecS, vecS, bidirectionalS> Graph;
-    typedef adjacency_list<> TcGraph;
-    pathMatrix.assign(actors.size() * actors.size(), simplePath());
-    const int num_vertices = actors.size();
+/**
+ * Transitive closure of a graph into bitset rows. The strongly connected
+ * components are found with Tarjan's algorithm, which completes them in
+ * reverse topological order: the row of a component is the union of the
+ * rows of the components it has edges to (64 actors per word operation),
+ * which are all complete at that point. O(|V| + |E| * |V|/64).
+ */
+static void closure(size_t n, const vector<vector<int>>& succ, size_t words, vector<uint64_t>& rows){
+  rows.assign(n * words, 0);
+  vector<int> index(n, -1), low(n, 0), component(n, -1);
+  vector<int> stack;
+  vector<pair<int, size_t>> call; //(actor, next successor to visit)
+  vector<uint64_t> row(words);
+  int counter = 0, n_components = 0;
+
+  for(size_t s=0; s<n; s++){
+    if(index[s] >= 0) continue;
+    index[s] = low[s] = counter++;
+    stack.push_back(s);
+    call.push_back(make_pair(s, 0));
+    while(!call.empty()){
+      int v = call.back().first;
+      if(call.back().second < succ[v].size()){
+        int w = succ[v][call.back().second++];
+        if(index[w] < 0){
+          index[w] = low[w] = counter++;
+          stack.push_back(w);
+          call.push_back(make_pair(w, 0));
+        }else if(component[w] < 0){ //on the stack
+          low[v] = min(low[v], index[w]);
+        }
+        continue;
+      }
+      call.pop_back();
+      if(!call.empty()){
+        int u = call.back().first;
+        low[u] = min(low[u], low[v]);
+      }
+      if(low[v] != index[v]) continue;
+
+      //v is the root of a component: the actors above it on the stack
+      size_t first = stack.size();
+      do {
+        first--;
+        component[stack[first]] = n_components;
+      } while(stack[first] != v);
+      fill(row.begin(), row.end(), 0);
+      for(size_t m=first; m<stack.size(); m++){
+        for(int w : succ[stack[m]]){
+          row[w / 64] |= 1ULL << (w % 64);
+          if(component[w] != n_components){
+            const uint64_t* r = &rows[w * words];
+            for(size_t k=0; k<words; k++){
+              row[k] |= r[k];
+            }
+          }
+        }
+      }
+      for(size_t m=first; m<stack.size(); m++){
+        copy(row.begin(), row.end(), rows.begin() + stack[m] * words);
+      }
+      stack.resize(first);
+      n_components++;
+    }
+  }
+}
 
-    Graph g(num_vertices);
-    TcGraph tc;
-    Graph g_noTokens(num_vertices);
-    TcGraph tc_noTokens;
+void SDFGraph::createPathMatrix() {
+    const size_t num_vertices = actors.size();
+    vector<vector<int>> succ(num_vertices);
+    vector<vector<int>> succ_noTokens(num_vertices);
 
     for(size_t k = 0; k < channels.size(); k++){
         int src = channels[k]->source;
         int dst = channels[k]->destination;
         int initTokens = channels[k]->initTokens;
         if(!initTokens){
-            add_edge(src, dst, g_noTokens);
+            succ_noTokens[src].push_back(dst);
         }
-        add_edge(src, dst, g);
+        succ[src].push_back(dst);
     }
 
-    transitive_closure(g, tc);
-    transitive_closure(g_noTokens, tc_noTokens);
-
-    graph_traits<TcGraph>::edge_iterator ei, ei_end;
-    for(tie(ei, ei_end) = edges(tc); ei != ei_end; ++ei){
-        auto src = boost::source(*ei, tc);
-        auto dst = boost::target(*ei, tc);
-
-        pathMatrix[src * actors.size() + dst].exists = 1;
-        pathMatrix[src * actors.size() + dst].initTokens = 1;
-    }
-    for(tie(ei, ei_end) = edges(tc_noTokens); ei != ei_end; ++ei){
-        auto src = boost::source(*ei, tc_noTokens);
-        auto dst = boost::target(*ei, tc_noTokens);
+    pathWords = (num_vertices + 63) / 64;
+    closure(num_vertices, succ, pathWords, pathMatrix);
+    closure(num_vertices, succ_noTokens, pathWords, tokenFreePathMatrix);
+    indexChannels();
+}
 
-        pathMatrix[src * actors.size() + dst].exists = 1;
-        pathMatrix[src * actors.size() + dst].initTokens = 0;
-    }
+void SDFGraph::indexChannels() {
+  channelIndex.clear();
+  for(size_t k = channels.size(); k-- > 0;){ //the first channel wins
+    channelIndex[channels[k]->source * actors.size() + channels[k]->destination] = k;
+  }
 }
 
 string SDFGraph::printPathMatrix() const {
@@ -509,8 +742,8 @@ string SDFGraph::printPathMatrix() const {
   for (size_t ii=0; ii<actors.size(); ii++){
     str += "    ";
     for (size_t ij=0; ij<actors.size(); ij++){
-      if(pathMatrix[ii*actors.size()+ij].exists){
-        str += tools::toString(pathMatrix[ii*actors.size()+ij].initTokens);
+      if(pathExists(ii, ij)){
+        str += tools::toString(tokensOnPath(ii, ij));
         str +=  " | ";
       }else{
         str += "- | ";
@@ -693,6 +926,13 @@ int SDFGraph::getParentId(size_t p_actor) const{
   return -1;
 }
 
+size_t SDFGraph::getFirings(size_t p_actor) const{
+  if(p_actor<actors.size()){
+    return actors[p_actor]->firings;
+  }
+  return 0;
+}
+
 size_t SDFGraph::getCodeSize(size_t p_actor) const{
   if(p_actor<actors.size()){
     return actors[p_actor]->codeSize;
@@ -765,50 +1005,37 @@ vector<SDFActor*> SDFGraph::getSuccessors(int p_actor) const{
 // Checks whether a channel between src and dst exists in the graph,
 // with or without initial tokens
 bool SDFGraph::channelExists(int p_src, int p_dst) const{
-    
-  for (size_t k=0; k<channels.size(); k++){
-    SDFChannel* ch = channels[k];
-    if(ch->source==p_src && ch->destination==p_dst){
-      return true;
-    } 
-  } 
-  return false;
+  return channelIndex.count(p_src * actors.size() + p_dst) > 0;
 }
 
 // Gives the number of initial tokens on an edge from src to dst
 // in case there is no edge from src to dst, it returns -1
 int SDFGraph::tokensOnChannel(int p_src, int p_dst) const{
-  for (size_t k=0; k<channels.size(); k++){
-    SDFChannel* ch = channels[k];
-    if(ch->source==p_src && ch->destination==p_dst){
-      return ch->initTokens;
-    } 
-  } 
-  return -1;
+  auto it = channelIndex.find(p_src * actors.size() + p_dst);
+  if(it == channelIndex.end()){
+    return -1;
+  }
+  return channels[it->second]->initTokens;
 }
 
 // Checks whether a path between src and dst exists in the graph
 bool SDFGraph::pathExists(int p_src, int p_dst) const{
-  return pathMatrix[p_src*actors.size()+p_dst].exists;
+  return pathBit(pathMatrix, p_src, p_dst);
 }
 
 // Are there any initial tokens on the path from src to dst?
 bool SDFGraph::tokensOnPath(int p_src, int p_dst) const{
-  return pathMatrix[p_src*actors.size()+p_dst].initTokens;
+  return pathBit(pathMatrix, p_src, p_dst) && !pathBit(tokenFreePathMatrix, p_src, p_dst);
 }
 
 //does actorI precede actor J in G (i.e. there is a path from i to j with no tokens)?
 bool SDFGraph::precedes(int p_actorI, int p_actorJ) const{
-  return (pathExists(p_actorI, p_actorJ) && !tokensOnPath(p_actorI, p_actorJ));  
+  return pathBit(tokenFreePathMatrix, p_actorI, p_actorJ);
 }
 
 //Are firings firingI and firingI independent in G?
 bool SDFGraph::independent(int p_actorI, int p_actorJ) const{
-  return ((!pathExists(p_actorI,p_actorJ) && !pathExists(p_actorJ,p_actorI)) || 
-          ((pathExists(p_actorI,p_actorJ) && tokensOnPath(p_actorI, p_actorJ)>0) && 
-           (!pathExists(p_actorJ,p_actorI) || (pathExists(p_actorJ,p_actorI) && tokensOnPath(p_actorJ, p_actorI)>0))) ||
-          ((pathExists(p_actorJ, p_actorI) && tokensOnPath(p_actorJ, p_actorI)>0) && 
-           (!pathExists(p_actorI,p_actorJ) || (pathExists(p_actorI,p_actorJ) && tokensOnPath(p_actorI,p_actorJ)>0))));
+  return !precedes(p_actorI, p_actorJ) && !precedes(p_actorJ, p_actorI);
 }
 
 int SDFGraph::getPeriodConstraint() const {
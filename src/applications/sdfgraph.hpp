@@ -28,9 +28,10 @@
 #define DESYDE_SDFGRAPH__
 
 
+#include <map>
 #include <unordered_map>
+#include <cstdint>
 
-#include <boost/graph/transitive_closure.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/rational.hpp>
@@ -38,6 +39,7 @@
 
 #include "../xml/xmldoc.hpp"
 #include "../platform/platform.hpp"
+#include "../tools/snapshot.hpp"
 
 using namespace std;
 using boost::rational;
@@ -54,6 +56,7 @@ public:
   string parent_name; /*!< Name of the actor in the SDF from which this actor was generated. */
   size_t codeSize;    /*!< Code size of the actor. */
   size_t dataSize;    /*!< Data size of the actor. */
+  size_t firings = 1; /*!< Number of firings of the parent actor that this actor executes in a row. */
 };
 
 /**
@@ -77,17 +80,6 @@ public:
                          that the channel originated from. */
 };
 
-/**
- * Trivial class to combine number of initial tokens with the existence of a path.
- */
-class simplePath {
-public:
-  bool exists;     /*!< Existence of the path. */
-  bool initTokens; /*!< Numbers of initial tokens on the path. */
-  simplePath():exists(0),initTokens(0) {};
-};
-
-
 /**
  * This class represents the input SDF graph.
  * It transforms the input graph in SDF3-format into the internal,
@@ -134,8 +126,16 @@ protected:
   size_t parentActors;
   
   //! Matrix containing all existing paths in the graph
-  //! (i.e. transitive closure of the graph).
-  vector<simplePath> pathMatrix;
+  //! (i.e. transitive closure of the graph), as one bitset over the
+  //! actors per source actor: bit dst of row src is set if there is a
+  //! path from src to dst.
+  vector<uint64_t> pathMatrix;
+  //! Same for the paths without initial tokens.
+  vector<uint64_t> tokenFreePathMatrix;
+  //! 64-bit words per row of the path matrices.
+  size_t pathWords;
+  //! Index of the (first) channel from src to dst, by src*|actors|+dst.
+  unordered_map<size_t, int> channelIndex;
   
   int period_constraint;  /**< max period constraint for the sdf graph. */
   int latency_constraint; /**< max latency constraint for the sdf graph. */
@@ -150,7 +150,7 @@ protected:
    * parallel edges). It first identifies the type of graph in the 
    * XML file (SDF or HSDF) and then initiates the transformation.
    */
-  void transform();
+  void transform(bool groupFirings);
   
   /**
    * The transformFromSDF function creates the internal SDF graph by
@@ -172,12 +172,33 @@ protected:
    * by adding the two sizes.
    */
   void transformFromHSDF();
+
+  /**
+   * The transformGrouped function creates the internal graph with one
+   * actor per SDF actor, which executes all its firings of an iteration
+   * in a row (firings = repetition count). A channel carries the tokens of
+   * one iteration per firing, and its initial tokens are the number of
+   * whole iterations they cover. The result is single-rate, so the model
+   * and the throughput analysis scale with the SDF actors instead of the
+   * firings, at the price of forcing the firings of an actor onto one
+   * processor, back to back.
+   */
+  void transformGrouped(const std::vector<int>& rp);
   
   /** 
    * Creates a matrix (in form of a vector) with all existing paths in the graph
    * (transitive closure of the graph)
    */
   void createPathMatrix();
+
+  /**
+   * Fills channelIndex from the channels.
+   */
+  void indexChannels();
+
+  bool pathBit(const vector<uint64_t>& matrix, int p_src, int p_dst) const {
+    return (matrix[p_src * pathWords + p_dst / 64] >> (p_dst % 64)) & 1;
+  }
   
   /** 
    * Prints the path matrix on the screen, for debugging purposes.
@@ -193,8 +214,22 @@ public:
 
   /**
    * Constructor. Creates an SDFGraph from the SDF3 representation of the graph.
+   * @param groupFirings one actor per SDF actor instead of the HSDF expansion
+   *        (see transformGrouped)
+   */
+  SDFGraph(XMLdoc& doc, bool groupFirings = false);
+
+  /**
+   * Constructor. Restores an SDFGraph (HSDF expansion and path matrix) from
+   * a snapshot written by save(). The document is only kept as reference
+   * and is not read.
    */
-  SDFGraph(XMLdoc& doc);
+  SDFGraph(XMLdoc& doc, tools::SnapshotReader& snap);
+
+  /**
+   * Writes the built graph to a snapshot. Design constraints are not stored.
+   */
+  void save(tools::SnapshotWriter& snap) const;
   
   /**
    * Constructor. Creates an SDFGraph for TDN config of the platform model.
@@ -284,6 +319,13 @@ public:
    */
   int getParentId(size_t p_actor) const;
 
+  /**
+   * Gives the number of firings of the parent actor executed by the actor.
+   * @param p_actor Id of the (child) actor.
+   * @returns 1 for an HSDF firing, the repetition count for a grouped actor.
+   */
+  size_t getFirings(size_t p_actor) const;
+
   /**
    * Gives the code size of the actor.
    * @param p_actor Id of the actor.
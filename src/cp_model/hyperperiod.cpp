@@ -0,0 +1,130 @@
+#include "hyperperiod.hpp"
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+Hyperperiod::Hyperperiod(Space& home, ViewArray<IntView> _proc, ViewArray<IntView> _hyperPeriod,
+                         IntArgs _periods)
+  : Propagator(home), proc(_proc), hyperPeriod(_hyperPeriod), periods(_periods) {
+
+  proc.subscribe(home, *this, Int::PC_INT_DOM);
+  hyperPeriod.subscribe(home, *this, Int::PC_INT_BND);
+  home.notice(*this, AP_DISPOSE);
+}
+
+size_t Hyperperiod::dispose(Space& home){
+  home.ignore(*this, AP_DISPOSE);
+  proc.cancel(home, *this, Int::PC_INT_DOM);
+  hyperPeriod.cancel(home, *this, Int::PC_INT_BND);
+  (void) Propagator::dispose(home);
+  return sizeof(*this);
+}
+
+Propagator* Hyperperiod::copy(Space& home, bool share){
+  return new (home) Hyperperiod(home, share, *this);
+}
+
+PropCost Hyperperiod::cost(const Space& home, const ModEventDelta& med) const{
+  return PropCost::linear(PropCost::LO, proc.size() * hyperPeriod.size());
+}
+
+void Hyperperiod::reschedule(Space& home){
+  proc.reschedule(home, *this, Int::PC_INT_DOM);
+  hyperPeriod.reschedule(home, *this, Int::PC_INT_BND);
+}
+
+Hyperperiod::Hyperperiod(Space& home, bool share, Hyperperiod& p)
+  : Propagator(home, share, p), periods(p.periods) {
+
+  proc.update(home, share, p.proc);
+  hyperPeriod.update(home, share, p.hyperPeriod);
+}
+
+//LCMs beyond the largest integer value are all the same: too large
+static const long long LCM_CAP = (long long) Int::Limits::max + 1;
+
+static long long lcm(long long a, long long b){
+  long long x = a, y = b;
+  while(y != 0){
+    long long r = x % y;
+    x = y;
+    y = r;
+  }
+  long long l = a / x;
+  if(l > LCM_CAP / b)
+    return LCM_CAP;
+  return min(l * b, LCM_CAP);
+}
+
+ExecStatus Hyperperiod::propagate(Space& home, const ModEventDelta&){
+  int n_procs = hyperPeriod.size();
+  vector<long long> lo(n_procs, 1); //lcm of the assigned tasks
+  vector<long long> hi(n_procs, 1); //lcm of the possible tasks
+  vector<bool> used(n_procs, false);
+
+  for(int i = 0; i < proc.size(); i++){
+    if(proc[i].assigned()){
+      lo[proc[i].val()] = lcm(lo[proc[i].val()], periods[i]);
+      used[proc[i].val()] = true;
+    }
+    for(Int::ViewValues<IntView> j(proc[i]); j(); ++j){
+      if(j.val() >= 0 && j.val() < n_procs)
+        hi[j.val()] = lcm(hi[j.val()], periods[i]);
+    }
+  }
+
+  //a multiple of lo, which divides hi
+  for(int j = 0; j < n_procs; j++){
+    if(!used[j])
+      continue;
+    long long first = max(lo[j], (hyperPeriod[j].min() + lo[j] - 1) / lo[j] * lo[j]);
+    long long last = min(hi[j], hyperPeriod[j].max() / lo[j] * lo[j]);
+    if(first > last)
+      return ES_FAILED;
+    GECODE_ME_CHECK(hyperPeriod[j].gq(home, (int) first));
+    GECODE_ME_CHECK(hyperPeriod[j].lq(home, (int) last));
+  }
+
+  bool modified = false;
+  vector<int> excluded;
+  for(int i = 0; i < proc.size(); i++){
+    if(proc[i].assigned())
+      continue;
+    excluded.clear();
+    for(Int::ViewValues<IntView> j(proc[i]); j(); ++j){
+      if(j.val() < 0 || j.val() >= n_procs)
+        continue;
+      if(lcm(lo[j.val()], periods[i]) > hyperPeriod[j.val()].max()
+         || (hyperPeriod[j.val()].assigned() && hyperPeriod[j.val()].val() % periods[i] != 0))
+        excluded.push_back(j.val());
+    }
+    for(int j : excluded)
+      GECODE_ME_CHECK_MODIFIED(modified, proc[i].nq(home, j));
+  }
+
+  if(modified)
+    return ES_NOFIX;
+  if(proc.assigned())
+    return home.ES_SUBSUMED(*this);
+  return ES_FIX;
+}
+
+void hyperperiod(Space& home, const IntVarArgs& _proc, const IntArgs& _periods,
+                 const IntVarArgs& _hyperPeriod){
+  if (home.failed())
+    return;
+
+  if (_proc.size() != _periods.size()) {
+    throw Gecode::Int::ArgumentSizeMismatch("Hyperperiod constraint, proc & periods");
+  }
+  for (int i = 0; i < _periods.size(); i++) {
+    if (_periods[i] <= 0)
+      throw Gecode::Int::OutOfLimits("Hyperperiod constraint, periods");
+  }
+  ViewArray<Int::IntView> tmp_proc(home, _proc);
+  ViewArray<Int::IntView> tmp_hyperPeriod(home, _hyperPeriod);
+  if (Hyperperiod::post(home, tmp_proc, tmp_hyperPeriod, _periods) != ES_OK) {
+    home.fail();
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <gecode/int.hh>
+#include <vector>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+/**
+ * Hyperperiod of the periodic tasks on each processor: hyperPeriod[j] is
+ * the LCM of the periods of the tasks mapped onto j. Processors without
+ * tasks are left unconstrained.
+ *
+ * Replaces the table of the LCMs of all 2^n task combinations. With
+ * assigned(j) the tasks mapped onto j and possible(j) those that still can
+ * be, the LCM is bounded by [lcm(assigned(j)), lcm(possible(j))], and
+ * hyperPeriod[j] must be a multiple of the lower bound. A task is removed
+ * from a processor if adding its period to the lower bound exceeds the
+ * largest possible hyperperiod, or if the hyperperiod is decided and not
+ * a multiple of its period.
+ */
+class Hyperperiod : public Propagator {
+
+protected:
+  ViewArray<IntView> proc; /*!< processor of each task. */
+  ViewArray<IntView> hyperPeriod; /*!< hyperperiod of each processor. */
+  IntArgs periods; /*!< period of each task. */
+
+public:
+  Hyperperiod(Space& home, ViewArray<IntView> _proc, ViewArray<IntView> _hyperPeriod,
+              IntArgs _periods);
+
+  static ExecStatus post(Space& home, ViewArray<IntView> _proc, ViewArray<IntView> _hyperPeriod,
+                         IntArgs _periods){
+    (void) new (home) Hyperperiod(home, _proc, _hyperPeriod, _periods);
+    return ES_OK;
+  }
+
+  virtual size_t dispose(Space& home);
+
+  Hyperperiod(Space& home, bool share, Hyperperiod& p);
+
+  virtual Propagator* copy(Space& home, bool share);
+
+  virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+
+  virtual void reschedule(Space& home);
+
+  virtual ExecStatus propagate(Space& home, const ModEventDelta&);
+};
+
+/**
+ * Posts the hyperperiod propagator.
+ * @param _proc processor of each periodic task
+ * @param _periods period of each periodic task
+ * @param _hyperPeriod hyperperiod of each processor
+ */
+extern void hyperperiod(Space& home, const IntVarArgs& _proc, const IntArgs& _periods,
+                        const IntVarArgs& _hyperPeriod);
@@ -0,0 +1,114 @@
+#include "incumbent.hpp"
+
+#include <algorithm>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+Incumbent::Incumbent() : best(NONE), n_values(0), n_improvements(0) {}
+
+bool Incumbent::offer(const vector<int>& values){
+  if(values.empty() || values.size() > 2 || *min_element(values.begin(), values.end()) < 0)
+    throw Gecode::Exception("Incumbent", "only one or two non-negative objectives can be shared");
+
+  unsigned long long packed = (unsigned long long) (unsigned int) values[0];
+  if(values.size() == 2)
+    packed = (packed << 32) | (unsigned int) values[1];
+  n_values = values.size();
+
+  unsigned long long current = best.load();
+  while(packed < current){
+    if(best.compare_exchange_weak(current, packed)){
+      n_improvements++;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Incumbent::get(vector<int>& values) const{
+  unsigned long long current = best.load();
+  values.clear();
+  if(current == NONE)
+    return false;
+  if(n_values.load() == 2)
+    values.push_back((int) (current >> 32));
+  values.push_back((int) (current & 0xFFFFFFFFULL));
+  return true;
+}
+
+unsigned int Incumbent::version() const{
+  return n_improvements.load();
+}
+
+
+IncumbentBound::IncumbentBound(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, Incumbent* _incumbent)
+  : Propagator(home), objectives(_objectives), triggers(_triggers), incumbent(_incumbent), seen(0) {
+
+  objectives.subscribe(home, *this, Int::PC_INT_VAL);
+  triggers.subscribe(home, *this, Int::PC_INT_VAL);
+  home.notice(*this, AP_DISPOSE);
+}
+
+size_t IncumbentBound::dispose(Space& home){
+  home.ignore(*this, AP_DISPOSE);
+  objectives.cancel(home, *this, Int::PC_INT_VAL);
+  triggers.cancel(home, *this, Int::PC_INT_VAL);
+  best.~vector<int>();
+  (void) Propagator::dispose(home);
+  return sizeof(*this);
+}
+
+Propagator* IncumbentBound::copy(Space& home, bool share){
+  return new (home) IncumbentBound(home, share, *this);
+}
+
+PropCost IncumbentBound::cost(const Space& home, const ModEventDelta& med) const{
+  return PropCost::linear(PropCost::LO, objectives.size());
+}
+
+void IncumbentBound::reschedule(Space& home){
+  objectives.reschedule(home, *this, Int::PC_INT_VAL);
+  triggers.reschedule(home, *this, Int::PC_INT_VAL);
+}
+
+IncumbentBound::IncumbentBound(Space& home, bool share, IncumbentBound& p)
+  : Propagator(home, share, p),
+    incumbent(p.incumbent),
+    seen(p.seen),
+    best(p.best) {
+
+  objectives.update(home, share, p.objectives);
+  triggers.update(home, share, p.triggers);
+}
+
+ExecStatus IncumbentBound::propagate(Space& home, const ModEventDelta&){
+  if(incumbent->version() != seen){
+    seen = incumbent->version();
+    incumbent->get(best);
+  }
+  if(best.empty())
+    return ES_FIX;
+
+  //objectives < best, lexicographically
+  int n = min((int) best.size(), objectives.size());
+  for(int k = 0; k < n; k++){
+    int limit = k == n - 1 ? best[k] - 1 : best[k];
+    GECODE_ME_CHECK(objectives[k].lq(home, limit));
+    if(!objectives[k].assigned() || objectives[k].val() != best[k])
+      break;
+  }
+  return ES_FIX;
+}
+
+void incumbentBound(Space& home, const IntVarArgs& _objectives, const IntVarArgs& _triggers, Incumbent* _incumbent){
+  if(home.failed())
+    return;
+
+  ViewArray<IntView> objectives(home, _objectives);
+  ViewArray<IntView> triggers(home, _triggers);
+  if(IncumbentBound::post(home, objectives, triggers, _incumbent) != ES_OK){
+    home.fail();
+  }
+}
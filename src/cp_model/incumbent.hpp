@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2013-2016, Nima Khalilzad   <nkhal@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+#include <gecode/int.hh>
+#include <vector>
+#include <atomic>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+/**
+ * Best objective values found so far, shared between parallel search
+ * workers. The values are compared lexicographically, in the order in
+ * which the model imposes them in constrain().
+ *
+ * The store is lock-free: up to two non-negative objectives are packed
+ * into one 64-bit word, the first objective in the upper half, so that
+ * comparing the packed words compares the values lexicographically.
+ */
+class Incumbent {
+public:
+  Incumbent();
+  /**
+   * Stores the values if they are lexicographically smaller than the
+   * current incumbent (or if there is none yet).
+   * @return true if the values improve the incumbent
+   */
+  bool offer(const vector<int>& values);
+  /**
+   * Copies the current incumbent into values.
+   * @return false if no solution has been offered yet
+   */
+  bool get(vector<int>& values) const;
+  /**
+   * Increases with every improvement, for cheap polling.
+   */
+  unsigned int version() const;
+
+private:
+  static const unsigned long long NONE = ~0ULL; /*!< no incumbent yet. */
+  atomic<unsigned long long> best; /*!< packed values of the incumbent. */
+  atomic<int> n_values; /*!< number of objectives. */
+  atomic<unsigned int> n_improvements;
+};
+
+/**
+ * Requires the objectives to be lexicographically smaller than the shared
+ * incumbent. The propagator is woken up by the branching variables, so that
+ * bounds found by other workers cut this search at the next node.
+ */
+class IncumbentBound : public Propagator {
+
+protected:
+  ViewArray<IntView> objectives; /*!< objective variables, in lexicographic order. */
+  ViewArray<IntView> triggers; /*!< variables that wake up the propagator. */
+  Incumbent* incumbent;
+  unsigned int seen; /*!< version of the incumbent imposed last. */
+  vector<int> best; /*!< values of the incumbent imposed last. */
+
+public:
+  IncumbentBound(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, Incumbent* _incumbent);
+
+  static ExecStatus post(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, Incumbent* _incumbent){
+    (void) new (home) IncumbentBound(home, _objectives, _triggers, _incumbent);
+    return ES_OK;
+  }
+
+  virtual size_t dispose(Space& home);
+
+  IncumbentBound(Space& home, bool share, IncumbentBound& p);
+
+  virtual Propagator* copy(Space& home, bool share);
+
+  virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+
+  virtual void reschedule(Space& home);
+
+  virtual ExecStatus propagate(Space& home, const ModEventDelta&);
+};
+
+extern void incumbentBound(Space& home, const IntVarArgs& _objectives, const IntVarArgs& _triggers, Incumbent* _incumbent);
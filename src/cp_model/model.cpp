@@ -168,6 +168,7 @@ ADSEModel::ADSEModel(Mapping* p_mapping, Config* _cfg)
       }
     }
   }
+  Config::ThroughputPropagator th_prop = cfg->settings().th_prop;
 #include "throughput.constraints"
 
   for (size_t i=0; i<channels.size(); i++){
@@ -16,6 +16,7 @@
 #include "../systemDesign/designDecisions.hpp"
 #include "../throughput/throughputSSE.hpp"
 #include "../throughput/throughputMCR.hpp"
+#include "hyperperiod.hpp"
 
 using namespace Gecode;
 
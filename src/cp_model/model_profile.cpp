@@ -0,0 +1,61 @@
+#include "model_profile.hpp"
+
+#include <iomanip>
+
+using namespace Gecode;
+using namespace std;
+
+ModelProfile::ModelProfile() : propagators(0), branchers(0), memory(0), n_variables(0) {}
+
+void ModelProfile::begin(Space& home, const string& name){
+  current = name;
+  start = chrono::steady_clock::now();
+  propagators = home.propagators();
+  branchers = home.branchers();
+  memory = home.allocated();
+  n_variables = 0;
+}
+
+void ModelProfile::end(Space& home){
+  Block b;
+  b.name = current;
+  b.ms = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 1000.0;
+  b.propagators = (long) home.propagators() - propagators;
+  b.branchers = (long) home.branchers() - branchers;
+  b.memory = (long) home.allocated() - memory;
+  b.variables = n_variables;
+  profile.push_back(b);
+}
+
+void ModelProfile::print(ostream& out) const{
+  Block total = {"total", 0, 0, 0, 0, 0};
+  ios::fmtflags flags = out.flags();
+  streamsize precision = out.precision();
+  out << "*** Model construction profile ***" << endl;
+  out << left << setw(28) << "block" << right << setw(12) << "time [ms]" << setw(14) << "propagators"
+      << setw(11) << "branchers" << setw(14) << "memory [kB]" << setw(11) << "variables" << endl;
+  for(size_t i = 0; i <= profile.size(); i++){
+    const Block& b = i < profile.size() ? profile[i] : total;
+    if(i < profile.size()){
+      total.ms += b.ms;
+      total.propagators += b.propagators;
+      total.branchers += b.branchers;
+      total.memory += b.memory;
+      total.variables += b.variables;
+    }
+    out << left << setw(28) << b.name << right << setw(12) << fixed << setprecision(1) << b.ms
+        << setw(14) << b.propagators << setw(11) << b.branchers << setw(14) << b.memory / 1024
+        << setw(11) << b.variables << endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+  out << endl;
+}
+
+void ModelProfile::printCSV(ostream& out) const{
+  out << "block,ms,propagators,branchers,memory,variables" << endl;
+  for(const Block& b : profile){
+    out << b.name << "," << b.ms << "," << b.propagators << "," << b.branchers << ","
+        << b.memory << "," << b.variables << endl;
+  }
+}
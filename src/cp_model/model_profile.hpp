@@ -0,0 +1,63 @@
+#pragma once
+#include <gecode/int.hh>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Size of the root space contributed by each block of constraints
+ * (the .constraints files included by the model constructor).
+ *
+ * Each block is enclosed in begin()/end(), which take the difference of
+ * the space's propagators, branchers and allocated memory. Gecode does not
+ * count variables, so the blocks report the variables they create with
+ * declare(); auxiliary variables of MiniModel expressions are only seen
+ * in the memory column.
+ */
+class ModelProfile {
+public:
+  struct Block {
+    string name;
+    double ms;
+    long propagators;
+    long branchers;
+    long memory; /**< bytes allocated by the space. */
+    long variables;
+  };
+
+  ModelProfile();
+
+  void begin(Space& home, const string& name);
+  void end(Space& home);
+
+  //adds the variables of one or more arrays (or single variables) to the current block
+  template<class T, class... Rest>
+  void declare(const T& vars, const Rest&... rest) {
+    n_variables += count(vars);
+    declare(rest...);
+  }
+  void declare() {}
+
+  const vector<Block>& blocks() const { return profile; }
+  //table for out.txt
+  void print(ostream& out) const;
+  //one line per block: name,ms,propagators,branchers,memory,variables
+  void printCSV(ostream& out) const;
+
+private:
+  vector<Block> profile;
+  string current;
+  chrono::steady_clock::time_point start;
+  long propagators;
+  long branchers;
+  long memory;
+  long n_variables;
+
+  template<class A> static long count(const A& vars) { return vars.size(); }
+  static long count(const IntVar&) { return 1; }
+  static long count(const BoolVar&) { return 1; }
+};
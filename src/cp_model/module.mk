@@ -28,7 +28,7 @@
 # MODULE PATH AND FILES
 #=======================
 
-CPP_FILES := schedulability.cpp sdf_pr_online_model.cpp
+CPP_FILES := schedulability.cpp sdf_pr_online_model.cpp incumbent.cpp pareto.cpp static_order.cpp model_profile.cpp hyperperiod.cpp
 
 
 
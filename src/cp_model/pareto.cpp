@@ -0,0 +1,157 @@
+#include "pareto.hpp"
+
+#include <algorithm>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+ParetoArchive::ParetoArchive() : points(make_shared<const Front>()), n_changes(0) {}
+
+size_t ParetoArchive::upperBound(const Front& f, const vector<int>& values){
+  auto it = upper_bound(f.begin(), f.end(), values[0],
+                        [](int v, const Point& p){ return v < p.values[0]; });
+  return it - f.begin();
+}
+
+bool ParetoArchive::weaklyDominates(const vector<int>& a, const vector<int>& b){
+  for(size_t k = 0; k < a.size(); k++){
+    if(a[k] > b[k])
+      return false;
+  }
+  return true;
+}
+
+bool ParetoArchive::dominatedIn(const Front& f, const vector<int>& values){
+  size_t end = upperBound(f, values); //only these points are not larger in the first objective
+  if(values.size() == 2){ //the second objective decreases along the front
+    return end > 0 && f[end-1].values[1] <= values[1];
+  }
+  for(size_t i = 0; i < end; i++){
+    if(weaklyDominates(f[i].values, values))
+      return true;
+  }
+  return false;
+}
+
+bool ParetoArchive::insert(const vector<int>& values, size_t id, vector<size_t>& removed){
+  if(values.empty())
+    throw Gecode::Exception("ParetoArchive", "a point needs at least one objective");
+
+  lock_guard<mutex> guard(lock);
+  const Front& f = *points;
+  if(!f.empty() && f[0].values.size() != values.size())
+    throw Gecode::Exception("ParetoArchive", "all points need the same number of objectives");
+  if(dominatedIn(f, values))
+    return false;
+
+  //the front is shared with the propagators, so it is replaced instead of modified
+  shared_ptr<Front> next = make_shared<Front>();
+  next->reserve(f.size() + 1);
+  for(auto& p : f){
+    if(p.values[0] >= values[0] && weaklyDominates(values, p.values)){
+      removed.push_back(p.id);
+    }else{
+      next->push_back(p);
+    }
+  }
+  Point point{values, id};
+  auto pos = lower_bound(next->begin(), next->end(), point,
+                         [](const Point& a, const Point& b){ return a.values < b.values; });
+  next->insert(pos, point);
+  points = next;
+  n_changes++;
+  return true;
+}
+
+bool ParetoArchive::dominated(const vector<int>& values) const{
+  return dominatedIn(*front(), values);
+}
+
+shared_ptr<const ParetoArchive::Front> ParetoArchive::front() const{
+  lock_guard<mutex> guard(lock);
+  return points;
+}
+
+unsigned int ParetoArchive::version() const{
+  return n_changes.load();
+}
+
+
+ParetoBound::ParetoBound(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, ParetoArchive* _archive)
+  : Propagator(home), objectives(_objectives), triggers(_triggers), archive(_archive), seen(0) {
+
+  objectives.subscribe(home, *this, Int::PC_INT_BND);
+  triggers.subscribe(home, *this, Int::PC_INT_VAL);
+  home.notice(*this, AP_DISPOSE);
+}
+
+size_t ParetoBound::dispose(Space& home){
+  home.ignore(*this, AP_DISPOSE);
+  objectives.cancel(home, *this, Int::PC_INT_BND);
+  triggers.cancel(home, *this, Int::PC_INT_VAL);
+  front.~shared_ptr<const ParetoArchive::Front>();
+  (void) Propagator::dispose(home);
+  return sizeof(*this);
+}
+
+Propagator* ParetoBound::copy(Space& home, bool share){
+  return new (home) ParetoBound(home, share, *this);
+}
+
+PropCost ParetoBound::cost(const Space& home, const ModEventDelta& med) const{
+  return PropCost::linear(PropCost::LO, objectives.size() * (front ? front->size() + 1 : 1));
+}
+
+void ParetoBound::reschedule(Space& home){
+  objectives.reschedule(home, *this, Int::PC_INT_BND);
+  triggers.reschedule(home, *this, Int::PC_INT_VAL);
+}
+
+ParetoBound::ParetoBound(Space& home, bool share, ParetoBound& p)
+  : Propagator(home, share, p),
+    archive(p.archive),
+    seen(p.seen),
+    front(p.front) {
+
+  objectives.update(home, share, p.objectives);
+  triggers.update(home, share, p.triggers);
+}
+
+ExecStatus ParetoBound::propagate(Space& home, const ModEventDelta&){
+  if(archive->version() != seen){
+    seen = archive->version();
+    front = archive->front();
+  }
+  if(!front)
+    return ES_FIX;
+
+  //for every point a, some objective must still be able to beat a:
+  //the propagator only tightens upper bounds and only reads lower bounds, so it is idempotent
+  for(auto& a : *front){
+    int open = -1; //the objective that can beat a, if there is exactly one
+    int n_open = 0;
+    for(int k = 0; k < objectives.size() && n_open < 2; k++){
+      if(objectives[k].min() < a.values[k]){
+        open = k;
+        n_open++;
+      }
+    }
+    if(n_open == 0)
+      return ES_FAILED;
+    if(n_open == 1)
+      GECODE_ME_CHECK(objectives[open].lq(home, a.values[open] - 1));
+  }
+  return ES_FIX;
+}
+
+void paretoBound(Space& home, const IntVarArgs& _objectives, const IntVarArgs& _triggers, ParetoArchive* _archive){
+  if(home.failed())
+    return;
+
+  ViewArray<IntView> objectives(home, _objectives);
+  ViewArray<IntView> triggers(home, _triggers);
+  if(ParetoBound::post(home, objectives, triggers, _archive) != ES_OK){
+    home.fail();
+  }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <gecode/int.hh>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+/**
+ * Archive of the mutually non-dominated objective vectors found so far
+ * (all objectives are minimized), shared between parallel search workers.
+ *
+ * The points are kept sorted lexicographically. Only points that are not
+ * larger in the first objective can dominate a new point, so a binary
+ * search on the first objective bounds the dominance test. With two
+ * objectives, the second objective strictly decreases along the front,
+ * and only the last of these points has to be compared, in O(log n).
+ * The front is shared with the propagators, so insertion replaces it by
+ * a new copy.
+ */
+class ParetoArchive {
+public:
+  struct Point {
+    vector<int> values;
+    size_t id; /*!< identifies the solution of the point for the caller. */
+  };
+  typedef vector<Point> Front;
+
+  ParetoArchive();
+  /**
+   * Adds the point unless it is weakly dominated by a point of the
+   * archive, and removes the points it dominates.
+   * @param removed ids of the removed points
+   * @return true if the point was added
+   */
+  bool insert(const vector<int>& values, size_t id, vector<size_t>& removed);
+  /**
+   * Is the point weakly dominated (dominated or equal) by a point of the archive?
+   */
+  bool dominated(const vector<int>& values) const;
+  /**
+   * The current front, sorted lexicographically. The front is never
+   * modified, insert() replaces it.
+   */
+  shared_ptr<const Front> front() const;
+  /**
+   * Increases with every change of the front, for cheap polling.
+   */
+  unsigned int version() const;
+
+private:
+  mutable mutex lock; /*!< protects points. */
+  shared_ptr<const Front> points;
+  atomic<unsigned int> n_changes;
+
+  /** index of the first point with a larger first objective than values */
+  static size_t upperBound(const Front& f, const vector<int>& values);
+  static bool weaklyDominates(const vector<int>& a, const vector<int>& b);
+  static bool dominatedIn(const Front& f, const vector<int>& values);
+};
+
+/**
+ * Requires the objectives not to be weakly dominated by any point of a
+ * shared Pareto archive: for every point a, some objective k must satisfy
+ * objectives[k] < a[k]. If only one objective can still satisfy this, its
+ * upper bound is tightened. The propagator is woken up by the lower bounds
+ * of the objectives and by the branching variables, so that points found
+ * by other workers cut this search at the next node.
+ */
+class ParetoBound : public Propagator {
+
+protected:
+  ViewArray<IntView> objectives; /*!< objective variables, minimized. */
+  ViewArray<IntView> triggers; /*!< variables that wake up the propagator. */
+  ParetoArchive* archive;
+  unsigned int seen; /*!< version of the archive imposed last. */
+  shared_ptr<const ParetoArchive::Front> front; /*!< front imposed last. */
+
+public:
+  ParetoBound(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, ParetoArchive* _archive);
+
+  static ExecStatus post(Space& home, ViewArray<IntView> _objectives, ViewArray<IntView> _triggers, ParetoArchive* _archive){
+    (void) new (home) ParetoBound(home, _objectives, _triggers, _archive);
+    return ES_OK;
+  }
+
+  virtual size_t dispose(Space& home);
+
+  ParetoBound(Space& home, bool share, ParetoBound& p);
+
+  virtual Propagator* copy(Space& home, bool share);
+
+  virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+
+  virtual void reschedule(Space& home);
+
+  virtual ExecStatus propagate(Space& home, const ModEventDelta&);
+};
+
+extern void paretoBound(Space& home, const IntVarArgs& _objectives, const IntVarArgs& _triggers, ParetoArchive* _archive);
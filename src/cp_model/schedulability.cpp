@@ -1,5 +1,7 @@
 
 #include "schedulability.hpp"
+#include "../tools/propagator_stats.hpp"
+#include "../tools/response_time.hpp"
 
 using namespace Gecode;
 using namespace Int;
@@ -14,18 +16,32 @@ Schedulability::Schedulability( Space& home,
                                 IntArgs _priorities,
                                 IntArgs _deadlines,
                                 int _n_actors )
-  : Propagator(home), wcet(_wcet), proc(_proc), proc_mode(_proc_mode), 
+  : Propagator(home), council(home), wcet(_wcet), proc(_proc), proc_mode(_proc_mode), 
     periods(_periods), priorities(_priorities), deadlines(_deadlines), 
-    n_actors(_n_actors), n_tasks(periods.size()) {
+    n_actors(_n_actors), n_tasks(periods.size()),
+    procDirty(_proc_mode.size(), true), response(n_tasks, 0) {
 
   calls=0;
   total_time=0;
+  printDebug=false;
   proc.subscribe(home, *this, Int::PC_INT_VAL);
+  //advisors: track which processors have changed, in order to only test these again
+  for(size_t i=n_actors; i<n_actors+n_tasks; i++)
+    {
+      (void) new (home) ViewChange(home, *this, council, proc[i], S_PROC, i);
+      (void) new (home) ViewChange(home, *this, council, wcet[i], S_WCET, i);
+    }
+  for(int k=0; k<proc_mode.size(); k++)
+    (void) new (home) ViewChange(home, *this, council, proc_mode[k], S_MODE, k);
   home.notice(*this, AP_DISPOSE);
 }
 
 size_t Schedulability::dispose(Space& home){
   home.ignore(*this, AP_DISPOSE);
+  proc.cancel(home, *this, Int::PC_INT_VAL);
+  council.dispose(home);
+  procDirty.~vector<bool>();
+  response.~vector<int>();
   (void) Propagator::dispose(home);
   return sizeof(*this);
 }
@@ -52,14 +68,57 @@ Schedulability::Schedulability(Space& home, bool share, Schedulability& p)
     deadlines(p.deadlines),
     n_actors(p.n_actors),
     n_tasks(p.n_tasks),
-    calls(p.calls) {
+    procDirty(p.procDirty),
+    response(p.response),
+    calls(p.calls),
+    total_time(p.total_time),
+    printDebug(p.printDebug) {
 
+  council.update(home, share, p.council);
   wcet.update(home, share, p.wcet);
   proc.update(home, share, p.proc);
+  proc_mode.update(home, share, p.proc_mode);
 }
 
+ExecStatus Schedulability::advise(Space& home, Advisor& _a, const Delta& d){
+  ViewChange& a = static_cast<ViewChange&>(_a);
+  ExecStatus es = ES_FIX;
 
-ExecStatus Schedulability::propagate(Space& home, const ModEventDelta&){
+  switch(a.source){
+    case S_PROC: //a task is mapped
+      if(a.view().assigned())
+        procDirty[a.view().val()] = true;
+      break;
+    case S_WCET: //the WCET of a mapped task increases
+      if(proc[a.index].assigned())
+        {
+          procDirty[proc[a.index].val()] = true;
+          if(proc_mode[proc[a.index].val()].assigned())
+            es = ES_NOFIX;
+        }
+      break;
+    case S_MODE: //a processor can be tested
+      if(a.view().assigned())
+        {
+          procDirty[a.index] = true;
+          es = ES_NOFIX;
+        }
+      break;
+  }
+  if(a.view().assigned())
+    return es == ES_FIX ? home.ES_FIX_DISPOSE(council, a) : home.ES_NOFIX_DISPOSE(council, a);
+  return es;
+}
+
+
+ExecStatus Schedulability::propagate(Space& home, const ModEventDelta& med){
+  tools::PropagatorStats::Call call(tools::PropagatorStats::SCHEDULABILITY);
+  ExecStatus es = doPropagate(home, med);
+  call.failed(es == ES_FAILED);
+  return es;
+}
+
+ExecStatus Schedulability::doPropagate(Space& home, const ModEventDelta&){
   
   calls++;
   //cout << "propagate: " << calls << "--------------------" << endl;
@@ -68,7 +127,7 @@ ExecStatus Schedulability::propagate(Space& home, const ModEventDelta&){
       //cout << "proc " << proc  << " \n" ;
       //cout << "wcet " << wcet  << endl;
       //cout << "\t -----SCHEDULABLE-----" << endl;
-      if(proc.assigned())
+      if(proc.assigned() && proc_mode.assigned() && wcet.assigned())
         return home.ES_SUBSUMED(*this);
       else
         return ES_FIX;
@@ -83,34 +142,16 @@ ExecStatus Schedulability::propagate(Space& home, const ModEventDelta&){
   return ES_FIX;
 }
 
-int Schedulability::leveliWorkload(int taskid, int t) {
-  int procID = proc[taskid].val();
-  int W      = wcet[taskid].val();
-  for (size_t i=n_actors; i<n_actors+n_tasks; i++)
-    {
-      /**
-       * If task is mapped on my processor and it has higher priority (0 has highest)
-       * i is global task id i.e. considering both tasks and actors
-       * (i-n_actors) is the local task id: priorities and periodes need local task id
-       */  
-      if(isOnProc(i, procID) && priorities[taskid-n_actors] > priorities[i-n_actors])
-        {
-          W += ceil((double)t/periods[i-n_actors]) * wcet[i].val();
-        }
-    }
-  return W;	
-}
-
 bool Schedulability::FPSchedulable()
 {
   /**
-   * goes through all proccessors that mode is assigned
+   * goes through all changed proccessors that mode is assigned
    * first tries utilzation bound test
    * if it fails it tries the time demand test
    */ 
   for (auto k=0;k < proc_mode.size();k++)
     {
-      if(proc_mode[k].assigned())
+      if(procDirty[k] && proc_mode[k].assigned())
         {
           if(!utilizationBound(k))
             {	
@@ -120,31 +161,40 @@ bool Schedulability::FPSchedulable()
                   return false;
                 }
             }
+          procDirty[k] = false;
         }
     }
   return true;
 }
 bool Schedulability::timedemand(int procid)
 {
-  bool taski;
+  /**
+   * response time analysis: for each task on the processor, iterate over
+   * the scheduling points of its level-i workload (priority 0 is highest)
+   * i is global task id i.e. considering both tasks and actors
+   * (i-n_actors) is the local task id: priorities and periodes need local task id
+   */
+  vector<int> onProc;
   for (auto i=n_actors; i<n_actors+n_tasks; i++)
     {
       if(isOnProc(i, procid))
+        onProc.push_back(i);
+    }
+  vector<pair<int,int>> hp;
+  for (auto i : onProc)
+    {
+      hp.clear();
+      for (auto j : onProc)
         {
-          taski = false;
-          for (auto t=1; t<= deadlines[i-n_actors]; t++) //This can be improved by Bini and Buttazzo's approach
-            {
-              if(leveliWorkload(i, t) <= t)
-                {
-                  taski = true;
-                  break;
-                }
-            }
-          if(!taski)
-            {
-              //cout << "task_" << i << " is NOT schedulabale \n" ;
-              return false;
-            }
+          if(priorities[i-n_actors] > priorities[j-n_actors])
+            hp.push_back(make_pair(wcet[j].min(), periods[j-n_actors]));
+        }
+      long long R = tools::responseTime(wcet[i].min(), hp, deadlines[i-n_actors], response[i-n_actors]);
+      response[i-n_actors] = R;
+      if(R > deadlines[i-n_actors])
+        {
+          //cout << "task_" << i << " is NOT schedulabale \n" ;
+          return false;
         }
     }	
   //cout << "proc[" << procid << "] is schedulable based on time demand analysis" << endl;
@@ -159,7 +209,7 @@ bool Schedulability::utilizationBound(int procid)
       if(isOnProc(i, procid))
         {
           n++;
-          utils += ((double) wcet[i].val())/ deadlines[i-n_actors];
+          utils += ((double) wcet[i].min())/ deadlines[i-n_actors];
         }
     }
   if(n > 0)
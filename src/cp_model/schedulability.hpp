@@ -39,7 +39,22 @@ using namespace std;
 
 class Schedulability : public Propagator {
 
+  enum Source { S_PROC, S_WCET, S_MODE };
+  class ViewChange : public ViewAdvisor<IntView> {
+    public:
+      Source source;
+      int index; //index of the view in its array
+
+      ViewChange(Space& home, Propagator& p, Council<ViewChange>& c, IntView x, Source _source, int _index)
+        : ViewAdvisor<IntView>(home, p, c, x), source(_source), index(_index) {}
+      ViewChange(Space& home, bool share, ViewChange& a)
+        : ViewAdvisor<IntView>(home, share, a), source(a.source), index(a.index) {}
+      void dispose(Space& home, Council<ViewChange>& c) {
+        ViewAdvisor<IntView>::dispose(home, c);
+      }
+  };
 protected:
+  Council<ViewChange> council;
   ViewArray<IntView> wcet; /*!< current WCETs. */
   ViewArray<IntView> proc; /*!< current mapping of actors and task. */
   ViewArray<IntView> proc_mode; /*!< current proc_modes. */
@@ -48,19 +63,22 @@ protected:
   IntArgs deadlines;
   const size_t n_actors;
   const size_t n_tasks;
+  /**
+   * Processors whose tasks have changed (a task was mapped onto them or its
+   * WCET increased) since they were last found schedulable. Only these are
+   * tested again.
+   */
+  vector<bool> procDirty;
+  /**
+   * Response time of each task (local task id) at its last test. Mapping
+   * more tasks and fixing modes only increases the interference, so it is
+   * a lower bound of the response time in this space and its descendants.
+   */
+  vector<int> response;
   //for evaluation purposes
   size_t calls;
   int total_time;
   bool printDebug;
-  /**
-   * Returns the level-i workload given the current mapping
-   * NOTE that the task has to be assiged to a processor before calling this
-   * i.e. proc[entityID] == ture;
-   * @param entity id
-   * @param time
-   * @return level-i workload of task with matching entity id
-   */ 
-  int leveliWorkload(int entityID, int t);  
   /**
    * @return true if tasks assigned to procid are schedulable based on their utilization bound test
    */ 
@@ -72,7 +90,8 @@ protected:
    */ 
   bool isOnProc(int taskid, int procid);
   /**
-   * @return true if tasks assigned to procid are schedulable based on the time demand test
+   * @return true if tasks assigned to procid are schedulable based on the time demand test,
+   * carried out as response time analysis
    */ 
   bool timedemand(int procid);
         
@@ -110,11 +129,16 @@ public:
 
   virtual void reschedule(Space& home);
 
+  virtual ExecStatus advise(Space& home, Advisor& a, const Delta& d);
+
   virtual ExecStatus propagate(Space& home, const ModEventDelta&);
+  //the propagation itself, propagate() accounts its CPU time
+  ExecStatus doPropagate(Space& home, const ModEventDelta&);
   /**
    * Returns true if the taskset is schedulable given 
    * (1) current mapping and (2) partitioned FP algorithm
-   * with rate monotonic priorities
+   * with rate monotonic priorities. Only tests the processors
+   * that have changed since the last call.
    * @return true if schedulable, otherwise false
    */ 
   bool FPSchedulable();
@@ -1,10 +1,14 @@
 #include "sdf_pr_online_model.hpp"
 
-SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
+#include <sstream>
+
+SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg, const SearchVariant* variant):
     apps(p_mapping->getApplications()),
     platform(p_mapping->getPlatform()),
     mapping(p_mapping),
     cfg(_cfg),
+    incumbent(variant ? variant->incumbent : nullptr),
+    th_prop(variant ? variant->th_prop : _cfg->settings().th_prop),
     next(*this, apps->n_SDFActors()+platform->nodes(), 0, apps->n_SDFActors()+platform->nodes()-1),
     //rank(*this, apps->n_SDFActors(), 0, apps->n_SDFActors()-1),
     proc(*this, apps->n_programEntities(), 0, platform->nodes()-1),
@@ -44,6 +48,17 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
     //wcct_s(*this, apps->n_programChannels(), 0, Int::Limits::max),
     //wcct_r(*this, apps->n_programChannels(), 0, Int::Limits::max)
     {
+    
+    //settings that are varied by parallel search
+    unsigned int seed = variant ? variant->seed : 0;
+    double afcDecay = variant ? variant->afc_decay : 0.99;
+    
+    if(cfg->settings().search == Config::PARETO){
+      for(auto c : cfg->settings().criteria){
+        if(c != Config::POWER && c != Config::THROUGHPUT)
+          THROW_EXCEPTION(RuntimeException, "PARETO search supports the criteria POWER and THROUGHPUT only.");
+      }
+    }
       
     //initialization of secondary variables
     IntVarArgs rank(*this, apps->n_SDFActors(), 0, apps->n_SDFActors()-1);
@@ -147,22 +162,28 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
     /**
      * MAPPING
      */
+    profile.begin(*this, "mapping.constraints");
     IntVarArgs nSDFAsOnProc(*this, platform->nodes(), 0, apps->n_SDFActors()); /**< number of SDF actors on proc[i]. */
     IntVarArgs nTasksOnProc(*this, platform->nodes(), 0, apps->n_IPTTasks()); /**< number of IPTs on proc[i]. */
     IntVarArgs nEntitiesOnProc(*this, platform->nodes(), 0, apps->n_programEntities()); /**< number of SDF actors and IPTs combined on proc[i]. */
     IntVarArgs proc_SDF_wcet_sum(*this, platform->nodes(), 0, Int::Limits::max); /**< sum of WCET on each proccessor for sdf apps. */
+    profile.declare(nSDFAsOnProc, nTasksOnProc, nEntitiesOnProc, proc_SDF_wcet_sum);
 #include "mapping.constraints"
+    profile.end(*this);
 
     /**
      * Independent periodic tasks
      */
     LOG_INFO("Inserting IPT scheduling constraints ");
     if(apps->n_IPTTasks() > 0){
+        profile.begin(*this, "partitioning.constraints");
         IntVarArgs n_instances(*this, apps->n_IPTTasks(), 0, apps->getMaxNumberOfIPTInstances());
         IntVarArgs instancesOnNode(*this, apps->n_IPTTasks() * platform->nodes(), 0, apps->getMaxNumberOfIPTInstances() * platform->nodes());
         IntVarArgs nActorsOnProc(*this, platform->nodes(), 0, apps->n_programEntities());
         IntVarArgs taskUtil(*this, apps->n_programEntities(), 0, Int::Limits::max); /**< the main utilization variable for pr tasks. */
+        profile.declare(n_instances, instancesOnNode, nActorsOnProc, taskUtil);
 #include "partitioning.constraints"
+        profile.end(*this);
     }
 
     /**
@@ -171,11 +192,14 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
     if(apps->n_SDFActors() > 0){
         LOG_INFO("Inserting scheduling constraints ");
         //IntVarArgs rank(*this, apps->n_SDFActors(), 0, apps->n_SDFActors()-1);                                                /**< rank of each actor. */
+        profile.begin(*this, "scheduling.constraints");
 #include "scheduling.constraints"
+        profile.end(*this);
         /**
          * Communication
          */
         LOG_INFO("Inserting communication constraints ");
+        profile.begin(*this, "wcct.constraints");
         IntVar cycleLength(*this, 0, Int::Limits::max); //depends on chosen interconnect-mode
         //IntVarArgs sendbufferSz(*this, apps->n_programChannels(), 0, Int::Limits::max);                               /**< //sending buffer sizes. */
         //IntVarArgs recbufferSz(*this, apps->n_programChannels(), 1, Int::Limits::max);                                /**< //receiving buffer sizes. */
@@ -190,13 +214,17 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
           links = tdn_graph.size()/platform->getTDNCycles();
           IntVarArgs _flitsPerLink(*this, messages*links, 0, Int::Limits::max); 
           flitsPerLink = _flitsPerLink;
+          profile.declare(flitsPerLink);
         }
+        profile.declare(cycleLength);
 #include "wcct.constraints"
+        profile.end(*this);
 
         /**
          * Power consumption
          */
         LOG_INFO("Inserting power constraints ");
+        profile.begin(*this, "power.constraints");
         if(cfg->settings().configTDN){
           rel(*this, ic_mode == 0);
           for(size_t p=0; p<platform->nodes(); p++){
@@ -204,23 +232,29 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
           }
         }
 #include "power.constraints"
+        profile.end(*this);
 
         /**
          * Cost metrics
          */
         LOG_INFO("Inserting cost metric constraints ");
+        profile.begin(*this, "costMetrics.constraints");
 #include "costMetrics.constraints"
+        profile.end(*this);
 
         /**
          * Memory
          */
         LOG_INFO("Inserting memory constraints ");
+        profile.begin(*this, "memory.constraints");
 #include "memory.constraints"
+        profile.end(*this);
 
         /**
          * Throughput
          */
         LOG_INFO("Inserting throughput constraints ");
+        profile.begin(*this, "throughput.constraints");
         vector<int> maxMinWcet(apps->n_SDFApps(), 0);
         vector<int> maxMinWcetActor(apps->n_SDFActors(), 0);
         vector<int> sumMinWCETs(apps->n_SDFApps(), 0);
@@ -248,6 +282,7 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
             }
         }
 #include "throughput.constraints"
+        profile.end(*this);
 
 //PRESOLVING
     if (cfg->doPresolve() && cfg->is_presolved()) {
@@ -368,6 +403,7 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
         /**
          * Creating the branching strategy
          */
+        profile.begin(*this, "branching");
         string branchStrat = "  Branching:\n";
 
         vector<double> ratio;
@@ -518,22 +554,22 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
         //branch(*this, next, INT_VAR_NONE(), INT_VAL_MIN());
 
         if(!heaviestFirst && (procBranchOrderSAT.size() > 0 || procBranchOrderOPT.size() > 0)){
-            rnd.hw();
-            branch(*this, procBranchOrderSAT, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
-            branch(*this, procBranchOrderOPT, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
-            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(0.99), INT_VAL_RND(rnd));
+            if(seed) rnd.seed(seed); else rnd.hw();
+            branch(*this, procBranchOrderSAT, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
+            branch(*this, procBranchOrderOPT, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
+            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(afcDecay), INT_VAL_RND(rnd));
         }else if(heaviestFirst && (procBranchOrderSAT.size() > 0 || procBranchOrderOPT.size() > 0)){
-            branch(*this, procBranchOrderSAT, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
+            branch(*this, procBranchOrderSAT, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
             branch(*this, procBranchOrderOPT, INT_VAR_NONE(), INT_VAL_MIN());
-            rnd.hw();
-            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(0.99), INT_VAL_RND(rnd));
+            if(seed) rnd.seed(seed); else rnd.hw();
+            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(afcDecay), INT_VAL_RND(rnd));
         }else{
-            rnd.hw();
-            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(0.99), INT_VAL_RND(rnd));
+            if(seed) rnd.seed(seed); else rnd.hw();
+            branch(*this, procBranchOrderOther, INT_VAR_AFC_MAX(afcDecay), INT_VAL_RND(rnd));
         }
         
         //branch(*this, rank, INT_VAR_NONE(), INT_VAL_MIN());
-        branch(*this, next, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
+        branch(*this, next, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
          /**
          * ordering of sending and receiving messages with same
          * source (send) or destination (rec) for unresolved cases
@@ -541,7 +577,7 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
         if(cfg->settings().configTDN){
           assign(*this, sendNext, INT_ASSIGN_MIN());
         }else{
-          branch(*this, sendNext, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
+          branch(*this, sendNext, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
         }
  
         /**
@@ -558,8 +594,8 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
             branch(*this, chosenRoute, INT_VAR_NONE(), INT_VAL_MIN()); 
           }else if(platform->getTDNCyclesPerProc()>1 &&
             !cfg->doOptimizeThput(cfg->settings().optimizationStep)){
-            rnd.hw();
-            branch(*this, chosenRoute, INT_VAR_AFC_MAX(0.99), INT_VAL_RND(rnd));
+            if(seed) rnd.seed(seed); else rnd.hw();
+            branch(*this, chosenRoute, INT_VAR_AFC_MAX(afcDecay), INT_VAL_RND(rnd));
           }
           //assign(*this, injectionTable, INT_ASSIGN_MAX());
           //assign(*this, flitsPerLink, INT_ASSIGN_MIN());
@@ -585,29 +621,32 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
           assign(*this, proc_mode, INT_ASSIGN_MIN());
         }else{
           if(cfg->doOptimizeThput(cfg->settings().optimizationStep)){
-            branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VAL_MAX());
+            branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MAX());
           }else if(cfg->doOptimizePower(cfg->settings().optimizationStep)){
-            branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VAL_MIN());
+            branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MIN());
           }else{
-            branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VAL_MED());
+            branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MED());
           } 
         }
         
         if(platform->getTDNCyclesPerProc()>1 && cfg->doOptimizeThput(cfg->settings().optimizationStep)){
-          rnd.hw();
-          branch(*this, chosenRoute, INT_VAR_AFC_MAX(0.99), INT_VAL_RND(rnd));
+          if(seed) rnd.seed(seed); else rnd.hw();
+          branch(*this, chosenRoute, INT_VAR_AFC_MAX(afcDecay), INT_VAL_RND(rnd));
         }
        
 
         //branch(*this, proc, INT_VAR_NONE(), INT_VAL(&valueProc));
-        rnd.hw();
+        if(seed) rnd.seed(seed); else rnd.hw();
         branch(*this, proc, INT_VAR_NONE(), INT_VAL_RND(rnd));
+        profile.end(*this);
     }else{ /**< end of SDF related constraints and branching. */
         /**
          * Memory
          */
         LOG_INFO("Inserting memory constraints ");
+        profile.begin(*this, "memory.constraints");
 #include "memory.constraints"
+        profile.end(*this);
         /**
          * Branching for the periodic tasks
          * Since the tasks are ordered from heavy to light,
@@ -616,16 +655,29 @@ SDFPROnlineModel::SDFPROnlineModel(Mapping* p_mapping, Config* _cfg):
          * to mimic bestfit algorithm
          */
         //branch(*this, proc, INT_VAR_NONE(), INT_VAL(&valueProc));
-        rnd.hw();
+        if(seed) rnd.seed(seed); else rnd.hw();
         branch(*this, proc, INT_VAR_NONE(), INT_VAL_RND(rnd));
         if(cfg->doOptimizeThput(cfg->settings().optimizationStep)){
-          branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VALUES_MAX());
+          branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VALUES_MAX());
         }else if(cfg->doOptimizePower(cfg->settings().optimizationStep)){
-          branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VALUES_MIN());
+          branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VALUES_MIN());
         }else{
-          branch(*this, proc_mode, INT_VAR_AFC_MAX(0.99), INT_VAL_MED());
+          branch(*this, proc_mode, INT_VAR_AFC_MAX(afcDecay), INT_VAL_MED());
         }
     }
+    
+    if(incumbent != nullptr){
+        LOG_INFO("Sharing the best bound with the other parallel workers");
+        IntVarArgs triggers;
+        triggers << IntVarArgs(proc) << IntVarArgs(next) << IntVarArgs(proc_mode);
+        incumbentBound(*this, objectives(), triggers, incumbent);
+    }
+    if(variant != nullptr && variant->archive != nullptr){
+        LOG_INFO("Sharing the Pareto front with the other parallel workers");
+        IntVarArgs triggers;
+        triggers << IntVarArgs(proc) << IntVarArgs(next) << IntVarArgs(proc_mode);
+        paretoBound(*this, objectives(), triggers, variant->archive);
+    }
     LOG_INFO("Model created.");
 }
 
@@ -637,6 +689,8 @@ SDFPROnlineModel::SDFPROnlineModel(bool share, SDFPROnlineModel& s):
     desDec(s.desDec),
     cfg(s.cfg),
     rnd(s.rnd),
+    incumbent(s.incumbent),
+    th_prop(s.th_prop),
     least_power_est(s.least_power_est){
 
     next.update(*this, share, s.next);
@@ -683,40 +737,154 @@ Space* SDFPROnlineModel::copy(bool share) {
     return new SDFPROnlineModel(share, *this);
 }
 
+bool SDFPROnlineModel::master(const MetaInfo& mi) {
+    bool complete = Space::master(mi);
+    if(incumbent != nullptr){
+        constrainIncumbent();
+    }
+    return complete;
+}
+
+void SDFPROnlineModel::constrainIncumbent() {
+    vector<int> best;
+    if(!incumbent->get(best))
+        return;
+    IntVarArgs obj = objectives();
+    if(obj.size() == (int) best.size()){
+        rel(*this, obj, IRT_LE, IntArgs(best));
+    }
+}
+
+namespace {
+
+//printed variables of PrintRecord, in the order of print()
+enum PrintGroup {
+  P_PROC, P_PROC_MODE, P_IC_MODE, P_PERIOD, P_SYS_UTILIZATION, P_PROCSUSED_UTILIZATION,
+  P_SYS_POWER, P_SYSUSED_POWER, P_SYS_AREA, P_SYSUSED_AREA, P_SYS_COST, P_SYSUSED_COST,
+  P_NEXT, P_TDMA_ALLOC, P_CHOSEN_ROUTE, P_INJECTION_TABLE, P_SEND_NEXT, P_REC_NEXT
+};
+
+void copyVar(SDFPROnlineModel::PrintRecord& r, const IntVar& x){
+  if(!x.assigned()){
+    ostringstream domain;
+    domain << x;
+    r.domains[r.values.size()] = domain.str();
+  }
+  r.values.push_back(x.min());
+}
+
+void copyGroup(SDFPROnlineModel::PrintRecord& r, const IntVar& x){
+  copyVar(r, x);
+  r.ends.push_back(r.values.size());
+}
+
+void copyGroup(SDFPROnlineModel::PrintRecord& r, const IntVarArray& x){
+  for(int i = 0; i < x.size(); i++){
+    copyVar(r, x[i]);
+  }
+  r.ends.push_back(r.values.size());
+}
+
+//reads a PrintRecord, the output of variables and arrays is that of Gecode
+class RecordPrinter {
+public:
+  RecordPrinter(const SDFPROnlineModel::PrintRecord& _r) : r(_r) {}
+  size_t begin(PrintGroup g) const { return g == 0 ? 0 : r.ends[g-1]; }
+  bool assigned(size_t i) const { return r.domains.find(i) == r.domains.end(); }
+  int value(size_t i) const { return r.values[i]; }
+  void var(std::ostream& out, size_t i) const {
+    auto it = r.domains.find(i);
+    if(it != r.domains.end()){
+      out << it->second;
+    }else{
+      out << r.values[i];
+    }
+  }
+  void scalar(std::ostream& out, PrintGroup g) const {
+    var(out, begin(g));
+  }
+  void array(std::ostream& out, PrintGroup g) const {
+    out << '{';
+    for(size_t i = begin(g); i < r.ends[g]; i++){
+      if(i > begin(g)) out << ", ";
+      var(out, i);
+    }
+    out << '}';
+  }
+private:
+  const SDFPROnlineModel::PrintRecord& r;
+};
+
+}
+
+SDFPROnlineModel::PrintRecord SDFPROnlineModel::getPrintRecord() const {
+  PrintRecord r;
+  r.apps = apps;
+  r.platform = platform;
+  copyGroup(r, proc);
+  copyGroup(r, proc_mode);
+  copyGroup(r, ic_mode);
+  copyGroup(r, period);
+  copyGroup(r, sys_utilization);
+  copyGroup(r, procsUsed_utilization);
+  copyGroup(r, sys_power);
+  copyGroup(r, sysUsed_power);
+  copyGroup(r, sys_area);
+  copyGroup(r, sysUsed_area);
+  copyGroup(r, sys_cost);
+  copyGroup(r, sysUsed_cost);
+  copyGroup(r, next);
+  //only printed for their interconnect
+  copyGroup(r, platform->getInterconnectType() == TDMA_BUS ? tdmaAlloc : IntVarArray());
+  copyGroup(r, platform->getInterconnectType() == TDN_NOC ? chosenRoute : IntVarArray());
+  copyGroup(r, platform->getInterconnectType() == TDN_NOC ? injectionTable : IntVarArray());
+  copyGroup(r, sendNext);
+  copyGroup(r, recNext);
+  return r;
+}
+
 void SDFPROnlineModel::print(std::ostream& out) const {
+    print(getPrintRecord(), out);
+}
+
+void SDFPROnlineModel::print(const PrintRecord& r, std::ostream& out) {
+    RecordPrinter p(r);
+    Applications* apps = r.apps;
+    Platform* platform = r.platform;
     out << "----------------------------------------" << endl;
-    out << "Proc: " << proc << endl;
-    out << "proc mode: " << proc_mode << endl;
-    out << "ic mode: " << ic_mode << endl;
+    out << "Proc: "; p.array(out, P_PROC); out << endl;
+    out << "proc mode: "; p.array(out, P_PROC_MODE); out << endl;
+    out << "ic mode: "; p.scalar(out, P_IC_MODE); out << endl;
     //out << "Latency: " << latency << endl;
-    out << "Period: " << period << endl;
+    out << "Period: "; p.array(out, P_PERIOD); out << endl;
     //out << "Procs used: " << procsUsed << endl;
     //out << "Proc_period: " << proc_period << endl;
     //out << "Proc utilization: " << utilization << endl;
-    out << "Sys utilization: " << sys_utilization << endl;
-    out << "ProcsUsed utilization: " << procsUsed_utilization << endl;
+    out << "Sys utilization: "; p.scalar(out, P_SYS_UTILIZATION); out << endl;
+    out << "ProcsUsed utilization: "; p.scalar(out, P_PROCSUSED_UTILIZATION); out << endl;
     //out << "proc power: " << proc_powerDyn << endl;
     //out << "noc power: " << noc_power << endl;
     //out << "noc power (only used parts): " << nocUsed_power << endl;
-    out << "sys power: " << sys_power << endl;
-    out << "sys power (only used parts): " << sysUsed_power << endl;
+    out << "sys power: "; p.scalar(out, P_SYS_POWER); out << endl;
+    out << "sys power (only used parts): "; p.scalar(out, P_SYSUSED_POWER); out << endl;
     //out << "proc area: " << proc_area << endl;
     //out << "noc area: " << noc_area << endl;
     //out << "noc area (only used parts): " << nocUsed_area << endl;
-    out << "sys area: " << sys_area << endl;
-    out << "sys area (only used parts): " << sysUsed_area << endl;
+    out << "sys area: "; p.scalar(out, P_SYS_AREA); out << endl;
+    out << "sys area (only used parts): "; p.scalar(out, P_SYSUSED_AREA); out << endl;
     //out << "proc cost: " << proc_cost << endl;
     //out << "noc cost: " << noc_cost << endl;
     //out << "noc cost (only used parts): " << nocUsed_cost << endl;
-    out << "sys cost: " << sys_cost << endl;
-    out << "sys cost (only used parts): " << sysUsed_cost << endl;
+    out << "sys cost: "; p.scalar(out, P_SYS_COST); out << endl;
+    out << "sys cost (only used parts): "; p.scalar(out, P_SYSUSED_COST); out << endl;
+    size_t next = p.begin(P_NEXT);
     out << "Next: ";
     for(size_t ii = 0; ii < apps->n_SDFActors(); ii++){
-        out << next[ii] << " ";
+        p.var(out, next + ii); out << " ";
     }
     out << "|| ";
     for(size_t ii = 0; ii < platform->nodes(); ii++){
-        out << next[apps->n_SDFActors() + ii] << " ";
+        p.var(out, next + apps->n_SDFActors() + ii); out << " ";
     }
     out << endl;
     //out << "Rank: ";
@@ -726,25 +894,27 @@ void SDFPROnlineModel::print(std::ostream& out) const {
     out << endl;
     
     if(platform->getInterconnectType() == TDMA_BUS){
-      out << "TDMA slots: " << tdmaAlloc << endl;
+      out << "TDMA slots: "; p.array(out, P_TDMA_ALLOC); out << endl;
     }
     
     //print TDN table
     if(platform->getInterconnectType() == TDN_NOC){
-      out << endl << "Chosen routes: " << chosenRoute << endl;
+      out << endl << "Chosen routes: "; p.array(out, P_CHOSEN_ROUTE); out << endl;
       
       vector<tdn_graphNode> tdn_graph = platform->getTDNGraph();
+      size_t injectionTable = p.begin(P_INJECTION_TABLE);
+      int n_injectionTable = r.ends[P_INJECTION_TABLE] - injectionTable;
       out << endl << "TDN table: " << endl;
-      for(int ii = 0; ii < injectionTable.size(); ii++){
+      for(int ii = 0; ii < n_injectionTable; ii++){
         if(ii!=0 && ii%platform->getTDNCycles()==0){out << endl;}
         if(ii%platform->getTDNCycles()==0){
           out << ((tdn_graph[ii].link.from==-1)?"NI":("SW"+tools::toString(tdn_graph[ii].link.from))) << " -> ";
           out << ((tdn_graph[ii].link.to==-1)?"NI":("SW"+tools::toString(tdn_graph[ii].link.to))) << ": ";
         }
-        if(injectionTable[ii].assigned() && injectionTable[ii].val()==(int)platform->nodes()){
+        if(p.assigned(injectionTable + ii) && p.value(injectionTable + ii)==(int)platform->nodes()){
           out << "_";
         }else{
-          out << injectionTable[ii];
+          p.var(out, injectionTable + ii);
         }
         out << " ";
         
@@ -765,15 +935,34 @@ void SDFPROnlineModel::print(std::ostream& out) const {
     }
     out << endl << endl;*/
     
-    out << "Sending-order: " << sendNext << endl;
+    out << "Sending-order: "; p.array(out, P_SEND_NEXT); out << endl;
     //out << "wcct_b: " << wcct_b << endl;
     //out << "wcct_s: " << wcct_s << endl;
-    out << "Receiving-order: " << recNext << endl;
+    out << "Receiving-order: "; p.array(out, P_REC_NEXT); out << endl;
     //out << "wcct_r: " << wcct_r << endl;
     out << "----------------------------------------" << endl;
 
 }
 
+vector<pair<string, IntVarArgs>> SDFPROnlineModel::solutionColumns() const {
+  IntVarArgs icMode, sysPower, sysUsedPower;
+  icMode << ic_mode;
+  sysPower << sys_power;
+  sysUsedPower << sysUsed_power;
+  vector<pair<string, IntVarArgs>> columns;
+  columns.push_back(make_pair("proc", IntVarArgs(proc)));
+  columns.push_back(make_pair("next", IntVarArgs(next)));
+  columns.push_back(make_pair("sendNext", IntVarArgs(sendNext)));
+  columns.push_back(make_pair("recNext", IntVarArgs(recNext)));
+  columns.push_back(make_pair("proc_mode", IntVarArgs(proc_mode)));
+  columns.push_back(make_pair("ic_mode", icMode));
+  columns.push_back(make_pair("tdmaAlloc", IntVarArgs(tdmaAlloc)));
+  columns.push_back(make_pair("period", IntVarArgs(period)));
+  columns.push_back(make_pair("sys_power", sysPower));
+  columns.push_back(make_pair("sysUsed_power", sysUsedPower));
+  return columns;
+}
+
 void SDFPROnlineModel::printCSV(std::ostream& out) const {
     const char sep = ',';
     //for(auto i = 0; i < latency.size(); i++)
@@ -824,6 +1013,143 @@ vector<int> SDFPROnlineModel::getOptimizationValues(){
 }
 
 
+/** returns the values of the objectives imposed by constrain(), in lexicographic order */
+vector<int> SDFPROnlineModel::getObjectiveValues() const{
+  vector<int> values;
+  IntVarArgs obj = objectives();
+  for(int i = 0; i < obj.size(); i++){
+    if(obj[i].assigned()) values.push_back(obj[i].val());
+  }
+  return values;
+}
+
+IntVarArgs SDFPROnlineModel::objectives() const{
+  IntVarArgs obj;
+  if(cfg->settings().search == Config::PARETO){ //every criterion, and the period of every unconstrained application
+    for(auto c : cfg->settings().criteria){
+      if(c == Config::POWER){
+        obj << sys_power;
+      }else if(c == Config::THROUGHPUT){
+        for(size_t i=0;i<apps->n_SDFApps();i++){
+          if(apps->getPeriodConstraint(i) == -1) obj << period[i];
+        }
+      }
+    }
+    return obj;
+  }
+  int optPeriod = -1; //the period under optimization (first application without period constraint)
+  for(size_t i=0;i<apps->n_SDFApps();i++){
+    if(apps->getPeriodConstraint(i) == -1){
+      optPeriod = i;
+      break;
+    }
+  }
+  
+  if(cfg->settings().optimizationStep == 0){
+    if(cfg->settings().criteria[0] == Config::POWER){
+      obj << sys_power;
+    }else if(cfg->settings().criteria[0] == Config::THROUGHPUT && optPeriod >= 0){
+      obj << period[optPeriod];
+    }
+  }else if(cfg->doOptimizePower() && cfg->doOptimizeThput()){
+    if(optPeriod >= 0){
+      if(cfg->doOptimizePower(cfg->settings().optimizationStep) 
+         && cfg->doOptimizeThput(cfg->settings().optimizationStep-1)){ //first throughput, then power
+        obj << period[optPeriod] << sys_power;
+      }else if(cfg->doOptimizeThput(cfg->settings().optimizationStep)
+         && cfg->doOptimizePower(cfg->settings().optimizationStep-1)){ //first power, then throughput
+        obj << sys_power << period[optPeriod];
+      }
+    }
+  }else if(!cfg->doOptimizePower() && cfg->doOptimizeThput()){
+    if(optPeriod >= 0) obj << period[optPeriod];
+  }else if(cfg->doOptimizePower() && !cfg->doOptimizeThput()){
+    obj << sys_power;
+  }
+  return obj;
+}
+
+vector<string> SDFPROnlineModel::objectiveNames() const{
+  vector<string> names;
+  if(cfg->settings().search == Config::PARETO){
+    for(auto c : cfg->settings().criteria){
+      if(c == Config::POWER){
+        names.push_back("power");
+      }else if(c == Config::THROUGHPUT){
+        for(size_t i=0;i<apps->n_SDFApps();i++){
+          if(apps->getPeriodConstraint(i) == -1) names.push_back("period_" + apps->getGraphName(i));
+        }
+      }
+    }
+  }else{
+    for(int k = 0; k < objectives().size(); k++){
+      names.push_back("objective_" + tools::toString(k));
+    }
+  }
+  return names;
+}
+
+SDFPROnlineModel::Assignment SDFPROnlineModel::getAssignment() const{
+  Assignment a;
+  auto value = [](const IntVar& x) { return x.assigned() ? x.val() : Assignment::UNASSIGNED; };
+  for(int i=0; i<proc.size(); i++) a.proc.push_back(proc[i].val());
+  for(int i=0; i<next.size(); i++) a.next.push_back(value(next[i]));
+  for(int i=0; i<sendNext.size(); i++) a.sendNext.push_back(value(sendNext[i]));
+  for(int i=0; i<tdmaAlloc.size(); i++) a.tdmaAlloc.push_back(value(tdmaAlloc[i]));
+  for(int i=0; i<proc_mode.size(); i++) a.proc_mode.push_back(value(proc_mode[i]));
+  a.objectives = getObjectiveValues();
+  if(th_prop == Config::MCR){ //only this variant posted the MCR propagator that reports them
+    a.critical = ThroughputMCR::criticalActors();
+  }
+  return a;
+}
+
+void SDFPROnlineModel::fixAssignment(const Assignment& a, const vector<bool>& relaxed, const vector<int>& extraProcs, bool improve){
+  //processors whose entities change
+  vector<bool> touched(platform->nodes(), false);
+  for(size_t i=0; i<apps->n_programEntities(); i++){
+    if(relaxed[i]) touched[a.proc[i]] = true;
+  }
+  for(int j : extraProcs) touched[j] = true;
+  IntArgs open;
+  for(size_t j=0; j<platform->nodes(); j++){
+    if(touched[j]) open << j;
+  }
+  
+  for(size_t i=0; i<apps->n_programEntities(); i++){
+    if(relaxed[i]){
+      dom(*this, proc[i], IntSet(open));
+    }else{
+      rel(*this, proc[i] == a.proc[i]);
+    }
+  }
+  //the dummy node n+j of the schedules heads the schedule of processor j+1 (the last one of processor 0)
+  size_t n = apps->n_SDFActors();
+  //variables that were not assigned in a stay free
+  auto fix = [this](IntVar x, int v) { if(v != Assignment::UNASSIGNED) rel(*this, x == v); };
+  for(size_t i=0; i<n; i++){
+    if(!touched[a.proc[i]]) fix(next[i], a.next[i]);
+  }
+  for(size_t j=0; j<platform->nodes(); j++){
+    if(!touched[(j+1) % platform->nodes()]) fix(next[n+j], a.next[n+j]);
+  }
+  vector<SDFChannel*> channels = apps->getChannels();
+  size_t n_ch = apps->n_programChannels();
+  for(size_t k=0; k<channels.size() && k<n_ch; k++){
+    if(!touched[a.proc[channels[k]->source]]) fix(sendNext[k], a.sendNext[k]);
+  }
+  for(size_t j=0; j<platform->nodes(); j++){
+    if(!touched[(j+1) % platform->nodes()]) fix(sendNext[n_ch+j], a.sendNext[n_ch+j]);
+    if(!touched[j]) fix(tdmaAlloc[j], a.tdmaAlloc[j]);
+    if(!touched[j]) fix(proc_mode[j], a.proc_mode[j]);
+  }
+  
+  IntVarArgs obj = objectives();
+  if(obj.size() == (int) a.objectives.size() && obj.size() > 0){
+    rel(*this, obj, improve ? IRT_LE : IRT_LQ, IntArgs(a.objectives));
+  }
+}
+
 /** returns the values of the parameters that are under optimization */
 vector<int> SDFPROnlineModel::getPrintMetrics(){
   vector<int> values;
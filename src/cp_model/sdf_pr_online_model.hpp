@@ -30,6 +30,9 @@
  */
 #include <math.h>
 #include <vector>
+#include <map>
+#include <chrono>
+#include <climits>
 
 #include <gecode/int.hh>
 #include <gecode/set.hh>
@@ -43,10 +46,25 @@
 #include "../throughput/throughputSSE.hpp"
 #include "../throughput/throughputMCR.hpp"
 #include "schedulability.hpp"
+#include "static_order.hpp"
+#include "model_profile.hpp"
+#include "incumbent.hpp"
+#include "pareto.hpp"
 #include "../settings/dse_settings.hpp"
 
 using namespace Gecode;
 
+/**
+ * Settings that differ between the workers of a parallel search.
+ */
+struct SearchVariant {
+    unsigned int                    seed;       /**< seed for the random value selection (0: hardware seed). */
+    double                          afc_decay;  /**< decay factor of the AFC variable selection. */
+    Config::ThroughputPropagator    th_prop;    /**< throughput propagator. */
+    Incumbent*                      incumbent;  /**< best bound shared with the other workers (nullptr: none). */
+    ParetoArchive*                  archive;    /**< Pareto front shared with the other workers (nullptr: none). */
+};
+
 /**
  * Gecode space containing the scheduling model based on the paper.
  */
@@ -61,6 +79,9 @@ private:
     //DSESettings*             settings;    /**< Pointer to the setting object. */
     Config*                 cfg;    /**< Pointer to the config object. */
     Rnd                     rnd;    /**< Random number generator. */
+    Incumbent*              incumbent;    /**< Best bound shared with parallel workers (nullptr: none). */
+    Config::ThroughputPropagator th_prop; /**< throughput propagator posted by this space (of its search variant). */
+    ModelProfile            profile;      /**< size of the constraint blocks, only kept by the root space. */
 
     IntVarArray             next;        /**< static schedule of firings. */
     //IntVarArray             rank;
@@ -109,10 +130,15 @@ private:
     
 
     int                        least_power_est;        /**< estimated least power consumption. */
+
+    /**
+     * Requires the objectives to improve on the shared incumbent.
+     */
+    void constrainIncumbent();
   
 public:
 
-    SDFPROnlineModel(Mapping* p_mapping, Config* _cfg);
+    SDFPROnlineModel(Mapping* p_mapping, Config* _cfg, const SearchVariant* variant = nullptr);
 
     SDFPROnlineModel(bool share, SDFPROnlineModel& s);
 
@@ -148,12 +174,89 @@ public:
     * Prints mappings and modes for csv output
     */ 
     void printMappingCSV(std::ostream& out) const;
+    /**
+    * Values of the variables print() shows, copied out of a solution so
+    * that they can be formatted after the space is deleted.
+    */
+    struct PrintRecord {
+        Applications*      apps = nullptr;
+        Platform*          platform = nullptr;
+        vector<int>        values;  /**< values of the printed variables, in the order of print(). */
+        vector<size_t>     ends;    /**< end of each printed variable or array in values. */
+        map<size_t,string> domains; /**< domains of unassigned variables, by position in values. */
+    };
+    /**
+    * Copies the printed variables
+    */
+    PrintRecord getPrintRecord() const;
+    /**
+    * Prints a record as print() prints the space it was copied from. Only
+    * reads the application and platform, so it may run in another thread.
+    */
+    static void print(const PrintRecord& r, std::ostream& out);
+    /**
+    * Columns of the binary solution file (output-file-type BIN): mapping,
+    * schedules, modes, TDMA slots, period and power, with their variables
+    */
+    vector<pair<string, IntVarArgs>> solutionColumns() const;
+    /**
+    * Size of the root space per block of constraints
+    */ 
+    const ModelProfile& getProfile() const { return profile; }
+    /**
+     * The variables constrain() improves on, in lexicographic order.
+     * For PARETO search, all variables of dse.criteria, each minimized.
+     */
+    IntVarArgs objectives() const;
+    /**
+     * Names of the objectives, for the header of the Pareto front.
+     */
+    vector<string> objectiveNames() const;
+    
+    /**
+     * Decisions of a solution, kept by large neighbourhood search.
+     */
+    struct Assignment {
+        static const int UNASSIGNED = INT_MIN; /**< value of a variable that is not assigned at the solution. */
+        vector<int> proc, next, sendNext, tdmaAlloc, proc_mode;
+        vector<int> objectives; /**< values of objectives(). */
+        vector<int> critical;   /**< actors on the critical cycles (only with the MCR propagator). */
+    };
+    /**
+     * Extracts the decisions of this (solved) space. Variables that are not
+     * branched on for the platform or applications (e.g. tdmaAlloc on a TDN)
+     * can be unassigned at a solution, they are recorded as UNASSIGNED and
+     * left free by fixAssignment. Must be called in the thread that found
+     * the solution, for the critical cycles.
+     */
+    Assignment getAssignment() const;
+    /**
+     * Restricts the space to a neighbourhood of a: the relaxed entities may
+     * move between the processors that host a relaxed entity in a; all other
+     * entities keep their processor. The schedules (next, sendNext), the
+     * TDMA slots and the modes of the other processors are fixed, and the
+     * objectives must improve on a, lexicographically.
+     * @param relaxed relaxed[i]: program entity i is in the neighbourhood
+     * @param extraProcs processors that relaxed entities may move to in addition
+     * @param improve false: the objectives must only be as good as in a
+     */
+    void fixAssignment(const Assignment& a, const vector<bool>& relaxed, const vector<int>& extraProcs, bool improve = true);
     /**
      * function for imposing new constraints when using branch-and-bound
      */ 
     virtual void constrain(const Space& _b)
     {
         const SDFPROnlineModel& b = static_cast<const SDFPROnlineModel&>(_b);
+        if(cfg->settings().search == Config::PARETO){ //b must not (weakly) dominate the next solution
+          IntVarArgs obj = objectives();
+          vector<int> values = b.getObjectiveValues();
+          BoolVarArgs better;
+          for(int k=0; k<obj.size() && k<(int)values.size(); k++){
+            better << expr(*this, obj[k] < values[k]);
+          }
+          rel(*this, BOT_OR, better, 1);
+          return; //the earlier solutions are pruned by ParetoBound
+        }
         if(cfg->settings().optimizationStep == 0){
           switch(cfg->settings().criteria[0]) //creates the model based on the first criterion
           {
@@ -213,7 +316,17 @@ public:
           
           
         }
+        if(incumbent != nullptr){ //the best solution of all parallel workers
+          constrainIncumbent();
+        }
     }
+    
+    /**
+     * Called on the master space when a restart-based search restarts:
+     * besides the default (last solution, no-goods), the restarted search
+     * is constrained by the best solution of all parallel workers.
+     */
+    virtual bool master(const MetaInfo& mi);
   
     vector<int> getPeriodResults();
     
@@ -221,6 +334,8 @@ public:
     vector<int> getOptimizationValues();
     /** returns the values of the parameters that are chosen for printing. */
     vector<int> getPrintMetrics();
+    /** returns the values of the objectives imposed by constrain(), in lexicographic order */
+    vector<int> getObjectiveValues() const;
     
     /**
     * Returns the processor number which task i has to be allocated.
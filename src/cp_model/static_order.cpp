@@ -0,0 +1,254 @@
+#include "static_order.hpp"
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+DependencyGraph::DependencyGraph() {}
+
+DependencyGraph::DependencyGraph(const vector<vector<int>>& dependents)
+  : SharedHandle(new Data()) {
+  Data* d = data();
+  d->n_actors = dependents.size();
+  d->words = (d->n_actors + 63) / 64;
+  d->succ.assign(d->n_actors * d->words, 0);
+  d->pred.assign(d->n_actors * d->words, 0);
+  for(size_t ii = 0; ii < dependents.size(); ii++){
+    for(int ij : dependents[ii]){
+      d->succ[ii * d->words + ij / 64] |= 1ULL << (ij % 64);
+      d->pred[ij * d->words + ii / 64] |= 1ULL << (ii % 64);
+    }
+  }
+}
+
+DependencyGraph::DependencyGraph(const DependencyGraph& d) : SharedHandle(d) {}
+
+DependencyGraph& DependencyGraph::operator=(const DependencyGraph& d){
+  return static_cast<DependencyGraph&>(SharedHandle::operator=(d));
+}
+
+
+StaticOrder::StaticOrder(Space& home, ViewArray<IntView> _next, ViewArray<IntView> _rank,
+                         ViewArray<IntView> _proc, const DependencyGraph& _deps)
+  : Propagator(home), next(_next), rank(_rank), proc(_proc), deps(_deps) {
+
+  next.subscribe(home, *this, Int::PC_INT_VAL);
+  rank.subscribe(home, *this, Int::PC_INT_BND);
+  proc.subscribe(home, *this, Int::PC_INT_VAL);
+  home.notice(*this, AP_DISPOSE);
+}
+
+size_t StaticOrder::dispose(Space& home){
+  home.ignore(*this, AP_DISPOSE);
+  next.cancel(home, *this, Int::PC_INT_VAL);
+  rank.cancel(home, *this, Int::PC_INT_BND);
+  proc.cancel(home, *this, Int::PC_INT_VAL);
+  deps.~DependencyGraph();
+  (void) Propagator::dispose(home);
+  return sizeof(*this);
+}
+
+Propagator* StaticOrder::copy(Space& home, bool share){
+  return new (home) StaticOrder(home, share, *this);
+}
+
+PropCost StaticOrder::cost(const Space& home, const ModEventDelta& med) const{
+  return PropCost::quadratic(PropCost::HI, next.size());
+}
+
+void StaticOrder::reschedule(Space& home){
+  next.reschedule(home, *this, Int::PC_INT_VAL);
+  rank.reschedule(home, *this, Int::PC_INT_BND);
+  proc.reschedule(home, *this, Int::PC_INT_VAL);
+}
+
+StaticOrder::StaticOrder(Space& home, bool share, StaticOrder& p)
+  : Propagator(home, share, p) {
+
+  next.update(home, share, p.next);
+  rank.update(home, share, p.rank);
+  proc.update(home, share, p.proc);
+  deps.update(home, share, p.deps);
+}
+
+//actors in a bitset
+static void members(const uint64_t* set, size_t words, vector<int>& out){
+  out.clear();
+  for(size_t w = 0; w < words; w++){
+    uint64_t bits = set[w];
+    while(bits){
+      out.push_back(w * 64 + __builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+}
+
+ExecStatus StaticOrder::sameProc(Space& home, int ii, int ij, const vector<int>& prv, bool& modified){
+  const int n_actors = rank.size();
+
+  //ii is not the last and ij not the first actor on the processor
+  GECODE_ME_CHECK_MODIFIED(modified, next[ii].le(home, n_actors));
+  for(int d = n_actors; d < next.size(); d++){
+    GECODE_ME_CHECK_MODIFIED(modified, next[d].nq(home, ij));
+  }
+
+  //the actor ik after ii comes before ij
+  if(next[ii].assigned()){
+    int ik = next[ii].val();
+    if(ik != ij){
+      GECODE_ME_CHECK_MODIFIED(modified, rank[ij].gq(home, rank[ik].min() + 1));
+      GECODE_ME_CHECK_MODIFIED(modified, rank[ik].lq(home, rank[ij].max() - 1));
+    }
+  }else{
+    for(int ik = 0; ik < n_actors; ik++){
+      if(ik != ij && next[ii].in(ik) && rank[ik].min() >= rank[ij].max())
+        GECODE_ME_CHECK_MODIFIED(modified, next[ii].nq(home, ik));
+    }
+  }
+
+  //the actor ik before ij comes after ii
+  if(prv[ij] >= 0){
+    int ik = prv[ij];
+    if(ik != ii){
+      GECODE_ME_CHECK_MODIFIED(modified, rank[ik].gq(home, rank[ii].min() + 1));
+      GECODE_ME_CHECK_MODIFIED(modified, rank[ii].lq(home, rank[ik].max() - 1));
+    }
+  }else{
+    for(int ik = 0; ik < n_actors; ik++){
+      if(ik != ii && !next[ik].assigned() && next[ik].in(ij) && rank[ik].max() <= rank[ii].min())
+        GECODE_ME_CHECK_MODIFIED(modified, next[ik].nq(home, ij));
+    }
+  }
+  return ES_OK;
+}
+
+bool StaticOrder::excludesSameProc(int ii, int ij, const vector<int>& prv) const{
+  const int n_actors = rank.size();
+
+  if(next[ii].assigned()){
+    int ik = next[ii].val();
+    if(ik >= n_actors) //ii is the last actor on its processor
+      return true;
+    if(ik != ij && rank[ij].max() <= rank[ik].min())
+      return true;
+  }
+  if(prv[ij] >= 0){
+    int ik = prv[ij];
+    if(ik != ii && rank[ik].max() <= rank[ii].min())
+      return true;
+  }
+  for(int d = n_actors; d < next.size(); d++){ //ij is the first actor on a processor
+    if(next[d].assigned() && next[d].val() == ij)
+      return true;
+  }
+  return false;
+}
+
+ExecStatus StaticOrder::propagate(Space& home, const ModEventDelta&){
+  const int n_actors = rank.size();
+  const size_t words = deps.words();
+  bool modified = false;
+
+  //chains of assigned next values
+  vector<int> nxt(n_actors, -1);
+  vector<int> prv(n_actors, -1);
+  for(int a = 0; a < n_actors; a++){
+    if(next[a].assigned() && next[a].val() < n_actors){
+      nxt[a] = next[a].val();
+      if(prv[nxt[a]] >= 0) //two actors with the same successor
+        return ES_FAILED;
+      prv[nxt[a]] = a;
+    }
+  }
+
+  //head and tail of the chain of each actor (single actors are chains of one)
+  vector<int> headOf(n_actors, -1);
+  vector<int> tailOf(n_actors, -1);
+  for(int head = 0; head < n_actors; head++){
+    if(prv[head] >= 0)
+      continue;
+    int tail = head;
+    for(int x = head; x >= 0; x = nxt[x]){
+      headOf[x] = head;
+      tail = x;
+    }
+    for(int x = head; x >= 0; x = nxt[x]){
+      tailOf[x] = tail;
+    }
+  }
+
+  //along each chain, no actor may depend on an actor after it
+  vector<uint64_t> seen(words), predsOfChain(words), succsOfChain(words);
+  vector<int> actors;
+  for(int head = 0; head < n_actors; head++){
+    if(prv[head] >= 0)
+      continue;
+    fill(seen.begin(), seen.end(), 0);
+    fill(predsOfChain.begin(), predsOfChain.end(), 0);
+    fill(succsOfChain.begin(), succsOfChain.end(), 0);
+    int tail = head;
+    for(int x = head; x >= 0; x = nxt[x]){
+      const uint64_t* succ = deps.succ(x);
+      const uint64_t* pred = deps.pred(x);
+      for(size_t w = 0; w < words; w++){
+        if(succ[w] & seen[w]) //an actor earlier in the chain depends on x
+          return ES_FAILED;
+        predsOfChain[w] |= pred[w];
+        succsOfChain[w] |= succ[w];
+      }
+      seen[x / 64] |= 1ULL << (x % 64);
+      tail = x;
+    }
+    //the tail cannot be followed by a predecessor of the chain, nor by the head of its chain
+    if(!next[tail].assigned()){
+      members(predsOfChain.data(), words, actors);
+      for(int y : actors){
+        if(next[tail].in(y))
+          GECODE_ME_CHECK_MODIFIED(modified, next[tail].nq(home, y));
+        if(headOf[y] >= 0 && next[tail].in(headOf[y]))
+          GECODE_ME_CHECK_MODIFIED(modified, next[tail].nq(home, headOf[y]));
+      }
+    }
+    //the head cannot be preceded by a successor of the chain, nor by the tail of its chain
+    members(succsOfChain.data(), words, actors);
+    for(int z : actors){
+      if(!next[z].assigned() && next[z].in(head))
+        GECODE_ME_CHECK_MODIFIED(modified, next[z].nq(home, head));
+      int t = tailOf[z];
+      if(t >= 0 && !next[t].assigned() && next[t].in(head))
+        GECODE_ME_CHECK_MODIFIED(modified, next[t].nq(home, head));
+    }
+  }
+
+  //dependent actors on the same processor
+  for(int ii = 0; ii < n_actors; ii++){
+    members(deps.succ(ii), words, actors);
+    for(int ij : actors){
+      if(proc[ii].assigned() && proc[ij].assigned()){
+        if(proc[ii].val() == proc[ij].val())
+          GECODE_ES_CHECK(sameProc(home, ii, ij, prv, modified));
+      }else if(proc[ii].assigned() || proc[ij].assigned()){
+        if(excludesSameProc(ii, ij, prv)){
+          int fixed = proc[ii].assigned() ? ii : ij;
+          int other = proc[ii].assigned() ? ij : ii;
+          GECODE_ME_CHECK_MODIFIED(modified, proc[other].nq(home, proc[fixed].val()));
+        }
+      }
+    }
+  }
+
+  return modified ? ES_NOFIX : ES_FIX;
+}
+
+void staticOrder(Space& home, const IntVarArgs& _next, const IntVarArgs& _rank,
+                 const IntVarArgs& _proc, const vector<vector<int>>& dependents){
+  if(home.failed())
+    return;
+
+  ViewArray<IntView> next(home, _next);
+  ViewArray<IntView> rank(home, _rank);
+  ViewArray<IntView> proc(home, _proc);
+  if(StaticOrder::post(home, next, rank, proc, DependencyGraph(dependents)) != ES_OK){
+    home.fail();
+  }
+}
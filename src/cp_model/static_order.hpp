@@ -0,0 +1,98 @@
+#pragma once
+#include <gecode/int.hh>
+#include <vector>
+#include <cstdint>
+
+using namespace Gecode;
+using namespace Int;
+using namespace std;
+
+/**
+ * Dependencies between the SDF actors (ij depends on ii), as bitsets over
+ * the actors. Shared between the clones of a space.
+ */
+class DependencyGraph : public SharedHandle {
+protected:
+  class Data : public SharedHandle::Object {
+  public:
+    size_t n_actors;
+    size_t words; /*!< 64-bit words per bitset. */
+    vector<uint64_t> succ; /*!< succ[ii*words..]: actors depending on ii. */
+    vector<uint64_t> pred; /*!< pred[ij*words..]: actors ij depends on. */
+    virtual Object* copy() const { return new Data(*this); }
+  };
+  Data* data() const { return static_cast<Data*>(object()); }
+
+public:
+  DependencyGraph();
+  /** @param dependents dependents[ii]: actors depending on ii */
+  DependencyGraph(const vector<vector<int>>& dependents);
+  DependencyGraph(const DependencyGraph& d);
+  DependencyGraph& operator=(const DependencyGraph& d);
+
+  size_t n_actors() const { return data()->n_actors; }
+  size_t words() const { return data()->words; }
+  const uint64_t* succ(size_t ii) const { return &data()->succ[ii * words()]; }
+  const uint64_t* pred(size_t ij) const { return &data()->pred[ij * words()]; }
+  bool dependsOn(size_t ii, size_t ij) const { return (succ(ii)[ij / 64] >> (ij % 64)) & 1; }
+};
+
+/**
+ * Static-order schedule of the SDF actors on each processor, replacing the
+ * O(n^4) reified next/rank constraints of scheduling.constraints.
+ *
+ * next[a] is the actor following a on its processor, next[n+j] (a dummy)
+ * points to the first actor on processor j+1 and the last actor on a
+ * processor points to a dummy. For actors ii, ij where ij depends on ii:
+ * - along a chain of assigned next values, ij never comes before ii.
+ *   The tail of a chain cannot be followed by, and its head cannot be
+ *   preceded by, an actor that would break this,
+ * - on the same processor, ii is not the last and ij not the first actor,
+ *   and the actors directly after ii and before ij have a rank in
+ *   between the ranks of ii and ij.
+ * The proc values of dependent actors are pruned when these conditions
+ * cannot hold on a common processor.
+ */
+class StaticOrder : public Propagator {
+
+protected:
+  ViewArray<IntView> next; /*!< successor of each actor, |actors|+|procs|. */
+  ViewArray<IntView> rank; /*!< position of each actor on its processor. */
+  ViewArray<IntView> proc; /*!< processor of each actor. */
+  DependencyGraph deps;
+
+  //ii and ij (depending on ii) are on the same processor. prv[a]: actor
+  //with next == a (-1 if not assigned)
+  ExecStatus sameProc(Space& home, int ii, int ij, const vector<int>& prv, bool& modified);
+  //conditions that exclude ii and ij (depending on ii) from a common processor
+  bool excludesSameProc(int ii, int ij, const vector<int>& prv) const;
+
+public:
+  StaticOrder(Space& home, ViewArray<IntView> _next, ViewArray<IntView> _rank,
+              ViewArray<IntView> _proc, const DependencyGraph& _deps);
+
+  static ExecStatus post(Space& home, ViewArray<IntView> _next, ViewArray<IntView> _rank,
+                         ViewArray<IntView> _proc, const DependencyGraph& _deps){
+    (void) new (home) StaticOrder(home, _next, _rank, _proc, _deps);
+    return ES_OK;
+  }
+
+  virtual size_t dispose(Space& home);
+
+  StaticOrder(Space& home, bool share, StaticOrder& p);
+
+  virtual Propagator* copy(Space& home, bool share);
+
+  virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+
+  virtual void reschedule(Space& home);
+
+  virtual ExecStatus propagate(Space& home, const ModEventDelta&);
+};
+
+/**
+ * Posts the static-order propagator.
+ * @param dependents dependents[ii]: actors depending on ii (Applications::dependsOn)
+ */
+extern void staticOrder(Space& home, const IntVarArgs& _next, const IntVarArgs& _rank,
+                        const IntVarArgs& _proc, const vector<vector<int>>& dependents);
@@ -0,0 +1,57 @@
+#include "checkpoint.hpp"
+#include "../tools/snapshot.hpp"
+
+#include <chrono>
+
+namespace {
+
+void putValues(tools::SnapshotWriter& out, const vector<Config::SolutionValues>& data){
+  out.put((int64_t) data.size());
+  for(auto& d : data){
+    out.put((int64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(d.time).count());
+    out.put(d.values);
+  }
+}
+
+void getValues(tools::SnapshotReader& in, vector<Config::SolutionValues>& data){
+  int64_t n = in.getInt();
+  data.clear();
+  for(int64_t i = 0; i < n; i++){
+    Config::SolutionValues d;
+    d.time = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(in.getInt()));
+    in.get(d.values);
+    data.push_back(d);
+  }
+}
+
+}
+
+void Checkpoint::write(const string& path) const throw (IOException){
+  tools::SnapshotWriter out(path, "checkpoint");
+  out.put(fingerprint);
+  out.put(elapsed_ms);
+  out.put(solutions);
+  out.put(timer_resets);
+  out.put(statistics);
+  putValues(out, optData);
+  putValues(out, solutionData);
+  out.put(incumbent);
+  out.put(objectives);
+  out.commit();
+}
+
+bool Checkpoint::read(const string& path) throw (IOException){
+  tools::SnapshotReader in;
+  if(!in.open(path, "checkpoint"))
+    return false;
+  in.get(fingerprint);
+  in.get(elapsed_ms);
+  in.get(solutions);
+  in.get(timer_resets);
+  in.get(statistics);
+  getValues(in, optData);
+  getValues(in, solutionData);
+  in.get(incumbent);
+  in.get(objectives);
+  return true;
+}
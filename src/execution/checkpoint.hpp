@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "../settings/config.hpp"
+#include "../exceptions/ioexception.h"
+
+using namespace std;
+
+/**
+ * State of an optimizing search that is saved periodically (--checkpoint),
+ * so that a preempted run can continue where it stopped (--resume).
+ *
+ * The file is written through tools::SnapshotWriter, i.e. into a temporary
+ * file that replaces the previous checkpoint only when it is complete.
+ */
+struct Checkpoint {
+  vector<int64_t> fingerprint; /**< size of the problem, model and search settings and input hashes, resuming requires the same. */
+  int64_t elapsed_ms = 0;      /**< search time (including earlier resumed runs) at the checkpoint. */
+  int64_t solutions = 0;       /**< number of solutions found. */
+  int64_t timer_resets = 0;
+  vector<int64_t> statistics;  /**< node, fail, propagate, depth, restart, nogood. */
+  vector<Config::SolutionValues> optData;
+  vector<Config::SolutionValues> solutionData;
+  vector<vector<int>> incumbent; /**< decisions of the best solution (empty: none), in the order of the model. */
+  vector<int> objectives;        /**< objective values of the best solution. */
+
+  /**
+   * Writes the checkpoint to path.
+   */
+  void write(const string& path) const throw (IOException);
+  /**
+   * Reads the checkpoint from path.
+   * @return false if there is no checkpoint at path
+   */
+  bool read(const string& path) throw (IOException);
+};
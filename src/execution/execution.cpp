@@ -40,8 +40,22 @@
 #include <gecode/gist.hh>
 #include "../settings/config.hpp"
 #include "../system/mapping.hpp"
+#include "search_monitor.hpp"
+#include "checkpoint.hpp"
+#include "solution_writer.hpp"
+#include "../tools/propagator_stats.hpp"
+#include "../tools/solution_file.hpp"
 #include <chrono>
 #include <fstream> 
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <map>
+#include <random>
+#include <deque>
+#include <algorithm>
+#include <climits>
 
 using namespace std;
 using namespace Gecode;
@@ -51,25 +65,60 @@ template<class CPModelTemplate>
 class Execution {
 public:
   Execution(CPModelTemplate* _model, Config& _cfg) :
-      model(_model), cfg(_cfg) {
+      model(_model), cfg(_cfg), timeStop(nullptr), monitor(nullptr), monitorStop(nullptr), outBinFailed(false),
+      checkpointStop(nullptr), nextCheckpoint(0), checkpointSol(nullptr), resumedSol(nullptr) {
       geSearchOptions.threads = cfg.settings().threads;
       if(cfg.settings().timeout_first > 0){
-        Search::TimeStop* stop = new Search::TimeStop(cfg.settings().timeout_first);
-        geSearchOptions.stop = stop;
+        timeStop = new Search::TimeStop(cfg.settings().timeout_first);
+        geSearchOptions.stop = timeStop;
+      }
+      if(cfg.settings().telemetry_interval > 0){
+        size_t n_objectives = cfg.doOptimize() ? model->objectives().size() : 0;
+        monitor = new SearchMonitor(cfg.settings().output_path+"out/telemetry.csv", cfg.settings().telemetry_interval, n_objectives);
+        monitorStop = new SearchMonitor::Stop(*monitor, timeStop);
+        geSearchOptions.stop = monitorStop;
+      }
+      if(cfg.settings().checkpoint_interval > 0 && cfg.doOptimize()){
+        checkpointStop = new CheckpointStop(*this, geSearchOptions.stop);
+        geSearchOptions.stop = checkpointStop;
       }
   }
   ;
   ~Execution() {
-    delete geSearchOptions.stop;
+    delete checkpointStop;
+    delete monitorStop;
+    delete monitor;
+    delete timeStop;
+    delete resumedSol;
   }
   /**
    * This funtion executes the CP model.
    * The CP model has to implement the following functions:
    * (i) 	print()
    * (ii) printCSV()
+   * @param inputHashes content hashes of the input files, identify the
+   *        inputs of checkpoints
    */
-  int Execute(Mapping* map) {
+  int Execute(Mapping* map, const vector<uint64_t>& inputHashes = vector<uint64_t>()) {
     if(!cfg.settings().configTDN){
+      checkpointFingerprint = vector<int64_t>{(int64_t) map->getApplications()->n_programEntities(),
+                                              (int64_t) map->getApplications()->n_programChannels(),
+                                              (int64_t) map->getPlatform()->nodes(),
+                                              (int64_t) (cfg.doOptimize() ? model->objectives().size() : 0),
+                                              (int64_t) cfg.settings().search,
+                                              (int64_t) cfg.settings().model,
+                                              (int64_t) cfg.settings().th_prop,
+                                              (int64_t) cfg.settings().group_firings,
+                                              (int64_t) cfg.settings().optimizationStep};
+      for(auto c : cfg.settings().criteria){
+        checkpointFingerprint.push_back((int64_t) c);
+      }
+      for(auto h : inputHashes){
+        checkpointFingerprint.push_back((int64_t) h);
+      }
+      if(cfg.settings().resume){
+        resume();
+      }
       switch (cfg.settings().search) {
       case (Config::GIST_ALL): {
         Gist::Print<CPModelTemplate> p("Print solution");
@@ -99,6 +148,11 @@ public:
         break;
       }
       case (Config::OPTIMIZE_IT): {
+        if(cfg.settings().threads != 1){
+          LOG_INFO("BAB engines, optimizing iteratively in parallel ... ");
+          parallelRestartSearch(map);
+          break;
+        }
         LOG_INFO("BAB engine, optimizing iteratively ... ");
         Search::Cutoff* cut = Search::Cutoff::luby(cfg.settings().luby_scale);
         geSearchOptions.cutoff = cut;
@@ -109,6 +163,21 @@ public:
 
         break;
       }
+      case (Config::PORTFOLIO): {
+        LOG_INFO("Portfolio of BAB engines, optimizing in parallel ... ");
+        portfolioSearch(map);
+        break;
+      }
+      case (Config::PARETO): {
+        LOG_INFO("BAB engines, searching the Pareto front ... ");
+        paretoSearch(map);
+        break;
+      }
+      case (Config::LNS): {
+        LOG_INFO("Large neighbourhood search ... ");
+        lnsSearch(map);
+        break;
+      }
       default:
         THROW_EXCEPTION(RuntimeException, "unknown search type for main solver.");
         break;
@@ -128,12 +197,46 @@ private:
   unsigned long nodes; /**< Number of nodes. */
   int timerResets; /**< Number of incremental timer resets. */
   Search::Options geSearchOptions; /**< Gecode search option object. */
+  Search::TimeStop* timeStop; /**< time-out of the search, nullptr: none. */
+  SearchMonitor* monitor; /**< telemetry sampling during the search, nullptr: off. */
+  Search::Stop* monitorStop; /**< stop object of the sequential engines that samples the monitor. */
   ofstream out, outCSV, outCSV_opt, outMOSTCSV, outMappingCSV; /**< Output file streams: .txt and .csv. */
+  unique_ptr<tools::SolutionFileWriter> outBin; /**< out/solutions.bin (output-file-type BIN), nullptr: none. */
+  atomic<bool> outBinFailed; /**< writing out/solutions.bin failed, no more solutions are appended. */
   typedef std::chrono::high_resolution_clock runTimer; /**< Timer type. */
   runTimer::time_point t_start, t_endAll; /**< Timer objects for start and end of experiment. */
   vector<Config::SolutionValues> optData, solutionData;
   unsigned long infoFreq; /**< Adapt the printing frequency of how many solutions have been found to the number of solutions. */
   
+  /**
+   * Writes a checkpoint from within the search engine when dse.checkpoint ms
+   * have passed since the last one, and asks the wrapped stop object
+   * (nullptr: none) whether to stop. The clock is only read every 256 calls.
+   */
+  class CheckpointStop : public Search::Stop {
+  public:
+    CheckpointStop(Execution& _exec, Search::Stop* _inner) : exec(_exec), inner(_inner), calls(0) {}
+    virtual bool stop(const Search::Statistics& s, const Search::Options& o) {
+      if(++calls % 256 == 0 && runTimer::now().time_since_epoch().count() >= exec.nextCheckpoint.load()){
+        exec.saveCheckpoint(s, false);
+      }
+      return inner != nullptr && inner->stop(s, o);
+    }
+  private:
+    Execution& exec;
+    Search::Stop* inner;
+    atomic<unsigned long> calls;
+  };
+  CheckpointStop* checkpointStop; /**< stop object of the sequential engines that writes checkpoints, nullptr: off. */
+  atomic<long long> nextCheckpoint; /**< time of the next checkpoint as runTimer ticks. */
+  mutex solutionLock; /**< protects the solution data and the output of all searches, also read when writing a checkpoint. */
+  CPModelTemplate* checkpointSol; /**< best solution of the running search, nullptr: none. */
+  vector<int64_t> checkpointFingerprint; /**< size of the problem, model and search settings and input hashes. */
+  bool resuming = false; /**< the search continues a checkpoint. */
+  Checkpoint resumed; /**< search data of the checkpoint that is continued. */
+  Search::Statistics resumedStats; /**< engine statistics up to the checkpoint. */
+  CPModelTemplate* resumedSol; /**< incumbent of the checkpoint, until the search takes it over. */
+  
 
   void printMOSTCSV(Mapping* solution, int n, int split) {
     //N_TASKS;N_EDGES;N_PES;N_SLOTS;N_SCHEDS;MAP_PE1;MAP_PE2;FREQ_PE1;FREQ_PE2;MEM_PE1;MEM_PE2;SLOTS_PE1;SLOTS_PE2;MAP_T1;MAP_T2;MAP_T3;TASK_SCHED;COMM_SCHED;cluster;
@@ -305,14 +408,15 @@ private:
   template<class SearchEngine> void printSolution(SearchEngine *e, CPModelTemplate* s) {
     
     
-    if(cfg.settings().out_file_type == Config::ALL_OUT ||
-       cfg.settings().out_file_type == Config::TXT){
-      auto durAll = t_endAll - t_start;
-      auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
-      out << "*** Solution number: " << nodes << ", after " << durAll_ms << " ms" << ", search nodes: " << e->statistics().node << ", fail: " << e->statistics().fail << ", propagate: "
-          << e->statistics().propagate << ", depth: " << e->statistics().depth << ", nogoods: " << e->statistics().nogood << ", restarts: " << e->statistics().restart << " ***\n";
+    auto durAll = t_endAll - t_start;
+    auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
+    if(printsText()){
+      printSolutionHeader(nodes, durAll_ms, e->statistics());
       s->print(out);
     }
+    if(writesBin()){
+      appendSolution(solutionColumnValues(nodes, durAll_ms, s));
+    }
     /// Printing CSV format output
     /*if(cfg.settings().out_file_type == Config::ALL_OUT ||
        cfg.settings().out_file_type == Config::CSV){    
@@ -332,47 +436,263 @@ private:
   }
   ;
 
+  /** are the solutions (still) written to out/solutions.bin? */
+  bool writesBin() const {
+    return outBin && !outBinFailed;
+  }
+  
   /**
-   * Loops through the solutions and prints them using the input search engine
+   * Appends a solution to out/solutions.bin. Runs in the search workers or
+   * the writer thread, so an I/O error is logged and disables the binary
+   * output instead of being thrown.
    */
-  template<class SearchEngine> void loopSolutions(SearchEngine *e) {
-    nodes = 0;
-    timerResets = 0;
-    infoFreq = 1;
-    
-    out.open(cfg.settings().output_path+"out/out.txt");
-    LOG_INFO("Opened file for printing results: " +cfg.settings().output_path+"out/out.txt");
-    if(cfg.doOptimize()){
-      outCSV_opt.open(cfg.settings().output_path+"out/out_opt.csv");
+  void appendSolution(const vector<int>& values) {
+    try{
+      outBin->append(values);
+    }catch(IOException& ex){
+      LOG_ERROR("Could not write solution, no more solutions are written to out/solutions.bin: " + ex.toString());
+      outBinFailed = true;
     }
-    if(!cfg.settings().printMetrics.empty()){
-      outCSV.open(cfg.settings().output_path+"out/out.csv");
+  }
+  
+  /** are the solutions printed to out.txt? */
+  bool printsText() const {
+    return cfg.settings().out_file_type == Config::ALL_OUT || cfg.settings().out_file_type == Config::TXT;
+  }
+  
+  /**
+   * Values of a solution for out/solutions.bin: its number, the time in ms and the
+   * variables of the solution columns of the model. Unassigned variables are
+   * stored with their lower bound.
+   */
+  vector<int> solutionColumnValues(unsigned long number, long long ms, const CPModelTemplate* s) const {
+    vector<int> values{(int) number, (int) std::min<long long>(ms, INT_MAX)};
+    for(auto& c : s->solutionColumns()){
+      for(int i = 0; i < c.second.size(); i++){
+        values.push_back(c.second[i].min());
+      }
     }
-    //outMOSTCSV.open(cfg.settings().output_path+"out/out-MOST.csv");    
-    //outMappingCSV.open(cfg.settings().output_path+"out/out_mapping.csv");
-    LOG_INFO("started searching for " + cfg.get_search_type() + " solutions ");
-    LOG_INFO("Printing frequency: " + cfg.get_out_freq());
-    out << "\n \n*** \n";    
+    return values;
+  }
+  
+  void printSolutionHeader(unsigned long number, long long ms, const Search::Statistics& st) {
+    out << "*** Solution number: " << number << ", after " << ms << " ms" << ", search nodes: " << st.node << ", fail: " << st.fail << ", propagate: "
+        << st.propagate << ", depth: " << st.depth << ", nogoods: " << st.nogood << ", restarts: " << st.restart << " ***\n";
+  }
+  
+  /**
+   * A solution as printSolution() prints it, extracted for the SolutionWriter.
+   */
+  struct SolutionRecord {
+    unsigned long number;
+    long long ms;
+    Search::Statistics stats;
+    typename CPModelTemplate::PrintRecord print; /**< empty if out.txt is not written. */
+    vector<int> columns; /**< values for out/solutions.bin, empty if it is not written. */
+  };
+  
+  /**
+   * Starts the writer thread for printing all solutions of loopSolutions(),
+   * unless output-queue is 0 or the solutions are not printed to out.txt
+   * or out/solutions.bin.
+   */
+  unique_ptr<SolutionWriter<SolutionRecord>> startSolutionWriter() {
+    unique_ptr<SolutionWriter<SolutionRecord>> writer;
+    if(cfg.settings().out_queue > 0 && cfg.settings().out_print_freq == Config::ALL_SOL &&
+       cfg.settings().search != Config::FIRST && (printsText() || outBin)){
+      writer.reset(new SolutionWriter<SolutionRecord>(cfg.settings().out_queue,
+        [this](const SolutionRecord& r){
+          if(printsText()){
+            printSolutionHeader(r.number, r.ms, r.stats);
+            CPModelTemplate::print(r.print, out);
+          }
+          if(writesBin()){
+            appendSolution(r.columns);
+          }
+          LOG_INFO(tools::toString(r.number) +" solution found so far.");
+        },
+        [this](){ out.flush(); }));
+    }
+    return writer;
+  }
+  
+  /**
+   * Creates out/solutions.bin for output-file-type BIN. The value range of
+   * each column is taken from the domains of the root space.
+   */
+  void openSolutionFile() {
+    vector<tools::SolutionColumn> columns{{"solution", 1, 0, INT_MAX, 0}, {"time_ms", 1, 0, INT_MAX, 0}};
+    for(auto& c : model->solutionColumns()){
+      tools::SolutionColumn column{c.first, c.second.size(), 0, 0, 0};
+      for(int i = 0; i < c.second.size(); i++){
+        column.lo = i == 0 ? c.second[i].min() : std::min(column.lo, c.second[i].min());
+        column.hi = i == 0 ? c.second[i].max() : std::max(column.hi, c.second[i].max());
+      }
+      columns.push_back(column);
+    }
+    string path = cfg.settings().output_path+"out/solutions.bin";
+    outBin.reset(new tools::SolutionFileWriter(path, columns, cfg.settings().out_delta));
+    outBinFailed = false;
+    LOG_INFO("Opened file for printing results: " + path);
+  }
+  
+  /** path of the checkpoint file, out/checkpoint.bin */
+  string checkpointPath() const {
+    return cfg.settings().output_path + "out/checkpoint.bin";
+  }
+  
+  /**
+   * Writes the state of the running search to out/checkpoint.bin, unless
+   * another engine thread has just written it (force: write anyway).
+   * @param s statistics of the calling engine
+   */
+  void saveCheckpoint(const Search::Statistics& s, bool force) {
+    lock_guard<mutex> guard(solutionLock);
+    runTimer::time_point now = runTimer::now();
+    if(!force && now.time_since_epoch().count() < nextCheckpoint.load())
+      return;
+    nextCheckpoint = (now + std::chrono::milliseconds(cfg.settings().checkpoint_interval)).time_since_epoch().count();
     
-    std::chrono::high_resolution_clock::duration presolver_delay(0);
-    if((cfg.doPresolve() && cfg.is_presolved()) || cfg.doMultiStep()){
-      if(cfg.doOptimize()){
-        optData = cfg.getPresolverResults()->optResults;
+    Checkpoint c;
+    c.fingerprint = checkpointFingerprint;
+    c.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - t_start).count();
+    c.solutions = nodes;
+    c.timer_resets = timerResets;
+    Search::Statistics total = s;
+    total += resumedStats;
+    c.statistics = vector<int64_t>{(int64_t) total.node, (int64_t) total.fail, (int64_t) total.propagate,
+                                   (int64_t) total.depth, (int64_t) total.restart, (int64_t) total.nogood};
+    c.optData = optData;
+    c.solutionData = solutionData;
+    if(checkpointSol != nullptr){
+      Assignment a = checkpointSol->getAssignment();
+      c.incumbent = vector<vector<int>>{a.proc, a.next, a.sendNext, a.tdmaAlloc, a.proc_mode};
+      c.objectives = a.objectives;
+    }
+    try{
+      c.write(checkpointPath());
+      LOG_DEBUG("Checkpoint written after " + tools::toString(c.elapsed_ms) + " ms.");
+    }catch(IOException& ex){
+      LOG_WARNING("Could not write checkpoint: " + ex.toString());
+    }
+  }
+  
+  /**
+   * Starts writing checkpoints, if dse.checkpoint is set. Called when the
+   * search data (t_start, nodes, ...) is initialized.
+   */
+  void startCheckpoints() {
+    if(cfg.settings().checkpoint_interval > 0){
+      nextCheckpoint = (runTimer::now() + std::chrono::milliseconds(cfg.settings().checkpoint_interval)).time_since_epoch().count();
+    }
+  }
+  
+  /**
+   * Reads out/checkpoint.bin and rebuilds its incumbent on the model. The
+   * no-goods of a restarting engine are internal to the engine, so they are
+   * not restored; the bound of the incumbent prunes the search space that
+   * they excluded for any better solution.
+   */
+  void resume() {
+    if(!cfg.doOptimize() || cfg.settings().search == Config::PARETO || cfg.settings().search == Config::LNS){
+      LOG_WARNING("Resuming is supported by the OPTIMIZE, OPTIMIZE_IT and PORTFOLIO searches only, starting a new search.");
+      return;
+    }
+    if(!resumed.read(checkpointPath())){
+      LOG_WARNING("No checkpoint in " + checkpointPath() + ", starting a new search.");
+      return;
+    }
+    if(resumed.fingerprint != checkpointFingerprint){
+      THROW_EXCEPTION(RuntimeException, "The checkpoint " + checkpointPath() + " was written for different inputs, model or search settings.");
+    }
+    if(resumed.statistics.size() == 6){
+      resumedStats.node = resumed.statistics[0];
+      resumedStats.fail = resumed.statistics[1];
+      resumedStats.propagate = resumed.statistics[2];
+      resumedStats.depth = resumed.statistics[3];
+      resumedStats.restart = resumed.statistics[4];
+      resumedStats.nogood = resumed.statistics[5];
+    }
+    if(resumed.incumbent.size() == 5){
+      Assignment a;
+      a.proc = resumed.incumbent[0];
+      a.next = resumed.incumbent[1];
+      a.sendNext = resumed.incumbent[2];
+      a.tdmaAlloc = resumed.incumbent[3];
+      a.proc_mode = resumed.incumbent[4];
+      a.objectives = resumed.objectives;
+      
+      if(model->status() == SS_FAILED){
+        THROW_EXCEPTION(RuntimeException, "The model has no solution, cannot resume the checkpoint.");
       }
-      if(!cfg.settings().printMetrics.empty()){
-        solutionData = cfg.getPresolverResults()->printResults;
+      CPModelTemplate* fixed = static_cast<CPModelTemplate*>(model->clone());
+      fixed->fixAssignment(a, vector<bool>(a.proc.size(), false), vector<int>(), false);
+      Search::Options options;
+      options.threads = 1;
+      DFS<CPModelTemplate> e(fixed, options);
+      delete fixed;
+      resumedSol = e.next();
+      if(resumedSol == nullptr){
+        THROW_EXCEPTION(RuntimeException, "The incumbent of the checkpoint is no solution of the model.");
+      }
+      bool parallel = cfg.settings().search == Config::PORTFOLIO || 
+                      (cfg.settings().search == Config::OPTIMIZE_IT && cfg.settings().threads != 1);
+      if(!parallel){
+        model->constrain(*resumedSol);
       }
-      presolver_delay = cfg.getPresolverResults()->presolver_delay;
     }
+    resuming = true;
+    LOG_INFO("Resuming the search after " + tools::toString(resumed.elapsed_ms) + " ms and "
+             + tools::toString(resumed.solutions) + " solution(s).");
+  }
+  
+  /**
+   * Continues the counters and the result data of the resumed search. Called
+   * after t_start and the result data are initialized.
+   * @return the incumbent of the checkpoint (owned by the caller), nullptr: none
+   */
+  CPModelTemplate* restoreSearchData() {
+    if(!resuming)
+      return nullptr;
+    nodes = resumed.solutions;
+    timerResets = resumed.timer_resets;
+    optData = resumed.optData;
+    solutionData = resumed.solutionData;
+    t_start -= std::chrono::milliseconds(resumed.elapsed_ms);
+    CPModelTemplate* s = resumedSol;
+    resumedSol = nullptr;
+    return s;
+  }
+  
+  /**
+   * Loops through the solutions and prints them using the input search engine
+   */
+  template<class SearchEngine> void loopSolutions(SearchEngine *e) {
+    nodes = 0;
+    timerResets = 0;
+    infoFreq = 1;
+    
+    std::chrono::high_resolution_clock::duration presolver_delay = openResultFiles();
     
-    CPModelTemplate * prev_sol = nullptr;
     t_start = runTimer::now();
+    CPModelTemplate * prev_sol = restoreSearchData();
+    checkpointSol = prev_sol;
+    tools::PropagatorStats::reset();
+    startMonitor();
+    startCheckpoints();
+    unique_ptr<SolutionWriter<SolutionRecord>> writer = startSolutionWriter();
     while(CPModelTemplate * s = e->next()){
+      unique_lock<mutex> guard(solutionLock);
       nodes++;
+      if(monitor != nullptr && cfg.doOptimize()){
+        monitor->solution(s->getObjectiveValues());
+      }
       if(nodes == 1){
         if(cfg.settings().search == Config::FIRST){
           t_endAll = runTimer::now();
+          finishMonitor();
           printSolution(e, s);
+          printPropagatorStats(std::chrono::duration_cast<std::chrono::milliseconds>(t_endAll - t_start).count());
           return;
         }
         if(cfg.settings().out_print_freq == Config::FIRSTandLAST){
@@ -391,17 +711,23 @@ private:
       }
       //cout << nodes << " solutions found." << endl;
 
-      if(cfg.settings().out_print_freq == Config::ALL_SOL){
+      if(writer){
+        auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t_endAll - t_start).count();
+        writer->push(SolutionRecord{nodes, durAll_ms, e->statistics(),
+                                    printsText() ? s->getPrintRecord() : typename CPModelTemplate::PrintRecord(),
+                                    writesBin() ? solutionColumnValues(nodes, durAll_ms, s) : vector<int>()});
+      }else if(cfg.settings().out_print_freq == Config::ALL_SOL){
           printSolution(e, s);          
       }
      /// We want to keep the last solution in case we only print the last one
       if(prev_sol != nullptr)
         delete prev_sol;
       prev_sol = s;
+      checkpointSol = s;
       
-      if(cfg.settings().out_print_freq == Config::FIRSTandLAST ||
-         cfg.settings().out_print_freq == Config::LAST ||
-         cfg.settings().out_print_freq == Config::ALL_SOL){
+      if(!writer && (cfg.settings().out_print_freq == Config::FIRSTandLAST ||
+                     cfg.settings().out_print_freq == Config::LAST ||
+                     cfg.settings().out_print_freq == Config::ALL_SOL)){
         //if(nodes%infoFreq == 0){
           LOG_INFO(tools::toString(nodes) +" solution found so far.");
           //if(nodes == 10){ 
@@ -412,13 +738,22 @@ private:
         //}
       }
       
-      if(cfg.settings().timeout_all){
-        ((Search::TimeStop*)geSearchOptions.stop)->reset();
-        ((Search::TimeStop*)geSearchOptions.stop)->limit(cfg.settings().timeout_all);
+      if(cfg.settings().timeout_all && timeStop != nullptr){
+        timeStop->reset();
+        timeStop->limit(cfg.settings().timeout_all);
         timerResets++;
       }
 
     }
+    finishMonitor();
+    if(writer){
+      writer->finish();
+      LOG_DEBUG("Solution writer: the search waited for a full queue " + tools::toString(writer->waits()) + " times.");
+    }
+    if(checkpointStop != nullptr){
+      saveCheckpoint(e->statistics(), true);
+    }
+    checkpointSol = nullptr;
 
     auto durAll = runTimer::now() - t_start;
     auto durAll_s = std::chrono::duration_cast<std::chrono::seconds>(durAll).count();
@@ -444,9 +779,99 @@ private:
     if(cfg.settings().timeout_all){
       out << " (with " << timerResets << " incremental timer reset(s).)";
     }
-    out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << e->statistics().node << ", fail: " << e->statistics().fail << ", propagate: "
-        << e->statistics().propagate << ", depth: " << e->statistics().depth << ", nogoods: " << e->statistics().nogood << ", restarts: " << e->statistics().restart << " ***\n";
+    Search::Statistics total = e->statistics();
+    total += resumedStats;
+    out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << total.node << ", fail: " << total.fail << ", propagate: "
+        << total.propagate << ", depth: " << total.depth << ", nogoods: " << total.nogood << ", restarts: " << total.restart << " ***\n";
+    if(resuming){
+      out << "  resumed from a checkpoint after " << resumed.elapsed_ms << " ms, " << resumed.solutions << " solution(s)\n";
+    }
+    printPropagatorStats(durAll_ms);
 
+    closeResultFiles();
+  }
+  
+  /**
+   * Opens the result files and loads the solutions of the presolver.
+   * @return the time spent in the presolver
+   */
+  std::chrono::high_resolution_clock::duration openResultFiles() {
+    out.open(cfg.settings().output_path+"out/out.txt");
+    LOG_INFO("Opened file for printing results: " +cfg.settings().output_path+"out/out.txt");
+    if(cfg.doOptimize()){
+      outCSV_opt.open(cfg.settings().output_path+"out/out_opt.csv");
+    }
+    if(!cfg.settings().printMetrics.empty()){
+      outCSV.open(cfg.settings().output_path+"out/out.csv");
+    }
+    if(cfg.settings().out_file_type == Config::BIN){
+      openSolutionFile();
+    }
+    //outMOSTCSV.open(cfg.settings().output_path+"out/out-MOST.csv");    
+    //outMappingCSV.open(cfg.settings().output_path+"out/out_mapping.csv");
+    if(cfg.settings().profile_model){
+      model->getProfile().print(out);
+      ofstream outProfile(cfg.settings().output_path+"out/model_profile.csv");
+      model->getProfile().printCSV(outProfile);
+      LOG_INFO("Printed model construction profile to " + cfg.settings().output_path+"out/model_profile.csv");
+    }
+    LOG_INFO("started searching for " + cfg.get_search_type() + " solutions ");
+    LOG_INFO("Printing frequency: " + cfg.get_out_freq());
+    out << "\n \n*** \n";    
+    
+    std::chrono::high_resolution_clock::duration presolver_delay(0);
+    if((cfg.doPresolve() && cfg.is_presolved()) || cfg.doMultiStep()){
+      if(cfg.doOptimize()){
+        optData = cfg.getPresolverResults()->optResults;
+      }
+      if(!cfg.settings().printMetrics.empty()){
+        solutionData = cfg.getPresolverResults()->printResults;
+      }
+      presolver_delay = cfg.getPresolverResults()->presolver_delay;
+    }
+    return presolver_delay;
+  }
+  
+  /**
+   * Prints the CPU time of the throughput and schedulability propagators.
+   */
+  void printPropagatorStats(double search_ms) {
+    tools::PropagatorStats::print(out, search_ms);
+    for(auto& s : tools::PropagatorStats::summary()){
+      LOG_INFO(s.name + ": " + tools::toString(s.calls) + " calls, " + tools::toString(s.failures) + " failures, "
+               + tools::toString(s.total_ms) + " ms (" + tools::toString(search_ms > 0 ? 100 * s.total_ms / search_ms : 0)
+               + "% of the search time)" + (s.steps > 0 ? ", " + tools::toString(s.steps) + " steps" : ""));
+    }
+  }
+  
+  /**
+   * Starts sampling the search statistics (if enabled).
+   */
+  void startMonitor() {
+    if(monitor != nullptr){
+      monitor->start();
+      LOG_INFO("Sampling search telemetry every " + tools::toString(cfg.settings().telemetry_interval)
+               + " ms to " + cfg.settings().output_path+"out/telemetry.csv");
+    }
+  }
+  
+  /**
+   * Stops sampling the search statistics and reports the time spent on it.
+   */
+  void finishMonitor() {
+    if(monitor != nullptr){
+      monitor->finish();
+      double search_ms = std::chrono::duration_cast<std::chrono::microseconds>(runTimer::now() - t_start).count() / 1000.0;
+      LOG_INFO("Search telemetry: " + tools::toString(monitor->samples()) + " samples, overhead "
+               + tools::toString(monitor->overhead()) + " ms ("
+               + tools::toString(search_ms > 0 ? 100 * monitor->overhead() / search_ms : 0) + "% of the search time)");
+    }
+  }
+  
+  /**
+   * Writes the collected solution data and closes the result files.
+   */
+  void closeResultFiles() {
     if(cfg.doOptimize()){
       for(auto i: optData){
         outCSV_opt << std::chrono::duration_cast<std::chrono::milliseconds>(i.time).count() << " ";
@@ -473,35 +898,804 @@ private:
     if(!cfg.settings().printMetrics.empty()){
       outCSV.close();
     }
+    if(outBin){
+      try{
+        outBin->close();
+      }catch(IOException& ex){
+        LOG_ERROR("Could not close out/solutions.bin: " + ex.toString());
+      }
+      outBin.reset();
+    }
     //outMOSTCSV.close();
     //outMappingCSV.close();
   }
   
-  template<class SearchEngine> bool findMinimalTDNConfig(SearchEngine *e) {
-    bool solFound = false;
-    if(CPModelTemplate * s = e->next()){ //"if" because one solution is sufficient
+  /**
+   * Statistics of a search engine at the time a solution was found,
+   * used for printing solutions of the parallel workers.
+   */
+  struct EngineSnapshot {
+    Search::Statistics stats;
+    const Search::Statistics& statistics() const { return stats; }
+  };
+  
+  /**
+   * Stops a parallel worker when another worker has completed its search,
+   * or when the time-out shared by all workers has passed.
+   */
+  class ParallelStop : public Search::Stop {
+  public:
+    ParallelStop(const atomic<bool>& _done, const atomic<long long>& _deadline) :
+        done(_done), deadline(_deadline) {}
+    virtual bool stop(const Search::Statistics& s, const Search::Options& o) {
+      long long d = deadline.load();
+      return done.load() || (d > 0 && runTimer::now().time_since_epoch().count() > d);
+    }
+  private:
+    const atomic<bool>& done; /**< set when a worker has completed its search (optimum found). */
+    const atomic<long long>& deadline; /**< time-out as runTimer ticks, 0: none. */
+  };
+  
+  /**
+   * Number of parallel workers: dse.threads, 0 means all processors.
+   */
+  unsigned int parallelWorkers() {
+    if(cfg.settings().criteria.empty() || cfg.settings().criteria[0] == Config::NONE){
+      THROW_EXCEPTION(RuntimeException, "parallel optimization requires an optimization criterion (dse.criteria).");
+    }
+    //checked here, as the workers would terminate the program on an exception
+    size_t n_objectives = model->objectives().size();
+    if(n_objectives == 0){
+      THROW_EXCEPTION(RuntimeException, "parallel optimization requires an objective, but every criterion is "
+                                        "fixed by the constraints (e.g. THROUGHPUT with all periods constrained).");
+    }
+    if(n_objectives > 2 && cfg.settings().search != Config::PARETO && cfg.settings().search != Config::LNS){
+      THROW_EXCEPTION(RuntimeException, "the workers share the incumbent of at most two objectives, but there are "
+                                        + tools::toString(n_objectives) + ".");
+    }
+    unsigned int n_workers = cfg.settings().threads;
+    if(n_workers == 0)
+      n_workers = std::thread::hardware_concurrency();
+    if(n_workers == 0)
+      n_workers = 1;
+    return n_workers;
+  }
+  
+  /**
+   * Runs dse.threads BAB engines in parallel, each on its own model with
+   * a different random seed, AFC decay and throughput propagator.
+   */
+  void portfolioSearch(Mapping* map) {
+    unsigned int n_workers = parallelWorkers();
+    //variants: the propagators alternate, seed and AFC decay differ per worker
+    const double afcDecays[] = {0.99, 0.95, 0.9, 0.8};
+    Config::ThroughputPropagator other_prop = cfg.settings().th_prop == Config::SSE ? Config::MCR : Config::SSE;
+    vector<SearchVariant> variants(n_workers);
+    for(unsigned int w = 0; w < n_workers; w++){
+      variants[w].seed = w + 1;
+      variants[w].afc_decay = afcDecays[(w / 2) % 4];
+      variants[w].th_prop = w % 2 == 0 ? cfg.settings().th_prop : other_prop;
+    }
+    parallelSearch<BAB<CPModelTemplate>>(map, variants);
+  }
+  
+  /**
+   * Runs dse.threads restart-based BAB engines (Luby cutoff, no-goods as
+   * for OPTIMIZE_IT) in parallel, which differ only in the random seed.
+   * Each engine restarts on its own, but always from the best solution of
+   * all workers.
+   */
+  void parallelRestartSearch(Mapping* map) {
+    unsigned int n_workers = parallelWorkers();
+    vector<SearchVariant> variants(n_workers);
+    for(unsigned int w = 0; w < n_workers; w++){
+      variants[w].seed = w + 1;
+      variants[w].afc_decay = 0.99;
+      variants[w].th_prop = cfg.settings().th_prop;
+    }
+    parallelSearch<RBS<CPModelTemplate, BAB>>(map, variants);
+  }
+  
+  /**
+   * Runs one search engine per variant in parallel, each in its own thread
+   * and on its own model. The models share the best solution found so far
+   * (Incumbent), so that a solution found by one worker prunes the search
+   * of all others. Only solutions that improve on the shared incumbent
+   * are reported.
+   */
+  template<class SearchEngine> void parallelSearch(Mapping* map, vector<SearchVariant>& variants) {
+    unsigned int n_workers = variants.size();
+    Incumbent incumbent;
+    vector<CPModelTemplate*> models(n_workers);
+    for(unsigned int w = 0; w < n_workers; w++){
+      variants[w].incumbent = &incumbent;
+      LOG_INFO("Creating worker " + tools::toString(w) + ": " 
+               + (variants[w].th_prop == Config::SSE ? "SSE" : "MCR") + " propagator, AFC decay "
+               + tools::toString(variants[w].afc_decay) + ", seed " + tools::toString(variants[w].seed));
+      models[w] = new CPModelTemplate(map, &cfg, &variants[w]);
+    }
+    
+    nodes = 0;
+    timerResets = 0;
+    std::chrono::high_resolution_clock::duration presolver_delay = openResultFiles();
+    
+    EngineSnapshot prev_snapshot;
+    atomic<bool> done(false);
+    atomic<long long> deadline(0);
+    vector<Search::Statistics> statistics(n_workers);
+    
+    t_start = runTimer::now();
+    if(cfg.settings().timeout_first > 0){
+      deadline = (t_start + std::chrono::milliseconds(cfg.settings().timeout_first)).time_since_epoch().count();
+    }
+    CPModelTemplate* prev_sol = restoreSearchData();
+    if(prev_sol != nullptr){
+      incumbent.offer(prev_sol->getObjectiveValues());
+    }
+    checkpointSol = prev_sol;
+    
+    auto worker = [&](unsigned int w){
+      ParallelStop stop(done, deadline);
+      Search::Options options;
+      options.threads = 1;
+      options.stop = &stop;
+      unique_ptr<SearchMonitor::Stop> monitorStop;
+      if(monitor != nullptr){
+        monitorStop.reset(new SearchMonitor::Stop(*monitor, &stop));
+        options.stop = monitorStop.get();
+      }
+      unique_ptr<CheckpointStop> workerCheckpointStop;
+      if(cfg.settings().checkpoint_interval > 0){
+        workerCheckpointStop.reset(new CheckpointStop(*this, options.stop));
+        options.stop = workerCheckpointStop.get();
+      }
+      if(cfg.settings().search == Config::OPTIMIZE_IT){
+        options.cutoff = Search::Cutoff::luby(cfg.settings().luby_scale);
+        options.nogoods_limit = cfg.settings().noGoodDepth;
+      }
+      SearchEngine e(models[w], options);
+      delete models[w];
+      while(CPModelTemplate * s = e.next()){
+        EngineSnapshot snapshot{e.statistics()};
+        lock_guard<mutex> guard(solutionLock);
+        if(!incumbent.offer(s->getObjectiveValues())){ //another worker was faster
+          delete s;
+          continue;
+        }
+        nodes++;
+        t_endAll = runTimer::now();
+        if(monitor != nullptr){
+          monitor->solution(s->getObjectiveValues());
+        }
+        if(nodes == 1 && cfg.settings().out_print_freq == Config::FIRSTandLAST){
+          printSolution(&snapshot, s);
+        }
+        optData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getOptimizationValues()});
+        if(!cfg.settings().printMetrics.empty()){
+          solutionData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getPrintMetrics()});
+        }
+        if(cfg.settings().out_print_freq == Config::ALL_SOL){
+          printSolution(&snapshot, s);
+        }
+        if(prev_sol != nullptr)
+          delete prev_sol;
+        prev_sol = s;
+        checkpointSol = s;
+        prev_snapshot = snapshot;
+        LOG_INFO(tools::toString(nodes) + " solution found so far (by worker " + tools::toString(w) + ").");
+        
+        if(cfg.settings().timeout_all){
+          deadline = (runTimer::now() + std::chrono::milliseconds(cfg.settings().timeout_all)).time_since_epoch().count();
+          timerResets++;
+        }
+      }
+      if(!e.stopped()){ //the search space of this worker is exhausted: the incumbent is optimal
+        done = true;
+      }
+      statistics[w] = e.statistics();
+    };
+    
+    tools::PropagatorStats::reset();
+    startMonitor();
+    startCheckpoints();
+    vector<thread> threads;
+    for(unsigned int w = 0; w < n_workers; w++){
+      threads.push_back(thread(worker, w));
+    }
+    for(auto& t : threads){
+      t.join();
+    }
+    finishMonitor();
+    
+    Search::Statistics total;
+    for(auto& st : statistics){
+      total += st;
+    }
+    if(cfg.settings().checkpoint_interval > 0){
+      saveCheckpoint(total, true);
+    }
+    checkpointSol = nullptr;
+    total += resumedStats;
+    
+    auto durAll = runTimer::now() - t_start;
+    auto durAll_s = std::chrono::duration_cast<std::chrono::seconds>(durAll).count();
+    auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
+    
+    if(cfg.settings().out_print_freq == Config::LAST && nodes > 0){
+      printSolution(&prev_snapshot, prev_sol);
+    }else if(cfg.settings().out_print_freq == Config::LAST && nodes == 0){
+      out << "No (better) solution found." << endl;
+    }
+    if(cfg.settings().out_print_freq == Config::FIRSTandLAST && nodes > 1){
+      printSolution(&prev_snapshot, prev_sol);
+    }else if(cfg.settings().out_print_freq == Config::FIRSTandLAST && nodes == 1){
+      out << "No better solution found." << endl;
+    }
+    delete prev_sol;
+    
+    out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms)";
+    if(!done){
+      out << " due to time-out!";
+    }
+    if(cfg.settings().timeout_all){
+      out << " (with " << timerResets << " incremental timer reset(s).)";
+    }
+    out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << total.node << ", fail: " << total.fail << ", propagate: "
+        << total.propagate << ", depth: " << total.depth << ", nogoods: " << total.nogood << ", restarts: " << total.restart << " ***\n";
+    for(unsigned int w = 0; w < n_workers; w++){
+      out << "  worker " << w << " (" << (variants[w].th_prop == Config::SSE ? "SSE" : "MCR") << ", AFC decay " << variants[w].afc_decay
+          << ", seed " << variants[w].seed << "): search nodes: " << statistics[w].node << ", fail: " << statistics[w].fail
+          << ", propagate: " << statistics[w].propagate << ", depth: " << statistics[w].depth << ", nogoods: " << statistics[w].nogood
+          << ", restarts: " << statistics[w].restart << "\n";
+    }
+    if(resuming){
+      out << "  resumed from a checkpoint after " << resumed.elapsed_ms << " ms, " << resumed.solutions << " solution(s)\n";
+    }
+    printPropagatorStats(durAll_ms);
+    
+    closeResultFiles();
+  }
+  
+  /**
+   * Searches the Pareto front of all optimization criteria on dse.threads
+   * BAB workers with different random seeds. The workers share an archive
+   * of the non-dominated solutions found so far, and each solution must
+   * not be dominated by any of them. A worker that exhausts its search
+   * space has proven the archive to be the complete front. The front is
+   * written once at the end, to out.txt and out/pareto_front.csv.
+   */
+  void paretoSearch(Mapping* map) {
+    unsigned int n_workers = parallelWorkers();
+    ParetoArchive archive;
+    vector<SearchVariant> variants(n_workers);
+    vector<CPModelTemplate*> models(n_workers);
+    for(unsigned int w = 0; w < n_workers; w++){
+      variants[w].seed = w + 1;
+      variants[w].afc_decay = 0.99;
+      variants[w].th_prop = cfg.settings().th_prop;
+      variants[w].archive = &archive;
+      models[w] = new CPModelTemplate(map, &cfg, &variants[w]);
+    }
+    LOG_INFO("Searching the Pareto front of " + tools::toString(models[0]->objectives().size()) + " objectives on "
+             + tools::toString(n_workers) + " worker(s)");
+    
+    nodes = 0;
+    timerResets = 0;
+    std::chrono::high_resolution_clock::duration presolver_delay = openResultFiles();
+    
+    struct FrontSolution {
+      CPModelTemplate* solution;
+      EngineSnapshot snapshot;
+      runTimer::time_point found;
+    };
+    std::map<size_t, FrontSolution> front; //by archive id
+    atomic<bool> done(false);
+    atomic<long long> deadline(0);
+    vector<Search::Statistics> statistics(n_workers);
+    
+    t_start = runTimer::now();
+    if(cfg.settings().timeout_first > 0){
+      deadline = (t_start + std::chrono::milliseconds(cfg.settings().timeout_first)).time_since_epoch().count();
+    }
+    
+    auto worker = [&](unsigned int w){
+      ParallelStop stop(done, deadline);
+      Search::Options options;
+      options.threads = 1;
+      options.stop = &stop;
+      unique_ptr<SearchMonitor::Stop> monitorStop;
+      if(monitor != nullptr){
+        monitorStop.reset(new SearchMonitor::Stop(*monitor, &stop));
+        options.stop = monitorStop.get();
+      }
+      BAB<CPModelTemplate> e(models[w], options);
+      delete models[w];
+      while(CPModelTemplate * s = e.next()){
+        EngineSnapshot snapshot{e.statistics()};
+        vector<int> values = s->getObjectiveValues();
+        vector<size_t> removed;
+        lock_guard<mutex> guard(solutionLock);
+        if(!archive.insert(values, nodes + 1, removed)){ //dominated by a solution of another worker
+          delete s;
+          continue;
+        }
+        nodes++;
+        t_endAll = runTimer::now();
+        for(size_t id : removed){
+          delete front[id].solution;
+          front.erase(id);
+        }
+        front[nodes] = FrontSolution{s, snapshot, t_endAll};
+        if(monitor != nullptr){
+          monitor->solution(values);
+        }
+        optData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getOptimizationValues()});
+        if(!cfg.settings().printMetrics.empty()){
+          solutionData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getPrintMetrics()});
+        }
+        LOG_INFO(tools::toString(nodes) + " solution found so far, " + tools::toString(front.size())
+                 + " on the front (by worker " + tools::toString(w) + ").");
+        
+        if(cfg.settings().timeout_all){
+          deadline = (runTimer::now() + std::chrono::milliseconds(cfg.settings().timeout_all)).time_since_epoch().count();
+          timerResets++;
+        }
+      }
+      if(!e.stopped()){ //nothing outside the front is left in the search space of this worker
+        done = true;
+      }
+      statistics[w] = e.statistics();
+    };
+    
+    tools::PropagatorStats::reset();
+    startMonitor();
+    vector<thread> threads;
+    for(unsigned int w = 0; w < n_workers; w++){
+      threads.push_back(thread(worker, w));
+    }
+    for(auto& t : threads){
+      t.join();
+    }
+    finishMonitor();
+    
+    auto durAll = runTimer::now() - t_start;
+    auto durAll_s = std::chrono::duration_cast<std::chrono::seconds>(durAll).count();
+    auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
+    
+    //the front, ordered by the first objective
+    size_t n_solutions = nodes;
+    shared_ptr<const ParetoArchive::Front> points = archive.front();
+    ofstream outFront(cfg.settings().output_path+"out/pareto_front.csv");
+    CPModelTemplate* any = points->empty() ? nullptr : front[points->front().id].solution;
+    outFront << "solution,time_ms";
+    if(any != nullptr){
+      for(auto& name : any->objectiveNames()){
+        outFront << "," << name;
+      }
+    }
+    outFront << endl;
+    out << "\n#####\nPareto front: " << points->size() << " solution(s)" << (done ? "" : " (incomplete, time-out)") << "\n";
+    for(auto& p : *points){
+      FrontSolution& f = front[p.id];
+      nodes = p.id;
+      t_endAll = f.found;
+      outFront << p.id << "," << std::chrono::duration_cast<std::chrono::milliseconds>(f.found - t_start).count();
+      for(int v : p.values){
+        outFront << "," << v;
+      }
+      outFront << endl;
+      printSolution(&f.snapshot, f.solution);
+    }
+    outFront.close();
+    for(auto& f : front){
+      delete f.second.solution;
+    }
+    LOG_INFO("Printed the Pareto front to " + cfg.settings().output_path+"out/pareto_front.csv");
+    
+    Search::Statistics total;
+    for(auto& st : statistics){
+      total += st;
+    }
+    out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms)";
+    if(!done){
+      out << " due to time-out!";
+    }
+    if(cfg.settings().timeout_all){
+      out << " (with " << timerResets << " incremental timer reset(s).)";
+    }
+    out << " =====\n" << n_solutions << " solutions found, " << points->size() << " on the front\n" << "search nodes: " << total.node
+        << ", fail: " << total.fail << ", propagate: " << total.propagate << ", depth: " << total.depth << ", nogoods: " << total.nogood
+        << ", restarts: " << total.restart << " ***\n";
+    printPropagatorStats(durAll_ms);
+    
+    closeResultFiles();
+  }
+  
+  typedef typename CPModelTemplate::Assignment Assignment;
+  
+  /**
+   * Stops the search in one LNS neighbourhood after dse.lns_fails failures,
+   * or when the LNS search as a whole stops.
+   */
+  class LNSStop : public Search::Stop {
+  public:
+    LNSStop(Search::Stop& _global, unsigned long int _fails) : global(_global), fails(_fails) {}
+    virtual bool stop(const Search::Statistics& s, const Search::Options& o) {
+      return s.fail > fails || global.stop(s, o);
+    }
+  private:
+    Search::Stop& global;
+    unsigned long int fails;
+  };
+  
+  /**
+   * Kinds of LNS neighbourhoods: the entities on a group of neighbouring
+   * processors, or the entities of one application.
+   */
+  enum LNSNeighbourhood { LNS_LOCALITY, LNS_APPLICATION, LNS_KINDS };
+  
+  /**
+   * Chooses about size program entities to relax around a seed entity.
+   * The seed is an actor on a critical cycle of a (if known) in three of
+   * four cases, a random entity otherwise.
+   * @param extraProcs set to the processors without relaxed entities that
+   *        the relaxed entities may move to
+   */
+  vector<bool> chooseNeighbourhood(Mapping* map, const Assignment& a, LNSNeighbourhood kind, size_t size,
+                                   std::mt19937& rnd, vector<int>& extraProcs) {
+    Applications* apps = map->getApplications();
+    Platform* platform = map->getPlatform();
+    size_t n = apps->n_programEntities();
+    size_t n_procs = platform->nodes();
+    extraProcs.clear();
+    if(size >= n){ //the whole problem
+      for(size_t j = 0; j < n_procs; j++) extraProcs.push_back(j);
+      return vector<bool>(n, true);
+    }
+    
+    vector<bool> relaxed(n, false);
+    size_t n_relaxed = 0;
+    auto relax = [&](size_t i){
+      if(!relaxed[i]){
+        relaxed[i] = true;
+        n_relaxed++;
+      }
+    };
+    size_t seed = !a.critical.empty() && rnd() % 4 != 0 ? a.critical[rnd() % a.critical.size()] : rnd() % n;
+    
+    if(kind == LNS_LOCALITY){
+      //whole processors, in breadth-first order through the NoC from the processor of the seed
+      vector<bool> visited(n_procs, false);
+      deque<size_t> queue(1, a.proc[seed]);
+      visited[a.proc[seed]] = true;
+      while(n_relaxed < size){
+        if(queue.empty()){ //on a bus, or the rest of the NoC is unreachable: continue at a random processor
+          size_t j = rnd() % n_procs;
+          while(visited[j]) j = (j + 1) % n_procs;
+          visited[j] = true;
+          queue.push_back(j);
+        }
+        size_t j = queue.front();
+        queue.pop_front();
+        bool empty = true;
+        for(size_t i = 0; i < n; i++){
+          if(a.proc[i] == (int) j){
+            relax(i);
+            empty = false;
+          }
+        }
+        if(empty) extraProcs.push_back(j);
+        if(platform->getInterconnectType() == TDN_NOC){
+          for(auto& nb : platform->getNeighborNodes(j)){
+            if(!visited[nb.node_id]){
+              visited[nb.node_id] = true;
+              queue.push_back(nb.node_id);
+            }
+          }
+        }
+      }
+    }else{
+      //the entities of the application of the seed (IPT tasks count as one application), then random ones
+      auto appOf = [&](size_t i){ return apps->isIPT(i) ? apps->n_SDFApps() : apps->getSDFGraph(i); };
+      vector<size_t> members;
+      for(size_t i = 0; i < n; i++){
+        if(appOf(i) == appOf(seed)) members.push_back(i);
+      }
+      std::shuffle(members.begin(), members.end(), rnd);
+      relax(seed);
+      for(size_t i : members){
+        if(n_relaxed >= size) break;
+        relax(i);
+      }
+      while(n_relaxed < size){
+        relax(rnd() % n);
+      }
+      extraProcs.push_back(rnd() % n_procs);
+    }
+    return relaxed;
+  }
+  
+  /**
+   * Large neighbourhood search: after a first solution, dse.threads workers
+   * repeatedly fix the decisions of the best solution outside a neighbourhood
+   * (see fixAssignment) and search the neighbourhood for an improvement with
+   * BAB, up to dse.lns_fails failures. The neighbourhood size adapts per
+   * worker: it grows when a neighbourhood is exhausted without improvement
+   * and shrinks when the fail limit is hit. The solutions are recorded as by
+   * the other engines, so out_opt.csv gives the quality over time.
+   */
+  void lnsSearch(Mapping* map) {
+    unsigned int n_workers = parallelWorkers();
+    size_t n_entities = map->getApplications()->n_programEntities();
+    vector<SearchVariant> variants(n_workers);
+    vector<CPModelTemplate*> roots(n_workers);
+    bool failed = false;
+    for(unsigned int w = 0; w < n_workers; w++){
+      variants[w].seed = w + 1;
+      variants[w].afc_decay = 0.99;
+      variants[w].th_prop = cfg.settings().th_prop;
+      roots[w] = new CPModelTemplate(map, &cfg, &variants[w]);
+      if(roots[w]->status() == SS_FAILED) //the neighbourhoods are cloned from the propagated root
+        failed = true;
+    }
+    
+    nodes = 0;
+    timerResets = 0;
+    std::chrono::high_resolution_clock::duration presolver_delay = openResultFiles();
+    
+    Assignment best;
+    CPModelTemplate* prev_sol = nullptr;
+    EngineSnapshot prev_snapshot;
+    atomic<bool> done(failed);
+    atomic<long long> deadline(0);
+    vector<Search::Statistics> statistics(n_workers);
+    vector<vector<unsigned long>> tried(n_workers, vector<unsigned long>(LNS_KINDS, 0));
+    vector<vector<unsigned long>> improved(n_workers, vector<unsigned long>(LNS_KINDS, 0));
+    vector<size_t> sizes(n_workers, 0);
+    
+    t_start = runTimer::now();
+    if(cfg.settings().timeout_first > 0){
+      deadline = (t_start + std::chrono::milliseconds(cfg.settings().timeout_first)).time_since_epoch().count();
+    }
+    
+    //records s if it improves on the best solution of all workers
+    auto offer = [&](CPModelTemplate* s, const EngineSnapshot& snapshot, unsigned int w) -> bool {
+      Assignment a = s->getAssignment(); //in the thread that found s
+      lock_guard<mutex> guard(solutionLock);
+      if(nodes > 0 && !(a.objectives < best.objectives)){ //another worker was faster
+        delete s;
+        return false;
+      }
+      best = a;
+      nodes++;
       t_endAll = runTimer::now();
-      printSolution(e, s);
-      solFound = true;
-      delete s;
+      if(monitor != nullptr){
+        monitor->solution(a.objectives);
+      }
+      if(nodes == 1 && cfg.settings().out_print_freq == Config::FIRSTandLAST){
+        printSolution(&snapshot, s);
+      }
+      optData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getOptimizationValues()});
+      if(!cfg.settings().printMetrics.empty()){
+        solutionData.push_back(Config::SolutionValues{t_endAll-t_start+presolver_delay, s->getPrintMetrics()});
+      }
+      if(cfg.settings().out_print_freq == Config::ALL_SOL){
+        printSolution(&snapshot, s);
+      }
+      if(prev_sol != nullptr)
+        delete prev_sol;
+      prev_sol = s;
+      prev_snapshot = snapshot;
+      LOG_INFO(tools::toString(nodes) + " solution found so far (by worker " + tools::toString(w) + ").");
+      
+      if(cfg.settings().timeout_all){
+        deadline = (runTimer::now() + std::chrono::milliseconds(cfg.settings().timeout_all)).time_since_epoch().count();
+        timerResets++;
+      }
+      return true;
+    };
+    
+    auto worker = [&](unsigned int w){
+      std::mt19937 rnd(w + 1);
+      size_t size = min(n_entities, max<size_t>(2, n_entities / 10));
+      ParallelStop global(done, deadline);
+      LNSStop stop(global, cfg.settings().lns_fails);
+      Search::Options options;
+      options.threads = 1;
+      options.stop = &stop;
+      unique_ptr<SearchMonitor::Stop> monitorStop;
+      if(monitor != nullptr){
+        monitorStop.reset(new SearchMonitor::Stop(*monitor, &stop));
+        options.stop = monitorStop.get();
+      }
+      Search::Statistics none;
+      while(!global.stop(none, options)){
+        Assignment a;
+        {
+          lock_guard<mutex> guard(solutionLock);
+          a = best;
+        }
+        LNSNeighbourhood kind = (LNSNeighbourhood) (rnd() % LNS_KINDS);
+        vector<int> extraProcs;
+        vector<bool> relaxed = chooseNeighbourhood(map, a, kind, size, rnd, extraProcs);
+        CPModelTemplate* neighbourhood = static_cast<CPModelTemplate*>(roots[w]->clone());
+        neighbourhood->fixAssignment(a, relaxed, extraProcs);
+        tried[w][kind]++;
+        
+        BAB<CPModelTemplate> e(neighbourhood, options);
+        delete neighbourhood;
+        bool better = false;
+        while(CPModelTemplate * s = e.next()){
+          better = offer(s, EngineSnapshot{e.statistics()}, w) || better;
+        }
+        statistics[w] += e.statistics();
+        if(better){
+          improved[w][kind]++;
+        }else if(!e.stopped()){ //no improvement in the neighbourhood: make it larger
+          if(size >= n_entities){ //the whole problem: the best solution is optimal
+            done = true;
+          }
+          size = min(n_entities, size + size / 5 + 1);
+        }else if(!global.stop(none, options)){ //fail limit: make it smaller
+          size = max<size_t>(2, size - size / 10 - 1);
+        }
+      }
+      sizes[w] = size;
+    };
+    
+    tools::PropagatorStats::reset();
+    startMonitor();
+    if(!failed){ //first solution
+      LOG_INFO("LNS: searching a first solution");
+      ParallelStop stop(done, deadline);
+      Search::Options options;
+      options.threads = 1;
+      options.stop = &stop;
+      DFS<CPModelTemplate> e(roots[0], options);
+      if(CPModelTemplate * s = e.next()){
+        offer(s, EngineSnapshot{e.statistics()}, 0);
+      }else if(!e.stopped()){ //no solution at all
+        done = true;
+      }
+      statistics[0] += e.statistics();
+    }
+    if(nodes > 0){
+      LOG_INFO("LNS: improving on " + tools::toString(n_workers) + " worker(s)");
+      vector<thread> threads;
+      for(unsigned int w = 0; w < n_workers; w++){
+        threads.push_back(thread(worker, w));
+      }
+      for(auto& t : threads){
+        t.join();
+      }
     }
+    finishMonitor();
+    for(auto r : roots){
+      delete r;
+    }
+    
     auto durAll = runTimer::now() - t_start;
     auto durAll_s = std::chrono::duration_cast<std::chrono::seconds>(durAll).count();
     auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
     
+    if(cfg.settings().out_print_freq == Config::LAST && nodes > 0){
+      printSolution(&prev_snapshot, prev_sol);
+    }else if(cfg.settings().out_print_freq == Config::LAST && nodes == 0){
+      out << "No (better) solution found." << endl;
+    }
+    if(cfg.settings().out_print_freq == Config::FIRSTandLAST && nodes > 1){
+      printSolution(&prev_snapshot, prev_sol);
+    }else if(cfg.settings().out_print_freq == Config::FIRSTandLAST && nodes == 1){
+      out << "No better solution found." << endl;
+    }
+    delete prev_sol;
+    
+    Search::Statistics total;
+    for(auto& st : statistics){
+      total += st;
+    }
     out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms)";
-    if(e->stopped()){
+    if(!done){
       out << " due to time-out!";
     }
-    nodes = solFound ? 1 : 0;
-    out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << e->statistics().node << ", fail: " << e->statistics().fail << ", propagate: "
-        << e->statistics().propagate << ", depth: " << e->statistics().depth << ", nogoods: " << e->statistics().nogood << ", restarts: " << e->statistics().restart << " ***\n\n";
-    //delete e;
-    return solFound;
+    if(cfg.settings().timeout_all){
+      out << " (with " << timerResets << " incremental timer reset(s).)";
+    }
+    out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << total.node << ", fail: " << total.fail << ", propagate: "
+        << total.propagate << ", depth: " << total.depth << ", nogoods: " << total.nogood << ", restarts: " << total.restart << " ***\n";
+    const char* kinds[] = {"locality", "application"};
+    for(unsigned int w = 0; w < n_workers; w++){
+      out << "  worker " << w << ": neighbourhood size " << sizes[w] << " of " << n_entities;
+      for(int k = 0; k < LNS_KINDS; k++){
+        out << ", " << kinds[k] << ": " << improved[w][k] << "/" << tried[w][k] << " improved";
+      }
+      out << ", search nodes: " << statistics[w].node << ", fail: " << statistics[w].fail << "\n";
+    }
+    printPropagatorStats(durAll_ms);
+    
+    closeResultFiles();
   }
   
   /**
-   * Loops through the solutions and prints them using the input search engine
+   * Search for a solution with a given number of TDN slots.
+   */
+  struct TDNProbe {
+    enum Result { FEASIBLE, INFEASIBLE, TIMEOUT, CANCELLED };
+    size_t slots;
+    CPModelTemplate* model;
+    atomic<bool> cancel; /**< set when a probe with fewer slots has found a solution. */
+    Result result;
+    CPModelTemplate* solution;
+    EngineSnapshot snapshot;
+    runTimer::duration time;
+  };
+
+  /**
+   * Runs a probe until the first solution, the end of its search space, its
+   * time-out (timeout_first, per probe) or its cancellation.
+   */
+  template<class SearchEngine> void searchTDNProbe(TDNProbe& p) {
+    atomic<long long> deadline(0);
+    auto start = runTimer::now();
+    if(cfg.settings().timeout_first > 0){
+      deadline = (start + std::chrono::milliseconds(cfg.settings().timeout_first)).time_since_epoch().count();
+    }
+    ParallelStop stop(p.cancel, deadline);
+    Search::Options options;
+    options.threads = 1;
+    options.stop = &stop;
+    if(cfg.settings().search == Config::OPTIMIZE_IT){
+      options.cutoff = Search::Cutoff::luby(cfg.settings().luby_scale);
+      options.nogoods_limit = cfg.settings().noGoodDepth;
+    }
+    SearchEngine e(p.model, options);
+    delete p.model;
+    p.model = nullptr;
+    p.solution = e.next(); //one solution is sufficient
+    p.snapshot = EngineSnapshot{e.statistics()};
+    p.time = runTimer::now() - start;
+    if(p.solution != nullptr){
+      p.result = TDNProbe::FEASIBLE;
+    }else if(!e.stopped()){
+      p.result = TDNProbe::INFEASIBLE;
+    }else{
+      p.result = p.cancel ? TDNProbe::CANCELLED : TDNProbe::TIMEOUT;
+    }
+  }
+
+  void runTDNProbe(TDNProbe& p) {
+    switch (cfg.settings().search) {
+      case (Config::FIRST):
+      case (Config::ALL):
+        searchTDNProbe<DFS<CPModelTemplate>>(p);
+        break;
+      case (Config::OPTIMIZE):
+        searchTDNProbe<BAB<CPModelTemplate>>(p);
+        break;
+      case (Config::OPTIMIZE_IT):
+        searchTDNProbe<RBS<CPModelTemplate, BAB>>(p);
+        break;
+      default:
+        THROW_EXCEPTION(RuntimeException, "unknown search type for main solver.");
+        break;
+    }
+  }
+
+  /**
+   * Searches for the smallest number of TDN slots with a solution. The
+   * number of slots is first increased exponentially from the number of
+   * processors (n, n+1, n+3, n+7, ...) until a probe finds a solution, and
+   * then bisected between the largest number without and the smallest
+   * number with a solution. This assumes that more slots never make the
+   * problem infeasible. The number of slots is capped at one slot per
+   * ordered pair of processors (nodes^2). A probe that times out
+   * leaves its slot count unknown and ends the search: the smallest slot
+   * count found so far, if any, is reported as not proven minimal.
+   *
+   * With dse.threads != 1, several slot counts are probed per round in
+   * parallel (exponentially or evenly spaced), and a solution cancels the
+   * probes with more slots. The route table is built once and the last
+   * TDN graphs are kept by Platform::setTDNconfig.
    */
   void loopForMinimalTDNConfig(Mapping* map) {
     
@@ -522,60 +1716,142 @@ private:
     }
     
     t_start = runTimer::now();
-    bool solutionFound = false;
-    size_t tdn_slots = map->getPlatform()->nodes();
-      LOG_INFO("Searching for minimal TDN config. Starting with "+tools::toString(tdn_slots)+" slots.\n");
-    while(!solutionFound){
-      LOG_INFO("### Trying "+tools::toString(tdn_slots)+" slots. #########################################");
-      out << "Trying " << tdn_slots << " slots..." << endl;
-      map->getPlatform()->setTDNconfig(tdn_slots);
+    Platform* platform = map->getPlatform();
+    size_t first = platform->nodes();
+    LOG_INFO("Searching for minimal TDN config. Starting with "+tools::toString(first)+" slots.\n");
+    
+    if(cfg.settings().search == Config::GIST_ALL || cfg.settings().search == Config::GIST_OPT){
+      platform->setTDNconfig(first);
       model = new CPModelTemplate(map, &cfg);
-      
-      switch (cfg.settings().search) {
-        case (Config::GIST_ALL): {
-          Gist::Print<CPModelTemplate> p("Print solution");
-          Gist::Options options;
-          options.inspect.click(&p);
-          Gist::dfs(model, options);
-          solutionFound = true; //only for testing/debugging
-          break;
+      Gist::Print<CPModelTemplate> p("Print solution");
+      Gist::Options options;
+      options.inspect.click(&p);
+      if(cfg.settings().search == Config::GIST_ALL){
+        Gist::dfs(model, options);
+      }else{
+        Gist::bab(model, options);
+      }
+      out.close();
+      return;
+    }
+    
+    unsigned int n_probes = cfg.settings().threads;
+    if(n_probes == 0)
+      n_probes = std::thread::hardware_concurrency();
+    if(n_probes == 0)
+      n_probes = 1;
+    
+    size_t max_slots = first * first;
+    size_t lo = first - 1; //largest number of slots without a solution
+    size_t hi = 0;         //smallest number of slots with a solution, 0: none yet
+    size_t unknown = 0;    //smallest number of slots whose probe timed out, 0: none
+    size_t step = 1;       //next increase of lo while hi is unknown
+    CPModelTemplate* best = nullptr;
+    EngineSnapshot best_snapshot;
+    Search::Statistics total;
+    size_t n_rounds = 0;
+    
+    while(unknown == 0 && (hi == 0 ? lo < max_slots : hi - lo > 1)){
+      vector<size_t> candidates;
+      if(hi == 0){
+        size_t c = lo;
+        for(unsigned int i = 0; i < n_probes && c < max_slots; i++){
+          c = std::min(c + step, max_slots);
+          step *= 2;
+          candidates.push_back(c);
         }
-        case (Config::GIST_OPT): {
-          Gist::Print<CPModelTemplate> p("Print solution");
-          Gist::Options options;
-          options.inspect.click(&p);
-          Gist::bab(model, options);
-          solutionFound = true; //only for testing/debugging
-          break;
+      }else{
+        for(unsigned int i = 1; i <= n_probes; i++){
+          size_t c = lo + (hi - lo) * i / (n_probes + 1);
+          if(c > lo && c < hi && (candidates.empty() || candidates.back() != c))
+            candidates.push_back(c);
         }
-        case (Config::FIRST):
-        case (Config::ALL): {
-          LOG_INFO("DFS engine ...");
-          DFS<CPModelTemplate> e(model, geSearchOptions);
-          solutionFound = findMinimalTDNConfig<DFS<CPModelTemplate>>(&e);
-          break;
+      }
+      n_rounds++;
+      
+      //the models are built one after the other, each reads the TDN graph of the platform
+      vector<unique_ptr<TDNProbe>> probes;
+      for(size_t c : candidates){
+        LOG_INFO("### Trying "+tools::toString(c)+" slots. #########################################");
+        platform->setTDNconfig(c);
+        unique_ptr<TDNProbe> p(new TDNProbe());
+        p->slots = c;
+        p->model = new CPModelTemplate(map, &cfg);
+        p->cancel = false;
+        p->solution = nullptr;
+        probes.push_back(std::move(p));
+      }
+      
+      auto worker = [&](TDNProbe* p){
+        runTDNProbe(*p);
+        if(p->result == TDNProbe::FEASIBLE){
+          for(auto& q : probes){
+            if(q->slots > p->slots)
+              q->cancel = true;
+          }
         }
-        case (Config::OPTIMIZE): {
-          LOG_INFO("BAB engine, optimizing ... ");
-          BAB<CPModelTemplate> e(model, geSearchOptions);
-          solutionFound = findMinimalTDNConfig<BAB<CPModelTemplate>>(&e);
-          break;
+      };
+      if(probes.size() == 1){
+        worker(probes[0].get());
+      }else{
+        vector<thread> threads;
+        for(auto& p : probes){
+          threads.push_back(thread(worker, p.get()));
         }
-        case (Config::OPTIMIZE_IT): {
-          LOG_INFO("BAB engine, optimizing iteratively ... ");
-          Search::Cutoff* cut = Search::Cutoff::luby(cfg.settings().luby_scale);
-          geSearchOptions.cutoff = cut;
-          geSearchOptions.nogoods_limit = cfg.settings().noGoodDepth;
-          RBS<CPModelTemplate, BAB> e(model, geSearchOptions);
-          solutionFound = findMinimalTDNConfig<RBS<CPModelTemplate, BAB>>(&e);
-
-          break;
+        for(auto& t : threads){
+          t.join();
         }
-        default:
-          THROW_EXCEPTION(RuntimeException, "unknown search type for main solver.");
-          break;
       }
-      if(!solutionFound) tdn_slots++;
+      
+      const char* results[] = {"solution found", "no solution", "time-out", "cancelled"};
+      for(auto& p : probes){
+        auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(p->time).count();
+        out << "Trying " << p->slots << " slots: " << results[p->result] << " after " << time_ms << " ms, search nodes: "
+            << p->snapshot.statistics().node << ", fail: " << p->snapshot.statistics().fail << ", propagate: "
+            << p->snapshot.statistics().propagate << endl;
+        LOG_INFO(tools::toString(p->slots) + " slots: " + results[p->result]);
+        total += p->snapshot.statistics();
+        if(p->result == TDNProbe::FEASIBLE && (hi == 0 || p->slots < hi)){
+          hi = p->slots;
+          delete best;
+          best = p->solution;
+          best_snapshot = p->snapshot;
+        }else{
+          delete p->solution;
+        }
+      }
+      for(auto& p : probes){
+        if(p->result == TDNProbe::INFEASIBLE && p->slots > lo && (hi == 0 || p->slots < hi))
+          lo = p->slots;
+        if(p->result == TDNProbe::TIMEOUT && (hi == 0 || p->slots < hi) && (unknown == 0 || p->slots < unknown))
+          unknown = p->slots;
+      }
+      if(unknown != 0 && unknown <= lo) //a probe with more slots has no solution
+        unknown = 0;
+    }
+    
+    t_endAll = runTimer::now();
+    if(hi == 0){
+      nodes = 0;
+      if(unknown != 0){
+        out << "\n#####\nNo TDN configuration found, the probe with " << unknown << " slots timed out, after "
+            << n_rounds << " round(s) of probes\n";
+        LOG_WARNING("No TDN configuration found, the probe with " + tools::toString(unknown) + " slots timed out.");
+      }else{
+        out << "\n#####\nNo TDN configuration with up to " << max_slots << " slots, after " << n_rounds << " round(s) of probes\n";
+        LOG_WARNING("No TDN configuration with up to " + tools::toString(max_slots) + " slots.");
+      }
+    }else{
+      platform->setTDNconfig(hi);
+      nodes = 1;
+      if(unknown != 0){
+        out << "\n#####\nTDN configuration: " << hi << " slots, not proven minimal (the probe with " << unknown
+            << " slots timed out), after " << n_rounds << " round(s) of probes\n";
+      }else{
+        out << "\n#####\nMinimal TDN configuration: " << hi << " slots, after " << n_rounds << " round(s) of probes\n";
+      }
+      printSolution(&best_snapshot, best);
+      delete best;
     }
     
     auto durAll = runTimer::now() - t_start;
@@ -583,8 +1859,9 @@ private:
     auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
     
     out << "\n#####\n";
-    out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms)";
-    
+    out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms) =====\n"
+        << "search nodes: " << total.node << ", fail: " << total.fail << ", propagate: " << total.propagate
+        << ", depth: " << total.depth << ", nogoods: " << total.nogood << ", restarts: " << total.restart << " ***\n";
 
     out.close();
   }
@@ -28,7 +28,7 @@
 # MODULE PATH AND FILES
 #=======================
 
-CPP_FILES := execution.cpp 
+CPP_FILES := execution.cpp search_monitor.cpp checkpoint.cpp
 
 
 
@@ -0,0 +1,157 @@
+#include "search_monitor.hpp"
+
+#include <unistd.h>
+#include <sys/resource.h>
+
+using namespace Gecode;
+using namespace std;
+
+SearchMonitor::Stop::Stop(SearchMonitor& _monitor, Search::Stop* _inner) :
+    monitor(_monitor), inner(_inner) {}
+
+bool SearchMonitor::Stop::stop(const Search::Statistics& s, const Search::Options& o){
+  monitor.observe(s);
+  return inner != nullptr && inner->stop(s, o);
+}
+
+SearchMonitor::SearchMonitor(const string& _path, unsigned long _interval, size_t _n_objectives) :
+    path(_path), interval(chrono::milliseconds(_interval)), n_objectives(_n_objectives), running(false), run(0),
+    n_solutions(0), n_samples(0), n_clockReads(0), t_sampling(0) {
+  const int reads = 1000;
+  clock::time_point t = clock::now();
+  for(int i = 0; i < reads; i++){
+    clock::now();
+  }
+  clockCost = (double) chrono::duration_cast<chrono::nanoseconds>(clock::now() - t).count() / reads;
+}
+
+SearchMonitor::~SearchMonitor(){
+  finish();
+}
+
+void SearchMonitor::start(){
+  lock_guard<mutex> guard(lock);
+  csv.open(path);
+  csv << "ms,nodes,fail,propagate,restart,nogood,depth,rss_kb,solutions";
+  for(size_t i = 0; i < n_objectives; i++){
+    csv << ",obj_" << i;
+  }
+  csv << endl;
+  slots.clear();
+  best.clear();
+  n_solutions = 0;
+  n_samples = 0;
+  n_clockReads = 0;
+  t_sampling = clock::duration(0);
+  static atomic<unsigned long> runs(0);
+  run = ++runs;
+  t_start = clock::now();
+  next_sample = t_start + interval;
+  running = true;
+}
+
+void SearchMonitor::solution(const vector<int>& objectives){
+  lock_guard<mutex> guard(lock);
+  best = objectives;
+  n_solutions++;
+}
+
+void SearchMonitor::finish(){
+  lock_guard<mutex> guard(lock);
+  if(!running)
+    return;
+  running = false;
+  write(clock::now());
+  csv.close();
+}
+
+double SearchMonitor::overhead() const{
+  return chrono::duration_cast<chrono::microseconds>(t_sampling).count() / 1000.0
+         + n_clockReads.load() * clockCost / 1e6;
+}
+
+void SearchMonitor::observe(const Search::Statistics& s){
+  //per search thread: nodes until the next clock read, and the time of the last read
+  static thread_local unsigned int calls = 0;
+  static thread_local unsigned int stride = 1;
+  static thread_local clock::time_point last;
+  //per search thread: statistics at the last call and totals of the finished engines
+  static thread_local unsigned long seenRun = 0;
+  static thread_local Search::Statistics seen, done;
+  unsigned long current = run.load();
+  if(seenRun != current){
+    seenRun = current;
+    seen = done = Search::Statistics();
+  }
+  if(s.node < seen.node || s.fail < seen.fail || s.propagate < seen.propagate){ //a new engine
+    done += seen;
+  }
+  seen = s;
+  if(++calls < stride)
+    return;
+  calls = 0;
+  if(!running)
+    return;
+
+  clock::time_point now = clock::now();
+  n_clockReads++;
+  //aim at 10 to 100 clock reads per interval
+  if(now - last < interval / 100 && stride < 4096){
+    stride *= 2;
+  }else if(now - last > interval / 10 && stride > 1){
+    stride /= 2;
+  }
+  last = now;
+
+  lock_guard<mutex> guard(lock);
+  if(!running)
+    return;
+  thread::id id = this_thread::get_id();
+  size_t k = 0;
+  while(k < slots.size() && slots[k].id != id)
+    k++;
+  if(k == slots.size()){
+    slots.push_back(Slot{id, done, s});
+  }else{
+    slots[k].done = done;
+    slots[k].stats = s;
+  }
+  if(now >= next_sample){
+    write(now);
+  }
+  t_sampling += clock::now() - now;
+}
+
+void SearchMonitor::write(clock::time_point now){
+  Search::Statistics total;
+  unsigned long int depth = 0;
+  for(const Slot& slot : slots){
+    total += slot.done;
+    total += slot.stats;
+    depth = max(depth, (unsigned long int) slot.stats.depth);
+  }
+  csv << chrono::duration_cast<chrono::milliseconds>(now - t_start).count() << "," << total.node << ","
+      << total.fail << "," << total.propagate << "," << total.restart << "," << total.nogood << ","
+      << depth << "," << residentKB() << "," << n_solutions;
+  for(size_t i = 0; i < n_objectives; i++){
+    csv << ",";
+    if(i < best.size())
+      csv << best[i];
+  }
+  csv << endl;
+  n_samples++;
+  while(next_sample <= now){
+    next_sample += interval;
+  }
+}
+
+long SearchMonitor::residentKB(){
+  long pages = 0, resident = 0;
+  ifstream statm("/proc/self/statm");
+  if(statm >> pages >> resident){
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <gecode/search.hh>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Samples the search statistics during the exploration and appends them,
+ * together with the best objective values and the resident memory of the
+ * process, as one row every interval to a CSV file.
+ *
+ * The samples are taken by the search threads themselves, in the stop
+ * object that the engines consult at every node (SearchMonitor::Stop, which
+ * wraps the actual stop object). To keep this cheap, a thread only reads the
+ * clock every stride nodes; the stride adapts so that the clock is read
+ * between ten and a hundred times per interval. Each search thread keeps its own
+ * statistics, a row contains their sum (and the largest depth). A thread can
+ * run several engines one after the other (LNS), whose statistics start from
+ * zero: the totals of the finished engines of a thread are added to its
+ * statistics, so that the counters in the file never decrease.
+ */
+class SearchMonitor {
+public:
+  /**
+   * Stop object of a search engine: records a sample and asks the wrapped
+   * stop object (nullptr: none) whether to stop.
+   */
+  class Stop : public Search::Stop {
+  public:
+    Stop(SearchMonitor& _monitor, Search::Stop* _inner);
+    virtual bool stop(const Search::Statistics& s, const Search::Options& o);
+  private:
+    SearchMonitor& monitor;
+    Search::Stop* inner;
+  };
+
+  /**
+   * @param _path CSV file, written from start() on
+   * @param _interval sampling interval in ms
+   * @param _n_objectives number of objective columns
+   */
+  SearchMonitor(const string& _path, unsigned long _interval, size_t _n_objectives);
+  ~SearchMonitor();
+
+  //opens the file and starts the clock, samples before start() are ignored
+  void start();
+  //records the objective values of a new best solution
+  void solution(const vector<int>& objectives);
+  //writes the last row and closes the file
+  void finish();
+
+  size_t samples() const { return n_samples; }
+  //time spent reading the clock and writing samples, in ms
+  double overhead() const;
+
+private:
+  typedef chrono::steady_clock clock;
+
+  //statistics of one search thread
+  struct Slot {
+    thread::id id;
+    Search::Statistics done; //totals of the finished engines
+    Search::Statistics stats; //of the running engine
+  };
+
+  string path;
+  clock::duration interval;
+  size_t n_objectives;
+  ofstream csv;
+  mutex lock;
+  atomic<bool> running;
+  atomic<unsigned long> run; //number of the start() of this monitor among all monitors
+  clock::time_point t_start;
+  clock::time_point next_sample;
+  vector<Slot> slots;
+  vector<int> best;
+  size_t n_solutions;
+  size_t n_samples;
+  atomic<unsigned long long> n_clockReads;
+  clock::duration t_sampling;
+  double clockCost; //ns per clock read, measured in the constructor
+
+  void observe(const Search::Statistics& s);
+  void write(clock::time_point now);
+  static long residentKB();
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+using namespace std;
+
+/**
+ * Formats and writes solutions in a thread of its own, so that printing
+ * does not slow down the search.
+ *
+ * The search thread copies the values it prints out of a solution into a
+ * record (no clone of the space) and hands it over through a bounded ring
+ * buffer with one producer and one consumer: both sides only read the
+ * index of the other side and publish their own, without locks. The
+ * search thread only waits when the buffer is full, the writer thread
+ * backs off to short sleeps when it is empty.
+ */
+template<class Record>
+class SolutionWriter {
+public:
+  typedef function<void(const Record&)> Format; /**< writes one record. */
+  typedef function<void()> Flush; /**< called whenever the buffer runs empty. */
+
+  /**
+   * Starts the writer thread.
+   * @param capacity size of the buffer, rounded up to a power of two
+   */
+  SolutionWriter(size_t capacity, Format _format, Flush _flush = Flush()) :
+      format(_format), flush(_flush), head(0), tail(0), closed(false), n_waits(0) {
+    size_t n = 2;
+    while(n < capacity)
+      n *= 2;
+    slots.resize(n);
+    mask = n - 1;
+    writer = thread(&SolutionWriter::run, this);
+  }
+
+  ~SolutionWriter() {
+    finish();
+  }
+
+  /**
+   * Hands a record over to the writer thread, waits while the buffer is full.
+   */
+  void push(Record&& r) {
+    size_t t = tail.load(memory_order_relaxed);
+    if(t - head.load(memory_order_acquire) > mask){
+      n_waits++;
+      while(t - head.load(memory_order_acquire) > mask)
+        this_thread::yield();
+    }
+    slots[t & mask] = std::move(r);
+    tail.store(t + 1, memory_order_release);
+  }
+
+  /**
+   * Writes the remaining records and stops the writer thread.
+   */
+  void finish() {
+    if(!writer.joinable())
+      return;
+    closed.store(true, memory_order_release);
+    writer.join();
+  }
+
+  /** number of push() calls that found the buffer full. */
+  size_t waits() const { return n_waits; }
+
+private:
+  Format format;
+  Flush flush;
+  vector<Record> slots;
+  size_t mask;
+  atomic<size_t> head; /**< next record to write, only advanced by the writer. */
+  atomic<size_t> tail; /**< next free slot, only advanced by the search. */
+  atomic<bool> closed;
+  size_t n_waits;
+  thread writer;
+
+  void run() {
+    unsigned int idle = 0;
+    while(true){
+      size_t h = head.load(memory_order_relaxed);
+      if(h == tail.load(memory_order_acquire)){
+        //closed is set after the last push, so the buffer is checked once more
+        if(closed.load(memory_order_acquire) && h == tail.load(memory_order_acquire))
+          break;
+        if(idle++ == 0 && flush)
+          flush();
+        if(idle < 64){
+          this_thread::yield();
+        }else{
+          this_thread::sleep_for(chrono::microseconds(200));
+        }
+        continue;
+      }
+      idle = 0;
+      format(slots[h & mask]);
+      slots[h & mask] = Record(); //releases the memory of the record
+      head.store(h + 1, memory_order_release);
+    }
+    if(flush)
+      flush();
+  }
+};
@@ -1,5 +1,8 @@
 #include "platform.hpp"
 
+#include <map>
+#include <set>
+
 using namespace std;
 
 Platform::Platform(size_t p_nodes, int p_cycle, size_t p_memSize, int p_buffer, enum InterconnectType p_type, int p_dps, int p_tdma, int p_roundLength){
@@ -41,6 +44,156 @@ Platform::Platform(XMLdoc& xml) throw (InvalidArgumentException)
     }
 }
 
+Platform::Platform(tools::SnapshotReader& snap)
+{
+  size_t n_pes = snap.getInt();
+  for(size_t i=0; i<n_pes; i++){
+    PE* pe = new PE();
+    snap.get(pe->name);
+    snap.get(pe->type);
+    snap.get(pe->model);
+    snap.get(pe->modes);
+    snap.get(pe->n_modes);
+    snap.get(pe->cycle_length);
+    snap.get(pe->memorySize);
+    snap.get(pe->dynPowerCons);
+    snap.get(pe->staticPowerCons);
+    snap.get(pe->areaCost);
+    snap.get(pe->monetaryCost);
+    snap.get(pe->NI_bufferSize);
+    compNodes.push_back(pe);
+  }
+
+  interconnect.type = (InterconnectType) snap.getInt();
+  snap.get(interconnect.name);
+  snap.get(interconnect.dataPerSlot);
+  snap.get(interconnect.dataPerRound);
+  snap.get(interconnect.tdmaSlots);
+  snap.get(interconnect.roundLength);
+  snap.get(interconnect.columns);
+  snap.get(interconnect.rows);
+  snap.get(interconnect.flitSize);
+  snap.get(interconnect.tdnCycles);
+  snap.get(interconnect.tdnCyclesPerProc);
+  size_t n_modes = snap.getInt();
+  for(size_t i=0; i<n_modes; i++){
+    InterconnectMode m;
+    snap.get(m.name);
+    for(size_t* v : {&m.cycleLength, &m.roundLength, &m.dynPower_link, &m.dynPower_NI,
+                     &m.dynPower_switch, &m.dynPower_bus, &m.staticPow_link, &m.staticPow_NI,
+                     &m.staticPow_switch, &m.staticPow_bus, &m.area_link, &m.area_NI,
+                     &m.area_switch, &m.area_bus, &m.monetary_link, &m.monetary_NI,
+                     &m.monetary_switch, &m.monetary_bus}){
+      snap.get(*v);
+    }
+    interconnect.modes.push_back(m);
+  }
+  size_t n_routes = snap.getInt();
+  interconnect.all_routes.resize(n_routes);
+  for(auto& r : interconnect.all_routes){
+    snap.get(r.srcProc);
+    snap.get(r.dstProc);
+    snap.get(r.tdn_nodePath);
+  }
+
+  //the routes of the TDN graph are shared between its nodes
+  vector<shared_ptr<tdn_route>> routes(snap.getInt());
+  for(auto& r : routes){
+    r = make_shared<tdn_route>();
+    snap.get(r->srcProc);
+    snap.get(r->dstProc);
+    snap.get(r->tdn_nodePath);
+  }
+  tdn_graph.resize(snap.getInt());
+  for(auto& node : tdn_graph){
+    snap.get(node.passingProcs);
+    snap.get(node.link.from);
+    snap.get(node.link.to);
+    snap.get(node.link.cycle);
+    vector<int> ids;
+    snap.get(ids);
+    for(int id : ids){
+      if(id < 0 || (size_t) id >= routes.size())
+        THROW_EXCEPTION(IOException, "platform snapshot", "corrupt TDN graph");
+      node.tdn_routes.push_back(routes[id]);
+    }
+  }
+}
+
+void Platform::save(tools::SnapshotWriter& snap) const
+{
+  snap.put(compNodes.size());
+  for(auto pe : compNodes){
+    snap.put(pe->name);
+    snap.put(pe->type);
+    snap.put(pe->model);
+    snap.put(pe->modes);
+    snap.put(pe->n_modes);
+    snap.put(pe->cycle_length);
+    snap.put(pe->memorySize);
+    snap.put(pe->dynPowerCons);
+    snap.put(pe->staticPowerCons);
+    snap.put(pe->areaCost);
+    snap.put(pe->monetaryCost);
+    snap.put(pe->NI_bufferSize);
+  }
+
+  snap.put((int) interconnect.type);
+  snap.put(interconnect.name);
+  snap.put(interconnect.dataPerSlot);
+  snap.put(interconnect.dataPerRound);
+  snap.put(interconnect.tdmaSlots);
+  snap.put(interconnect.roundLength);
+  snap.put(interconnect.columns);
+  snap.put(interconnect.rows);
+  snap.put(interconnect.flitSize);
+  snap.put(interconnect.tdnCycles);
+  snap.put(interconnect.tdnCyclesPerProc);
+  snap.put(interconnect.modes.size());
+  for(const auto& m : interconnect.modes){
+    snap.put(m.name);
+    for(size_t v : {m.cycleLength, m.roundLength, m.dynPower_link, m.dynPower_NI,
+                    m.dynPower_switch, m.dynPower_bus, m.staticPow_link, m.staticPow_NI,
+                    m.staticPow_switch, m.staticPow_bus, m.area_link, m.area_NI,
+                    m.area_switch, m.area_bus, m.monetary_link, m.monetary_NI,
+                    m.monetary_switch, m.monetary_bus}){
+      snap.put(v);
+    }
+  }
+  snap.put(interconnect.all_routes.size());
+  for(const auto& r : interconnect.all_routes){
+    snap.put(r.srcProc);
+    snap.put(r.dstProc);
+    snap.put(r.tdn_nodePath);
+  }
+
+  map<const tdn_route*, int> route_ids;
+  vector<const tdn_route*> routes;
+  for(const auto& node : tdn_graph){
+    for(const auto& r : node.tdn_routes){
+      if(route_ids.insert(make_pair(r.get(), (int) routes.size())).second)
+        routes.push_back(r.get());
+    }
+  }
+  snap.put(routes.size());
+  for(auto r : routes){
+    snap.put(r->srcProc);
+    snap.put(r->dstProc);
+    snap.put(r->tdn_nodePath);
+  }
+  snap.put(tdn_graph.size());
+  for(const auto& node : tdn_graph){
+    snap.put(node.passingProcs);
+    snap.put(node.link.from);
+    snap.put(node.link.to);
+    snap.put(node.link.cycle);
+    vector<int> ids;
+    for(const auto& r : node.tdn_routes)
+      ids.push_back(route_ids[r.get()]);
+    snap.put(ids);
+  }
+}
+
 void Platform::load_xml(XMLdoc& xml) throw (InvalidArgumentException)
 {
 	const char* my_xpathString = "///platform/processor";
@@ -403,12 +556,26 @@ void Platform::load_xml(XMLdoc& xml) throw (InvalidArgumentException)
 }
 
 void Platform::setTDNconfig(size_t slots){
+  //the TDN graph depends on the number of cycles, the route table does not
+  if(!tdn_graph.empty()){
+    if(tdn_graphs.size() == max_tdn_graphs) //drops the least recently used graph
+      tdn_graphs.erase(tdn_graphs.begin());
+    tdn_graphs.push_back(make_pair(interconnect.tdnCycles, vector<tdn_graphNode>()));
+    tdn_graphs.back().second.swap(tdn_graph);
+  }
   interconnect.tdnCycles = slots;
   interconnect.tdnCyclesPerProc = 1;
-  tdn_graph.clear();
-  interconnect.all_routes.clear();
-  createTDNGraph();
-  createRouteTable();
+  auto it = tdn_graphs.begin();
+  while(it != tdn_graphs.end() && it->first != slots)
+    it++;
+  if(it != tdn_graphs.end()){
+    tdn_graph.swap(it->second);
+    tdn_graphs.erase(it);
+  }else{
+    createTDNGraph();
+  }
+  if(interconnect.all_routes.empty())
+    createRouteTable();
 }
 
 Platform::~Platform(){
@@ -1474,6 +1641,69 @@ bool Platform::homogeneous() const{
   return true;
 }
 
+vector<vector<int>> Platform::meshSymmetries() const{
+  vector<vector<int>> symmetries;
+  if(interconnect.type != TDN_NOC || interconnect.all_routes.empty())
+    return symmetries;
+  size_t cols = interconnect.columns;
+  size_t rows = interconnect.rows;
+
+  //switches visited by the route between each pair of nodes
+  map<pair<size_t, size_t>, vector<int>> paths;
+  for(const auto& r : interconnect.all_routes){
+    vector<int> path(1, r.srcProc);
+    for(size_t h = 1; h + 1 < r.tdn_nodePath.size(); h++)
+      path.push_back(tdn_graph[r.tdn_nodePath[h] * interconnect.tdnCycles].link.to);
+    paths[make_pair(r.srcProc, r.dstProc)] = path;
+  }
+
+  //candidates: bit 0 mirrors x, bit 1 mirrors y, bit 2 transposes
+  set<vector<int>> found;
+  for(int t = 1; t < (cols == rows ? 8 : 4); t++){
+    vector<int> sigma(nodes());
+    for(size_t j = 0; j < nodes(); j++){
+      size_t x = j % cols;
+      size_t y = j / cols;
+      if(t & 1) x = cols - 1 - x;
+      if(t & 2) y = rows - 1 - y;
+      if(t & 4) swap(x, y);
+      sigma[j] = y * cols + x;
+    }
+
+    bool valid = true;
+    for(size_t j = 0; j < nodes() && valid; j++){
+      const PE* a = compNodes[j];
+      const PE* b = compNodes[sigma[j]];
+      valid = a->type == b->type && a->model == b->model && a->modes == b->modes
+              && a->cycle_length == b->cycle_length && a->memorySize == b->memorySize
+              && a->dynPowerCons == b->dynPowerCons && a->staticPowerCons == b->staticPowerCons
+              && a->areaCost == b->areaCost && a->monetaryCost == b->monetaryCost
+              && a->NI_bufferSize == b->NI_bufferSize;
+    }
+    //with dimension-ordered routing, the transpositions usually fail here
+    for(auto it = paths.begin(); it != paths.end() && valid; ++it){
+      auto image = paths.find(make_pair(sigma[it->first.first], sigma[it->first.second]));
+      if(image == paths.end() || image->second.size() != it->second.size()){
+        valid = false;
+        break;
+      }
+      for(size_t h = 0; h < it->second.size(); h++){
+        if(sigma[it->second[h]] != image->second[h]){
+          valid = false;
+          break;
+        }
+      }
+    }
+
+    bool identity = true;
+    for(size_t j = 0; j < nodes(); j++)
+      identity = identity && sigma[j] == (int)j;
+    if(valid && !identity && found.insert(sigma).second)
+      symmetries.push_back(sigma);
+  }
+  return symmetries;
+}
+
 // True if all processors only have one mode
 bool Platform::allProcsFixed() const{
   for (size_t j = 0; j < nodes(); j++) {
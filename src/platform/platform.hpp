@@ -29,11 +29,13 @@
 #include<iostream>
 #include <limits>
 #include <vector>
+#include <map>
 #include <string>
 #include "math.h"
 #include <stdio.h>
 #include <string.h>
 #include "../xml/xmldoc.hpp"
+#include "../tools/snapshot.hpp"
 
 #include "../exceptions/runtimeexception.h"
 
@@ -331,6 +333,8 @@ protected:
   std::vector<PE*> compNodes;
   Interconnect interconnect;
   vector<tdn_graphNode> tdn_graph;
+  vector<pair<size_t, vector<tdn_graphNode>>> tdn_graphs; /*!< TDN graphs of the last setTDNconfig calls with their number of cycles, the most recent last. */
+  static const size_t max_tdn_graphs = 8; /*!< number of TDN graphs kept in \ref tdn_graphs. */
   
   void createTDNGraph() throw (InvalidArgumentException);
   void createRouteTable();
@@ -341,6 +345,14 @@ public:
   
   Platform(XMLdoc& doc) throw (InvalidArgumentException);
 
+  /**
+   * Restores a platform (processors, interconnect, TDN graph and route
+   * table) from a snapshot written by save().
+   */
+  Platform(tools::SnapshotReader& snap);
+
+  void save(tools::SnapshotWriter& snap) const;
+
   Platform(size_t p_nodes, int p_cycle, size_t p_memSize, int p_buffer, enum InterconnectType p_type, int p_dps, int p_tdma, int p_roundLength);
   
   Platform(std::vector<PE*> p_nodes, InterconnectType p_type, int p_dps, int p_tdma, int p_roundLength);
@@ -495,6 +507,12 @@ public:
   
   // True if the platform is homogeneous
   bool homogeneous() const;
+
+  // The non-trivial symmetries of a TDN mesh: the reflections (and, for a
+  // square mesh, transpositions) of the grid that map each processor onto an
+  // identical one and each route onto the route between the mapped
+  // processors. Each symmetry is a permutation of the node ids.
+  vector<vector<int>> meshSymmetries() const;
   
   bool allProcsFixed() const;
   
@@ -48,7 +48,7 @@ OneProcModel::OneProcModel(Mapping* p_mapping, Config& cfg):
   IntVarArgs nAppsOnProc(*this, platform->nodes(), 0, apps->n_SDFApps()); /**< number of SDF apps on proc[i]. */
   count(*this, proc, nAppsOnProc);
 
-  if(mapping->homogeneousPlatform()){
+  if(mapping->interchangeableProcs()){
     for (size_t ii=0; ii<apps->n_SDFApps()-1; ii++){
       for (size_t ij=ii+1; ij<apps->n_SDFApps(); ij++){
         rel(*this, proc[ii]==proc[ij] || proc[ii]<proc[ij]);
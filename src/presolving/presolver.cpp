@@ -43,6 +43,11 @@
 #include "oneProcMappings.hpp"
 #include <chrono>
 #include <fstream>
+#include <sstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace std;
 using namespace Gecode;
@@ -231,7 +236,26 @@ private:
   ;
 
   /**
-   * Loops through the solutions and prints them using the input search engine
+   * Check of one presolver solution in the full model, run by a worker of the probe pool.
+   */
+  struct Probe {
+    size_t index; /**< number of the presolver solution (from 0). */
+    string presolution; /**< printed presolver solution. */
+    CPModelTemplate* model; /**< full model, constrained to the presolver solution. */
+    bool done; /**< set by the worker when the check has finished. */
+    bool solved; /**< the full model has a solution. */
+    bool stopped; /**< the check was stopped by the probe timeout. */
+    string solution; /**< printed solution of the full model. */
+    vector<int> optValues; /**< optimization values of the solution. */
+    vector<int> printValues; /**< print metrics of the solution. */
+  };
+  
+  /**
+   * Loops through the solutions and prints them using the input search engine.
+   * Each presolver solution is checked in the full model. The checks are
+   * independent, so they run on a pool of dse.threads workers. At most two
+   * checks per worker wait in the queue. The results are merged in the
+   * order of the presolver solutions.
    */
   template<class SearchEngine> void loopSolutions(SearchEngine *e, Mapping* map) {
     DSESettings* dseSettings = new DSESettings(settings);
@@ -244,8 +268,73 @@ private:
       outFull.open(settings.settings().output_path + "/out/" + "presolver_results.txt");
       outFull << "~~~~~ *** BEGIN OF PRESOLVER SOLUTIONS *** ~~~~~" << endl;
     }
+    
+    unsigned int n_workers = settings.settings().threads;
+    if(n_workers == 0)
+      n_workers = std::thread::hardware_concurrency();
+    if(n_workers == 0)
+      n_workers = 1;
+    const size_t maxQueued = 2 * n_workers;
+    
+    vector<Probe*> probes; //all probes, in the order of the presolver solutions
+    deque<Probe*> queue; //probes waiting for a worker
+    size_t merged = 0; //probes[0..merged-1] have been merged into the results
+    bool closing = false; //no more probes will be queued
+    mutex lock;
+    condition_variable probeQueued, probeTaken;
+    vector<runTimer::duration> busy(n_workers, runTimer::duration(0));
+    vector<size_t> n_probes(n_workers, 0);
+    
+    auto worker = [&](unsigned int w){
+      while(true){
+        Probe* p;
+        {
+          unique_lock<mutex> guard(lock);
+          probeQueued.wait(guard, [&]{ return !queue.empty() || closing; });
+          if(queue.empty())
+            return;
+          p = queue.front();
+          queue.pop_front();
+          probeTaken.notify_all();
+        }
+        runTimer::time_point t_probe = runTimer::now();
+        Search::Options options;
+        options.threads = 1;
+        Search::TimeStop* stop = nullptr;
+        if(settings.settings().pre_probe_timeout > 0){
+          stop = new Search::TimeStop(settings.settings().pre_probe_timeout);
+          options.stop = stop;
+        }
+        DFS<CPModelTemplate> ef(p->model, options);
+        delete p->model;
+        p->model = nullptr;
+        CPModelTemplate * sf = ef.next();
+        p->solved = sf != nullptr;
+        p->stopped = ef.stopped();
+        if(sf){
+          ostringstream printed;
+          sf->print(printed);
+          p->solution = printed.str();
+          p->optValues = sf->getOptimizationValues();
+          p->printValues = sf->getPrintMetrics();
+          delete sf;
+        }
+        delete stop;
+        
+        unique_lock<mutex> guard(lock);
+        busy[w] += runTimer::now() - t_probe;
+        n_probes[w]++;
+        p->done = true;
+        probeTaken.notify_all();
+      }
+    };
+    
 //    cout << "start searching for " << settings.settings().pre_search << " solutions \n";
     t_start = runTimer::now();
+    vector<thread> workers;
+    for(unsigned int w = 0; w < n_workers; w++){
+      workers.push_back(thread(worker, w));
+    }
     while(Space * s = e->next()){
       nodes++;
       if(nodes == 1){
@@ -253,10 +342,17 @@ private:
           t_endAll = runTimer::now();
           printSolution(e, (PresolverCPTemplate*)s);
           cout << "returning" << endl;
+          {
+            lock_guard<mutex> guard(lock);
+            closing = true;
+          }
+          probeQueued.notify_all();
+          for(auto& t : workers){
+            t.join();
+          }
           return;
         }
       }
-      t_endAll = runTimer::now();
 
       if(nodes % 10 == 0){
         cout << ".";
@@ -266,58 +362,56 @@ private:
           cout << endl;
       }
 
-      printSolution(e, (PresolverCPTemplate*)s);
+      Probe* p = new Probe();
+      p->index = nodes-1;
+      ostringstream printed;
+      ((PresolverCPTemplate*)s)->print(printed);
+      p->presolution = printed.str();
       results->it_mapping = nodes-1;
       results->oneProcMappings.push_back(((PresolverCPTemplate*)s)->getResult());
       delete s;
 
       settings.setPresolverResults(results);
-      LOG_INFO("PRESOLVER executing full model - finding " + tools::toString(nodes));
-      CPModelTemplate* full_model = new CPModelTemplate(map, &settings);
-      DFS<CPModelTemplate> ef(full_model, geSearchOptions);
-      if(CPModelTemplate * sf = ef.next()){
-        fullNodes++;
-        if(settings.settings().out_file_type == Config::ALL_OUT ||
-           settings.settings().out_file_type == Config::TXT){
-          outFull << "Pre-solution " << nodes << "----------" << endl;
-          sf->print(outFull);
-          outFull << "------------------------------" << endl << endl;
-        }
-        //Mapping* mapRes = sf->extractResult();
-        //settings.getPresolverResults()->periods.push_back(mapRes->getPeriods());
-        //settings.getPresolverResults()->sys_energys.push_back(mapRes->getSysEnergy());
-        t_endAll = runTimer::now();
-        
-        if(settings.doOptimize()){
-          settings.getPresolverResults()->optResults.push_back(Config::SolutionValues{t_endAll-t_start, sf->getOptimizationValues()});
-        }
-        if(!settings.settings().printMetrics.empty()){
-          settings.getPresolverResults()->printResults.push_back(Config::SolutionValues{t_endAll-t_start, sf->getPrintMetrics()});
-        }
-        
-        out << "Mapping in full CP model: Returned a valid solution.\n";
-        out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
-        out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
-        
-        delete sf;
-      }else{
-        if(settings.settings().out_file_type == Config::ALL_OUT ||
-           settings.settings().out_file_type == Config::TXT){
-          outFull << "------------------------------" << endl << endl;
-          outFull << "Presolver mapping " << nodes << " does not give a solution." << endl;
-          outFull << "------------------------------" << endl << endl;
-            
-        }
-        out << "Mapping in full CP model: Does not give valid solution.\n";
-        out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
-        out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
+      LOG_INFO("PRESOLVER queueing full model - finding " + tools::toString(nodes));
+      //the full model is created here, it reads it_mapping and the results merged so far
+      p->model = new CPModelTemplate(map, &settings);
+      
+      unique_lock<mutex> guard(lock);
+      probeTaken.wait(guard, [&]{ return queue.size() < maxQueued; });
+      queue.push_back(p);
+      probes.push_back(p);
+      probeQueued.notify_one();
+      while(merged < probes.size() && probes[merged]->done){
+        guard.unlock();
+        mergeProbe(probes[merged], map, fullNodes);
+        guard.lock();
+        merged++;
+      }
+    }
+    {
+      unique_lock<mutex> guard(lock);
+      closing = true;
+      probeQueued.notify_all();
+      while(merged < probes.size()){
+        probeTaken.wait(guard, [&]{ return probes[merged]->done; });
+        guard.unlock();
+        mergeProbe(probes[merged], map, fullNodes);
+        guard.lock();
+        merged++;
       }
-      delete full_model;
     }
+    for(auto& t : workers){
+      t.join();
+    }
+    for(auto p : probes){
+      delete p;
+    }
+    
     outFull << "~~~~~ *** END OF PRESOLVER SOLUTIONS *** ~~~~~" << endl;
     cout << endl;
     auto durAll = runTimer::now() - t_start;
     settings.getPresolverResults()->presolver_delay = durAll;
+    settings.getPresolverResults()->worker_delays = busy;
     auto durAll_s = std::chrono::duration_cast<std::chrono::seconds>(durAll).count();
     auto durAll_ms = std::chrono::duration_cast<std::chrono::milliseconds>(durAll).count();
     out << "===== search ended after: " << durAll_s << " s (" << durAll_ms << " ms)";
@@ -326,6 +420,10 @@ private:
     }
     out << " =====\n" << nodes << " solutions found\n" << "search nodes: " << e->statistics().node << ", fail: " << e->statistics().fail << ", propagate: "
         << e->statistics().propagate << ", depth: " << e->statistics().depth << ", nogoods: " << e->statistics().nogood << " ***\n";
+    for(unsigned int w = 0; w < n_workers; w++){
+      out << "  worker " << w << ": " << n_probes[w] << " full model checks in "
+          << std::chrono::duration_cast<std::chrono::milliseconds>(busy[w]).count() << " ms\n";
+    }
 
 
     if(settings.settings().out_file_type == Config::ALL_OUT ||
@@ -353,6 +451,92 @@ private:
     delete dseSettings;
   }
   
+  /**
+   * Writes the result of a full model check and adds its solution to the
+   * presolver results.
+   */
+  void mergeProbe(Probe* p, Mapping* map, int& fullNodes) {
+    out << "Solution " << p->index+1 << ":" << endl;
+    out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+    out << p->presolution;
+    out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+    
+    if(p->solved){
+      fullNodes++;
+      if(settings.settings().out_file_type == Config::ALL_OUT ||
+         settings.settings().out_file_type == Config::TXT){
+        outFull << "Pre-solution " << p->index+1 << "----------" << endl;
+        outFull << p->solution;
+        outFull << "------------------------------" << endl << endl;
+      }
+      t_endAll = runTimer::now();
+      
+      //a check that ran before the previous results were merged is not constrained by them
+      if(!settings.doOptimize() || improvesOptResults(map, p->optValues)){
+        if(settings.doOptimize()){
+          settings.getPresolverResults()->optResults.push_back(Config::SolutionValues{t_endAll-t_start, p->optValues});
+        }
+        if(!settings.settings().printMetrics.empty()){
+          settings.getPresolverResults()->printResults.push_back(Config::SolutionValues{t_endAll-t_start, p->printValues});
+        }
+      }
+      
+      out << "Mapping in full CP model: Returned a valid solution.\n";
+      out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+      out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
+    }else{
+      if(settings.settings().out_file_type == Config::ALL_OUT ||
+         settings.settings().out_file_type == Config::TXT){
+        outFull << "------------------------------" << endl << endl;
+        outFull << "Presolver mapping " << p->index+1 << " does not give a solution";
+        if(p->stopped){
+          outFull << " (time-out)";
+        }
+        outFull << "." << endl;
+        outFull << "------------------------------" << endl << endl;
+          
+      }
+      out << "Mapping in full CP model: Does not give valid solution";
+      if(p->stopped){
+        out << " (time-out)";
+      }
+      out << ".\n";
+      out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+      out << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
+    }
+  }
+  
+  /**
+   * Returns true if the optimization values improve on all results merged
+   * so far, as required of the full model by its presolver constraints.
+   */
+  bool improvesOptResults(Mapping* map, const vector<int>& values) {
+    Applications* apps = map->getApplications();
+    size_t idx;
+    if(settings.doOptimizeThput(settings.settings().optimizationStep)){
+      idx = apps->n_SDFApps();
+      for(size_t i = 0; i < apps->n_SDFApps(); i++){
+        if(apps->getPeriodConstraint(i) == -1){
+          idx = i;
+          break;
+        }
+      }
+      if(idx == apps->n_SDFApps())
+        return true;
+    }else if(settings.doOptimizePower(settings.settings().optimizationStep)){
+      idx = settings.doOptimizeThput() ? apps->n_SDFApps() : 0;
+    }else{
+      return true;
+    }
+    if(idx >= values.size())
+      return true;
+    for(auto r : settings.getPresolverResults()->optResults){
+      if(idx < r.values.size() && values[idx] >= r.values[idx])
+        return false;
+    }
+    return true;
+  }
+  
   /**
    * Loops through the solutions for the multi-step solving and prints them using the input search engine
    */
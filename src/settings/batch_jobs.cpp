@@ -0,0 +1,135 @@
+#include "batch_jobs.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/program_options/parsers.hpp>
+
+BatchJobs::BatchJobs(const string& _file, const string& _socket) throw (IOException)
+  : from_stdin(false), socket_path(_socket), server_fd(-1), client_fd(-1) {
+  if(!socket_path.empty()){
+    sockaddr_un addr;
+    if(socket_path.size() >= sizeof(addr.sun_path))
+      THROW_EXCEPTION(IOException, socket_path, "socket path is too long");
+    server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server_fd < 0)
+      THROW_EXCEPTION(IOException, socket_path, strerror(errno));
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(socket_path.c_str());
+    if(bind(server_fd, (sockaddr*) &addr, sizeof(addr)) < 0 || listen(server_fd, 4) < 0){
+      string reason = strerror(errno);
+      close(server_fd);
+      THROW_EXCEPTION(IOException, socket_path, reason);
+    }
+  }else if(_file == "-"){
+    from_stdin = true;
+  }else{
+    file.open(_file.c_str());
+    if(!file)
+      THROW_EXCEPTION(IOException, _file, "cannot read batch file");
+  }
+}
+
+BatchJobs::~BatchJobs() {
+  closeClient();
+  if(server_fd >= 0){
+    close(server_fd);
+    unlink(socket_path.c_str());
+  }
+}
+
+vector<string> BatchJobs::arguments(const string& job) {
+  vector<string> args = boost::program_options::split_unix(job);
+  args.insert(args.begin(), "adse");
+  return args;
+}
+
+bool BatchJobs::acceptClient() {
+  while(client_fd < 0){
+    client_fd = accept(server_fd, nullptr, nullptr);
+    if(client_fd < 0 && errno != EINTR)
+      return false;
+  }
+  pending.clear();
+  return true;
+}
+
+void BatchJobs::closeClient() {
+  if(client_fd >= 0){
+    close(client_fd);
+    client_fd = -1;
+  }
+}
+
+bool BatchJobs::readLine(string& line) {
+  if(server_fd < 0){
+    return (bool) getline(from_stdin ? cin : file, line);
+  }
+  while(true){
+    if(client_fd < 0 && !acceptClient())
+      return false;
+    size_t eol = pending.find('\n');
+    if(eol != string::npos){
+      line = pending.substr(0, eol);
+      pending.erase(0, eol + 1);
+      return true;
+    }
+    char buf[4096];
+    ssize_t n = read(client_fd, buf, sizeof(buf));
+    if(n > 0){
+      pending.append(buf, n);
+    }else if(n == 0 || errno != EINTR){ //client is done, wait for the next one
+      closeClient();
+      if(!pending.empty()){ //last line without newline
+        line = pending;
+        pending.clear();
+        return true;
+      }
+    }
+  }
+}
+
+bool BatchJobs::next(string& job) {
+  while(readLine(job)){
+    size_t first = job.find_first_not_of(" \t\r");
+    if(first == string::npos || job[first] == '#')
+      continue;
+    size_t last = job.find_last_not_of(" \t\r");
+    job = job.substr(first, last - first + 1);
+    if(job == "quit"){
+      if(server_fd >= 0)
+        return false;
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
+
+void BatchJobs::report(const string& result) {
+  if(server_fd < 0){
+    cout << result << endl;
+    return;
+  }
+  if(client_fd < 0) //client has already disconnected
+    return;
+  string msg = result + "\n";
+  size_t sent = 0;
+  while(sent < msg.size()){
+    ssize_t n = write(client_fd, msg.c_str() + sent, msg.size() - sent);
+    if(n < 0){
+      if(errno == EINTR)
+        continue;
+      closeClient();
+      return;
+    }
+    sent += n;
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __BATCH_JOBS__
+#define __BATCH_JOBS__
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "../exceptions/ioexception.h"
+
+using namespace std;
+using namespace DeSyDe;
+
+/**
+ * Source of the jobs of a batch run. A job is one line with the same syntax
+ * as the command line of adse (without the program name); empty lines and
+ * lines starting with '#' are skipped.
+ *
+ * The jobs are read either from a file (or stdin) or from the clients of a
+ * Unix domain socket. In the latter case, each client connection sends job
+ * lines and receives the result line of each of its jobs; the line "quit"
+ * stops the server.
+ */
+class BatchJobs {
+public:
+  /**
+   * @param file job list, "-" for stdin (ignored if socket is given)
+   * @param socket path of the Unix domain socket to serve
+   */
+  BatchJobs(const string& file, const string& socket) throw (IOException);
+  ~BatchJobs();
+
+  /**
+   * Gets the next job. Blocks until a client sends one in server mode.
+   * Returns false when no more jobs will come.
+   */
+  bool next(string& job);
+  /**
+   * Reports the result of the current job to its source: stdout for a
+   * file, the connection of the client for a socket.
+   */
+  void report(const string& result);
+  /**
+   * Splits a job line into arguments, the first being the program name.
+   */
+  static vector<string> arguments(const string& job);
+
+private:
+  ifstream file;
+  bool from_stdin;
+  string socket_path;
+  int server_fd;
+  int client_fd;
+  string pending; //received but not yet complete lines of the client
+
+  bool readLine(string& line);
+  bool acceptClient();
+  void closeClient();
+};
+
+#endif
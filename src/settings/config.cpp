@@ -62,7 +62,7 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
   po::options_description hidden;
   hidden.add_options()
       ("inputs,i",
-          po::value<vector<string>>()->multitoken()->required()
+          po::value<vector<string>>()->multitoken()
           ->notifier(boost::bind(&Config::setInputPaths, this, _1)),
           "input file or path. Multiple paths allowed.");
 
@@ -82,6 +82,48 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
           po::value<string>()->implicit_value("")->notifier(
               boost::bind(&Config::setTDNconfig, this, _1)),
           "provides a minimal TDN-configuration for the provided platform model that works for all-to-all communication.")
+      ("batch",
+          po::value<string>()->notifier(
+              boost::bind(&Config::setBatchPath, this, _1)),
+          "runs the jobs listed in a file (\"-\" for stdin), one per line, with the same syntax "
+          "as the command line. Parsed inputs are kept in memory between jobs.")
+      ("batch-socket",
+          po::value<string>()->notifier(
+              boost::bind(&Config::setBatchSocket, this, _1)),
+          "like --batch, but serves the jobs sent to a Unix domain socket at the given path. "
+          "Each connection sends job lines and receives one result line per job.")
+      ("snapshot-dir",
+          po::value<string>()->notifier(
+              boost::bind(&Config::setSnapshotDir, this, _1)),
+          "directory for binary snapshots of the parsed platform, SDF graphs and WCET tables. "
+          "Runs with unchanged inputs load the snapshots instead of the XML files.")
+      ("telemetry",
+          po::value<unsigned long int>()->implicit_value(1000)->notifier(
+              boost::bind(&Config::setTelemetry, this, _1)),
+          "samples the search statistics, the best objective values and the resident memory "
+          "every given number of ms (default 1000) into out/telemetry.csv.")
+      ("checkpoint",
+          po::value<unsigned long int>()->implicit_value(60000)->notifier(
+              boost::bind(&Config::setCheckpoint, this, _1)),
+          "saves the best solution, its objective values, the solutions found so far and the search "
+          "statistics every given number of ms (default 60000) to out/checkpoint.bin.")
+      ("resume",
+          po::bool_switch()->notifier(
+              boost::bind(&Config::setResume, this, _1)),
+          "continues an optimizing search from out/checkpoint.bin: only solutions better than the "
+          "saved one are searched, and the results of the earlier run are kept.")
+      ("profile-model",
+          po::bool_switch()->notifier(
+              boost::bind(&Config::setProfileModel, this, _1)),
+          "reports the time, propagators, branchers, memory and variables of each block of "
+          "constraints of the model, in out/out.txt and out/model_profile.csv.")
+      ("group-firings",
+          po::bool_switch()->notifier(
+              boost::bind(&Config::setGroupFirings, this, _1)),
+          "models each actor of a multi-rate SDF graph as one entity that executes all its "
+          "firings of an iteration in a row, instead of one entity per firing of the HSDF expansion. "
+          "The model grows with the number of actors, not firings, but the firings of an actor "
+          "share a processor and run back to back.")
       ("output,o",
           po::value<string>()->default_value(".")->notifier(
               boost::bind(&Config::setOutputPaths, this, _1)),
@@ -99,12 +141,24 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
           po::value<string>()->default_value(string("ALL_OUT"))->notifier(
               boost::bind(&Config::setOutputFileType, this, _1)),
           "Output file type.\n"
-          "Valid options ALL, CSV, TXT, XML. ")
+          "Valid options ALL, CSV, TXT, XML, BIN. BIN writes the mapping, schedules, modes, TDMA slots, "
+          "period and power of each solution into the columnar binary file out/solutions.bin, "
+          "which bin/solutions2csv reads.")
       ("output-print-frequency",
           po::value<string>()->default_value(string("ALL_SOL"))->notifier(
               boost::bind(&Config::setOutputPrintFrequency, this, _1)),
           "Frequency of printing output.\n"
           "Valid options ALL, LAST, Every_n, FIRSTandLAST. ") 
+      ("output-queue",
+          po::value<unsigned long int>()->default_value(1024)->notifier(
+              boost::bind(&Config::setOutputQueue, this, _1)),
+          "number of solutions buffered for the writer thread, which formats and writes all solutions "
+          "(output-print-frequency ALL) off the search thread. 0 writes them in the search thread.")
+      ("output-delta",
+          po::bool_switch()->notifier(
+              boost::bind(&Config::setOutputDelta, this, _1)),
+          "stores the columns of out/solutions.bin (output-file-type BIN) as differences to the "
+          "previous solution, which are mostly 0 when enumerating all solutions.")
       ("print-metric",
           po::value<vector<string>>()->multitoken()->default_value({"NONE",""},
               "NONE ")->notifier(boost::bind(&Config::setPrintMetrics, this, _1)),
@@ -137,7 +191,12 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
         po::value<vector<unsigned long int>>()->multitoken()->default_value({0,0},
             "0 0")->notifier(boost::bind(&Config::setTimeout_presolver, this, _1)),
         "search timeout. 0 means infinite. If two values are provided, the first one specifies "
-        "the timeout for the first solution, and the second one for incremental time-out which is reset after each found solution.");
+        "the timeout for the first solution, and the second one for incremental time-out which is reset after each found solution.")
+    ("presolver.probe_timeout",
+        po::value<unsigned long int>()->default_value(0)->notifier(
+            boost::bind(&Config::setProbeTimeout_presolver, this, _1)),
+        "timeout for checking one presolver solution in the full model. 0 means infinite. "
+        "The checks run in parallel on dse.threads workers (0=all procs).");
 
   po::options_description dse("DSE options");
   dse.add_options()
@@ -149,8 +208,10 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
       ("dse.search",
           po::value<string>()->default_value(string("NONESEARCH"))->notifier(
               boost::bind(&Config::setSearch, this, _1)),
-          "Search type.\n"
-          "Valid options NONESEARCH, FIRST, ALL, OPTIMIZE, OPTIMIZE_IT, GIST_ALL, GIST_OPT. ")
+          "Search type. PORTFOLIO runs dse.threads differently configured optimizing searches in parallel. "
+          "PARETO searches the Pareto front of all dse.criteria (on dse.threads workers) and writes it to out/pareto_front.csv. "
+          "LNS improves the first solution by large neighbourhood search on dse.threads workers.\n"
+          "Valid options NONESEARCH, FIRST, ALL, OPTIMIZE, OPTIMIZE_IT, GIST_ALL, GIST_OPT, PORTFOLIO, PARETO, LNS. ")
       ("dse.criteria",
           po::value<vector<string>>()->multitoken()->default_value({"NONE",""},
               "NONE ")->notifier(boost::bind(&Config::setCriteria, this, _1)),
@@ -173,6 +234,10 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
           po::value<unsigned long int>()->default_value(0)->notifier(
               boost::bind(&Config::setLubyScale, this, _1)),
           "Luby scale")      
+      ("dse.lns_fails",
+          po::value<unsigned long int>()->default_value(500)->notifier(
+              boost::bind(&Config::setLNSFails, this, _1)),
+          "Fail limit of the search in one neighbourhood (LNS search).")
       ("dse.th_prop",
           po::value<string>()->default_value(string("SSE"))->notifier(
               boost::bind(&Config::setThPropagator, this, _1)),
@@ -227,6 +292,8 @@ int Config::parse(int argc, const char** argv) throw (IOException, InvalidArgume
   } catch (po::error& ex) {
     THROW_EXCEPTION(IOException,"CLI",ex.what());
   }
+  if (settings_.inputs_paths.empty() && !doBatch())
+    THROW_EXCEPTION(IOException,"CLI","the option '--inputs' is required but missing");
 
   if (loaded_cfg_file)
     LOG_DEBUG("Loaded initial configuration from \'" + conf_path + "\'");
@@ -262,6 +329,7 @@ string Config::printSettings() {
       + "\n* no of threads : " + tools::toString(settings_.threads)
       + "\n* no good depth : " + tools::toString(settings_.noGoodDepth)
       + "\n* luby_scale : " + tools::toString(settings_.luby_scale)
+      + "\n* LNS fail limit : " + tools::toString(settings_.lns_fails)
       + "\n* throughput propagator : " + tools::toString(settings_.th_prop);
 }
 
@@ -332,6 +400,50 @@ void Config::setInputPaths(const vector<string> & paths) throw (IOException) {
   }
 }
 
+void Config::setBatchPath(const string &path) throw (IOException) {
+  if (path != "-" && !ifstream(path.c_str()))
+    THROW_EXCEPTION(IOException,path,"cannot read batch file");
+  settings_.batch_path = path;
+}
+
+void Config::setBatchSocket(const string &path) throw () {
+  settings_.batch_socket = path;
+}
+
+void Config::setSnapshotDir(const string &path) throw (IOException) {
+  if (!tools::isAccessible(path))
+    THROW_EXCEPTION(IOException,path,"snapshot directory is not accessible");
+  settings_.snapshot_dir = path;
+}
+
+void Config::setTelemetry(unsigned long int interval) throw () {
+  settings_.telemetry_interval = interval;
+}
+
+void Config::setCheckpoint(unsigned long int interval) throw () {
+  settings_.checkpoint_interval = interval;
+}
+
+void Config::setResume(bool resume) throw () {
+  settings_.resume = resume;
+}
+
+void Config::setOutputQueue(unsigned long int size) throw () {
+  settings_.out_queue = size;
+}
+
+void Config::setOutputDelta(bool delta) throw () {
+  settings_.out_delta = delta;
+}
+
+void Config::setProfileModel(bool profile) throw () {
+  settings_.profile_model = profile;
+}
+
+void Config::setGroupFirings(bool group) throw () {
+  settings_.group_firings = group;
+}
+
 void Config::setTDNconfig(const string &p){
   settings_.configTDN = true;
 }
@@ -389,6 +501,9 @@ Config::SearchTypes stringToSearch (const string &str) throw (InvalidFormatExcep
   else if (str == "OPTIMIZE_IT") return Config::OPTIMIZE_IT;
   else if (str == "GIST_ALL")    return Config::GIST_ALL;
   else if (str == "GIST_OPT")    return Config::GIST_OPT;
+  else if (str == "PORTFOLIO")   return Config::PORTFOLIO;
+  else if (str == "PARETO")      return Config::PARETO;
+  else if (str == "LNS")         return Config::LNS;
   else THROW_EXCEPTION(InvalidFormatException, str, "invalid option");
 }
 
@@ -421,6 +536,7 @@ Config::OutputFileType stringToOutputFileType(const string &str) throw (InvalidF
   else if (str == "CSV_MOST")    return Config::CSV_MOST;
   else if (str == "TXT")         return Config::TXT;
   else if (str == "XML")         return Config::XML;
+  else if (str == "BIN")         return Config::BIN;
   else THROW_EXCEPTION(InvalidFormatException, str, "invalid option");
 }
 void Config::setOutputFileType(const string &str) throw (InvalidFormatException) {
@@ -454,6 +570,9 @@ string searchTypeToString(Config::SearchTypes freq) throw (InvalidFormatExceptio
   else if (freq == Config::OPTIMIZE_IT) return "OPTIMIZE_IT";
   else if (freq == Config::GIST_ALL)    return "GIST_ALL";
   else if (freq == Config::GIST_OPT)    return "GIST_OPT";
+  else if (freq == Config::PORTFOLIO)   return "PORTFOLIO";
+  else if (freq == Config::PARETO)      return "PARETO";
+  else if (freq == Config::LNS)         return "LNS";
   else THROW_EXCEPTION(InvalidFormatException, "searchTypeToString", "invalid option");
 }
 string Config::get_search_type() const {
@@ -507,6 +626,9 @@ void Config::setTimeout(const vector<unsigned long int> &touts) throw (IllegalSt
   }
 }
 
+void Config::setProbeTimeout_presolver(unsigned long int tout) throw () {
+  settings_.pre_probe_timeout = tout;
+}
 void Config::setThreads(unsigned int _t) throw () {
   settings_.threads = _t;
 }
@@ -519,6 +641,10 @@ void Config::setLubyScale(unsigned long int scale) throw () {
   settings_.luby_scale = scale;
 }
 
+void Config::setLNSFails(unsigned long int fails) throw () {
+  settings_.lns_fails = fails;
+}
+
 void Config::setPresolverModel(const vector<string> &str) throw (InvalidFormatException) {
   for (string s : str)
     if (s.length() != 0)
@@ -554,7 +680,9 @@ shared_ptr<Config::PresolverResults> Config::getPresolverResults(){
   return pre_results;
 }
 bool Config::doOptimize() const {
-  if (settings().search == Config::OPTIMIZE || settings().search == Config::OPTIMIZE_IT || settings().search == Config::GIST_OPT) {
+  if (settings().search == Config::OPTIMIZE || settings().search == Config::OPTIMIZE_IT || settings().search == Config::GIST_OPT
+      || settings().search == Config::PORTFOLIO || settings().search == Config::PARETO
+      || settings().search == Config::LNS) {
     return true;
   }
   return false;
@@ -596,6 +724,10 @@ bool Config::doMultiStep() const{
   return false;
 }
 
+bool Config::doBatch() const{
+  return !settings_.batch_path.empty() || !settings_.batch_socket.empty();
+}
+
 bool Config::doPresolve() const{
   for(auto i : settings_.pre_models){
     if(i > NO_PRE) return true;
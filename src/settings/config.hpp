@@ -75,7 +75,8 @@ public:
       TXT,
       CSV,
       CSV_MOST,
-      XML
+      XML,
+      BIN /**< columnar binary file out/solutions.bin, see tools::SolutionFileWriter. */
   };
   enum OutputPrintFrequency {
       ALL_SOL,
@@ -98,7 +99,10 @@ public:
     OPTIMIZE,
     OPTIMIZE_IT,
     GIST_ALL,
-    GIST_OPT
+    GIST_OPT,
+    PORTFOLIO,
+    PARETO,
+    LNS
   };
   enum OptCriterion {
     NONE,
@@ -122,16 +126,28 @@ public:
     unsigned long int         timeout_all;
     unsigned long int         pre_timeout_first;
     unsigned long int         pre_timeout_all;
+    unsigned long int         pre_probe_timeout;
 
     unsigned long int         luby_scale;
     unsigned int              threads;
     unsigned long int         noGoodDepth;
+    unsigned long int         lns_fails;   /**< fail limit of the search in one LNS neighbourhood. */
     ThroughputPropagator      th_prop;
     OutputFileType            out_file_type;
     OutputPrintFrequency      out_print_freq;
     std::vector<OptCriterion> printMetrics;
     
     bool                      configTDN=false;
+    std::string               batch_path;   /**< job list of a batch run, "-" for stdin. */
+    std::string               batch_socket; /**< Unix socket of a batch server. */
+    std::string               snapshot_dir; /**< directory of input snapshots, empty: none. */
+    bool                      profile_model=false; /**< report the size of the constraint blocks. */
+    bool                      group_firings=false; /**< one entity per SDF actor instead of per firing. */
+    unsigned long int         telemetry_interval=0; /**< ms between search telemetry samples, 0: off. */
+    unsigned long int         checkpoint_interval=0; /**< ms between checkpoints of the search, 0: off. */
+    bool                      resume=false; /**< continue the search from out/checkpoint.bin. */
+    unsigned long int         out_queue=1024; /**< solutions buffered for the writer thread, 0: written by the search thread. */
+    bool                      out_delta=false; /**< delta-encode the columns of out/solutions.bin. */
   };
   struct PresolverResults{
     size_t it_mapping; /**< Informs the CP model how to use oneProcMappings: <.size(): Enforce mapping, >=.size() Forbid all. */
@@ -139,6 +155,7 @@ public:
     vector<SolutionValues> optResults;
     vector<SolutionValues> printResults;
     std::chrono::high_resolution_clock::duration presolver_delay;
+    vector<std::chrono::high_resolution_clock::duration> worker_delays; /**< time each presolver worker spent checking solutions. */
   };
 
 public:
@@ -183,6 +200,7 @@ public:
   bool doOptimizePower(size_t step) const;
   bool doMultiStep() const;
   bool doPresolve() const;
+  bool doBatch() const;
   bool is_presolved();
   string get_out_freq() const;
   string get_search_type() const;
@@ -195,6 +213,16 @@ private:
 
   void setInputPaths(const std::vector<std::string> &) throw (IOException);
   void setTDNconfig(const string &p);
+  void setBatchPath(const std::string &) throw (IOException);
+  void setBatchSocket(const std::string &) throw ();
+  void setSnapshotDir(const std::string &) throw (IOException);
+  void setProfileModel(bool) throw ();
+  void setGroupFirings(bool) throw ();
+  void setTelemetry(unsigned long int) throw ();
+  void setCheckpoint(unsigned long int) throw ();
+  void setResume(bool) throw ();
+  void setOutputQueue(unsigned long int) throw ();
+  void setOutputDelta(bool) throw ();
   void setOutputPaths(const std::string &) throw (IOException);
   void setLogPaths(const std::string &) throw (IOException);
   void setLogLevel(const std::vector<std::string> &) throw (IllegalStateException, InvalidFormatException);
@@ -205,9 +233,11 @@ private:
   void setThPropagator(const std::string &) throw (InvalidFormatException);
   void setTimeout(const std::vector<unsigned long int> &) throw (IllegalStateException);
   void setTimeout_presolver(const std::vector<unsigned long int> &) throw (IllegalStateException);
+  void setProbeTimeout_presolver(unsigned long int) throw ();
   void setThreads(unsigned int) throw ();
   void setNoGoodDepth(unsigned long int) throw ();
   void setLubyScale(unsigned long int) throw ();
+  void setLNSFails(unsigned long int) throw ();
   void setPresolverModel(const std::vector<std::string> &) throw (InvalidFormatException);
   void setHeuristic(const std::vector<std::string> &) throw (InvalidFormatException);
   void setPresolverSearch(const std::string &) throw (InvalidFormatException);
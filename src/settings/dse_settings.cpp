@@ -56,6 +56,15 @@ string DSESettings::getSearchTypeString() const {
   case Config::GIST_OPT:
     searchStr = "GIST_OPT";
     break;
+  case Config::PORTFOLIO:
+    searchStr = "PORTFOLIO";
+    break;
+  case Config::PARETO:
+    searchStr = "PARETO";
+    break;
+  case Config::LNS:
+    searchStr = "LNS";
+    break;
   default:
     cout << "unknown search type !!!";
     break;
@@ -91,7 +100,8 @@ int DSESettings::getOptCriterion() const {
 }
 
 bool DSESettings::doOptimize() const {
-  if (search == Config::OPTIMIZE || search == Config::OPTIMIZE_IT || search == Config::GIST_OPT) {
+  if (search == Config::OPTIMIZE || search == Config::OPTIMIZE_IT || search == Config::GIST_OPT
+      || search == Config::PORTFOLIO || search == Config::PARETO || search == Config::LNS) {
     return true;
   }
   return false;
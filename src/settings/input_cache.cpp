@@ -0,0 +1,216 @@
+#include "input_cache.hpp"
+
+#include <sstream>
+#include <iomanip>
+#include <boost/filesystem/operations.hpp>
+
+namespace fs = boost::filesystem;
+
+InputCache::InputCache() : n_hits(0), n_misses(0), n_snapshotHits(0), n_snapshotWrites(0) {}
+
+InputCache::~InputCache() {
+  for(auto& e : graphs){
+    delete e.second.graph;
+    delete e.second.doc;
+  }
+  for(auto& e : platforms){
+    delete e.second.object;
+  }
+  for(auto& e : documents){
+    delete e.second.object;
+  }
+}
+
+void InputCache::setSnapshotDir(const string& dir) {
+  snapshot_dir = dir;
+}
+
+time_t InputCache::modified(const string& path) const {
+  return fs::last_write_time(fs::path(path));
+}
+
+uint64_t InputCache::contentHash(const string& path) {
+  time_t t = modified(path);
+  auto it = hashes.find(path);
+  if(it != hashes.end() && it->second.first == t)
+    return it->second.second;
+  uint64_t h = tools::hashFile(path);
+  hashes[path] = make_pair(t, h);
+  return h;
+}
+
+string InputCache::snapshotPath(const string& kind, uint64_t hash) const {
+  stringstream ss;
+  ss << snapshot_dir << "/" << kind << "-" << hex << setw(16) << setfill('0') << hash << ".snap";
+  return ss.str();
+}
+
+XMLdoc* InputCache::document(const string& path) {
+  time_t t = modified(path);
+  auto it = documents.find(path);
+  if(it != documents.end() && it->second.modified == t){
+    n_hits++;
+    return it->second.object;
+  }
+  n_misses++;
+  XMLdoc* doc = new XMLdoc(path);
+  doc->read(false);
+  if(it != documents.end()){
+    delete it->second.object;
+    documents.erase(it);
+  }
+  documents[path] = Entry<XMLdoc>{t, doc};
+  return doc;
+}
+
+Platform* InputCache::platform(const string& path) {
+  time_t t = modified(path);
+  auto it = platforms.find(path);
+  if(it != platforms.end() && it->second.modified == t){
+    n_hits++;
+    return it->second.object;
+  }
+  n_misses++;
+  Platform* p = nullptr;
+  if(!snapshot_dir.empty()){
+    string snap_path = snapshotPath("platform", contentHash(path));
+    tools::SnapshotReader snap;
+    if(snap.open(snap_path, "platform")){
+      p = new Platform(snap);
+      n_snapshotHits++;
+      LOG_DEBUG("Restored platform from snapshot " + snap_path);
+    }else{
+      p = new Platform(*document(path));
+      try {
+        tools::SnapshotWriter out(snap_path, "platform");
+        p->save(out);
+        out.commit();
+        n_snapshotWrites++;
+      } catch (IOException& ex) {
+        LOG_WARNING("Could not write snapshot: " + ex.toString());
+      }
+    }
+  }else{
+    p = new Platform(*document(path));
+  }
+  if(it != platforms.end()){
+    delete it->second.object;
+    platforms.erase(it);
+  }
+  platforms[path] = Entry<Platform>{t, p};
+  return p;
+}
+
+SDFGraph* InputCache::sdfGraph(const string& path, bool groupFirings) {
+  time_t t = modified(path);
+  auto it = graphs.find(path);
+  if(it != graphs.end() && it->second.modified == t && it->second.grouped == groupFirings){
+    n_hits++;
+    it->second.graph->setPeriodConstraint(0);
+    it->second.graph->setLatencyConstraint(0);
+    return it->second.graph;
+  }
+  n_misses++;
+  XMLdoc* doc = new XMLdoc(path);
+  SDFGraph* g = nullptr;
+  if(!snapshot_dir.empty()){
+    string kind = groupFirings ? "sdf-grouped" : "sdf";
+    string snap_path = snapshotPath(kind, contentHash(path));
+    tools::SnapshotReader snap;
+    if(snap.open(snap_path, kind)){
+      g = new SDFGraph(*doc, snap); //doc is not read
+      n_snapshotHits++;
+      LOG_DEBUG("Restored SDF graph from snapshot " + snap_path);
+    }else{
+      doc->readXSD("sdf3", "noNamespaceSchemaLocation");
+      g = new SDFGraph(*doc, groupFirings);
+      try {
+        tools::SnapshotWriter out(snap_path, kind);
+        g->save(out);
+        out.commit();
+        n_snapshotWrites++;
+      } catch (IOException& ex) {
+        LOG_WARNING("Could not write snapshot: " + ex.toString());
+      }
+    }
+  }else{
+    doc->readXSD("sdf3", "noNamespaceSchemaLocation");
+    g = new SDFGraph(*doc, groupFirings);
+  }
+  if(it != graphs.end()){
+    delete it->second.graph;
+    delete it->second.doc;
+    graphs.erase(it);
+  }
+  graphs[path] = GraphEntry{t, doc, g, groupFirings};
+  return g;
+}
+
+uint64_t InputCache::wcetKey(const string& path, Applications* program, Platform* platform) {
+  uint64_t h = contentHash(path);
+  string layout;
+  for(size_t i = 0; i < program->n_programEntities(); i++){
+    layout += program->getType(i) + ':' + tools::toString(program->getFirings(i)) + '\n';
+  }
+  for(size_t j = 0; j < platform->nodes(); j++){
+    layout += platform->getProcModel(j) + ':';
+    for(size_t k = 0; k < platform->getModes(j); k++){
+      layout += platform->getProcModelMode(j, k) + ',';
+    }
+    layout += '\n';
+  }
+  return tools::hashString(layout, h);
+}
+
+const vector<vector<vector<int>>>* InputCache::wcetTable(const string& path, Applications* program, Platform* platform) {
+  uint64_t key = wcetKey(path, program, platform);
+  auto it = wcets.find(key);
+  if(it != wcets.end()){
+    n_hits++;
+    return &it->second;
+  }
+  if(!snapshot_dir.empty()){
+    string snap_path = snapshotPath("wcets", key);
+    tools::SnapshotReader snap;
+    if(snap.open(snap_path, "wcets")){
+      snap.get(wcets[key]);
+      n_snapshotHits++;
+      LOG_DEBUG("Restored WCET table from snapshot " + snap_path);
+      return &wcets[key];
+    }
+  }
+  return nullptr;
+}
+
+void InputCache::storeWCETTable(const string& path, Applications* program, Platform* platform,
+                                const vector<vector<vector<int>>>& table) {
+  n_misses++;
+  uint64_t key = wcetKey(path, program, platform);
+  wcets[key] = table;
+  if(!snapshot_dir.empty()){
+    try {
+      tools::SnapshotWriter out(snapshotPath("wcets", key), "wcets");
+      out.put(table);
+      out.commit();
+      n_snapshotWrites++;
+    } catch (IOException& ex) {
+      LOG_WARNING("Could not write snapshot: " + ex.toString());
+    }
+  }
+}
+
+size_t InputCache::hits() const {
+  return n_hits;
+}
+
+size_t InputCache::misses() const {
+  return n_misses;
+}
+
+size_t InputCache::snapshotHits() const {
+  return n_snapshotHits;
+}
+
+size_t InputCache::snapshotWrites() const {
+  return n_snapshotWrites;
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __INPUT_CACHE__
+#define __INPUT_CACHE__
+
+#include <map>
+#include <string>
+#include <ctime>
+
+#include "../xml/xmldoc.hpp"
+#include "../platform/platform.hpp"
+#include "../applications/sdfgraph.hpp"
+#include "../applications/applications.hpp"
+
+using namespace std;
+
+/**
+ * Keeps parsed input files and the objects built from them between the jobs
+ * of a batch run, so that the XML parsing and the construction of the
+ * platform (TDN graph, route table) and the SDF graphs (HSDF expansion) are
+ * paid once. Entries are keyed by file path and rebuilt when the
+ * modification time of the file changes.
+ *
+ * If a snapshot directory is set, the built platforms, SDF graphs and WCET
+ * tables are also stored there as binary snapshots named by the hash of the
+ * file content. A later process with unchanged inputs restores them from
+ * the (memory-mapped) snapshots without invoking the XML parser.
+ */
+class InputCache {
+public:
+  InputCache();
+  ~InputCache();
+
+  /**
+   * Returns the document of an XML file, read with XMLdoc::read.
+   */
+  XMLdoc* document(const string& path);
+  /**
+   * Returns the platform described in an XML file.
+   */
+  Platform* platform(const string& path);
+  /**
+   * Returns the SDF graph of an SDF3 file. The design constraints
+   * (period, latency) are reset, since each job sets its own.
+   * @param groupFirings see SDFGraph::transformGrouped
+   */
+  SDFGraph* sdfGraph(const string& path, bool groupFirings = false);
+  /**
+   * Returns the WCET table [entity][proc][mode] loaded earlier from the WCET
+   * file for the same program entity types and processor models, or nullptr.
+   */
+  const vector<vector<vector<int>>>* wcetTable(const string& path, Applications* program, Platform* platform);
+  /**
+   * Keeps the WCET table loaded from a WCET file for later wcetTable calls.
+   */
+  void storeWCETTable(const string& path, Applications* program, Platform* platform,
+                      const vector<vector<vector<int>>>& table);
+
+  /**
+   * Returns the hash of the content of a file, recomputed when the
+   * modification time of the file changes.
+   */
+  uint64_t contentHash(const string& path);
+
+  /**
+   * Sets the directory for snapshots, an empty path disables them.
+   */
+  void setSnapshotDir(const string& dir);
+
+  /** number of requests served from the cache */
+  size_t hits() const;
+  /** number of requests that needed parsing */
+  size_t misses() const;
+  /** number of objects restored from snapshots */
+  size_t snapshotHits() const;
+  /** number of snapshots written */
+  size_t snapshotWrites() const;
+
+private:
+  template<class T> struct Entry {
+    time_t modified;
+    T* object;
+  };
+  struct GraphEntry {
+    time_t modified;
+    XMLdoc* doc; //the SDFGraph keeps a reference to its document
+    SDFGraph* graph;
+    bool grouped;
+  };
+
+  map<string, Entry<XMLdoc>> documents;
+  map<string, Entry<Platform>> platforms;
+  map<string, GraphEntry> graphs;
+  map<uint64_t, vector<vector<vector<int>>>> wcets; //by wcetKey
+  map<string, pair<time_t, uint64_t>> hashes; //content hash of each file
+  string snapshot_dir;
+  size_t n_hits;
+  size_t n_misses;
+  size_t n_snapshotHits;
+  size_t n_snapshotWrites;
+
+  time_t modified(const string& path) const;
+  string snapshotPath(const string& kind, uint64_t hash) const;
+  //identifies a WCET table by the WCET file and what the table is built for
+  uint64_t wcetKey(const string& path, Applications* program, Platform* platform);
+};
+
+#endif
@@ -28,7 +28,7 @@
 # MODULE PATH AND FILES
 #=======================
 
-CPP_FILES := dse_settings.cpp input_reader.cpp config.cpp
+CPP_FILES := dse_settings.cpp input_reader.cpp config.cpp input_cache.cpp batch_jobs.cpp
 
 
 
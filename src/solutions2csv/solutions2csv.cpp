@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** ! \file solutions2csv.cpp
+ \brief Reader and converter of the binary solution files.
+
+ Prints the schema of out/solutions.bin (output-file-type BIN), or converts
+ the solutions into CSV: one row per solution, one column per variable.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../tools/solution_file.hpp"
+#include "../exceptions/exception.h"
+
+using namespace std;
+
+namespace {
+
+void printInfo(const tools::SolutionFileReader& in, ostream& out){
+  out << in.rows() << " solutions in " << in.blocks() << " blocks"
+      << (in.deltaEncoded() ? ", delta-encoded" : "") << "\n";
+  for(auto& c : in.columns()){
+    out << "  " << c.name << ": " << c.count << " x " << c.width << " bytes, values in ["
+        << c.lo << ", " << c.hi << "]\n";
+  }
+}
+
+void printCSV(const tools::SolutionFileReader& in, ostream& out){
+  bool first = true;
+  for(auto& c : in.columns()){
+    for(int e = 0; e < c.count; e++){
+      out << (first ? "" : ",") << c.name;
+      if(c.count > 1)
+        out << "_" << e;
+      first = false;
+    }
+  }
+  out << "\n";
+  vector<int> values;
+  for(size_t b = 0; b < in.blocks(); b++){
+    size_t rows = in.readBlock(b, values);
+    for(size_t r = 0; r < rows; r++){
+      for(size_t k = 0; k < in.rowWidth(); k++){
+        if(k > 0)
+          out << ",";
+        out << values[r * in.rowWidth() + k];
+      }
+      out << "\n";
+    }
+  }
+}
+
+}
+
+int main(int argc, const char* argv[]) {
+  vector<string> args(argv + 1, argv + argc);
+  bool info = !args.empty() && args[0] == "--info";
+  if(info)
+    args.erase(args.begin());
+  if(args.empty() || args.size() > 2){
+    cout << "usage: solutions2csv [--info] <solutions.bin> [<out.csv>]\n"
+         << "  converts the solutions into CSV (to stdout without <out.csv>),\n"
+         << "  --info prints the columns and the number of solutions.\n";
+    return 1;
+  }
+
+  try {
+    tools::SolutionFileReader in;
+    in.open(args[0]);
+    ofstream file;
+    if(args.size() == 2){
+      file.open(args[1]);
+      if(!file)
+        THROW_EXCEPTION(IOException, args[1], "cannot write file");
+    }
+    ostream& out = args.size() == 2 ? file : cout;
+    if(info){
+      printInfo(in, out);
+    }else{
+      printCSV(in, out);
+    }
+  } catch (DeSyDe::Exception& ex) {
+    cerr << ex.toString() << endl;
+    return 1;
+  }
+  return 0;
+}
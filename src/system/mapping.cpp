@@ -1,4 +1,8 @@
 #include "mapping.hpp"
+#include "../tools/response_time.hpp"
+
+#include <unordered_map>
+#include <libxml/xmlreader.h>
 
 using namespace std;
 /** Constructor for TDN configuration. Generates WCETs and mapping rules */
@@ -207,6 +211,61 @@ Mapping::Mapping(Applications* p_program, Platform* p_target, XMLdoc& p_xml_wcet
   load_mappingRules(p_xml_mapRules);
 }
 
+Mapping::Mapping(Applications* p_program, Platform* p_target, const vector<vector<vector<int>>>& p_wcets,
+                 XMLdoc* p_des_constr, XMLdoc* p_xml_mapRules) {
+  program = p_program;
+  target = p_target;
+  n_apps = program->n_SDFApps() + program->n_IPTTasks();
+  period.assign(n_apps, 0);
+  initLatency.assign(n_apps, 0);
+  proc_modes.assign(p_target->nodes(), 0);
+  proc_period.assign(p_target->nodes(), 0);
+  proc_utilization.assign(p_target->nodes(), 0);
+  proc_energy.assign(p_target->nodes(), 0);
+  proc_area.assign(p_target->nodes(), 0);
+  proc_cost.assign(p_target->nodes(), 0);
+  memLoad.assign(p_target->nodes(), 0);
+  procsUsed_utilization = 0;
+  sys_utilization = 0;
+  sys_energy = 0;
+  sys_cost = 0;
+
+  if(p_wcets.size() != program->n_programEntities()){
+    THROW_EXCEPTION(InvalidArgumentException,"WCET table does not match the applications\n");
+  }
+  for (size_t i=0; i<p_wcets.size(); i++){
+    if(p_wcets[i].size() != target->nodes()){
+      THROW_EXCEPTION(InvalidArgumentException,"WCET table does not match the platform\n");
+    }
+    for (size_t j=0; j<target->nodes(); j++){
+      if(p_wcets[i][j].size() != target->getModes(j)){
+        THROW_EXCEPTION(InvalidArgumentException,"WCET table does not match the platform\n");
+      }
+    }
+  }
+  wcets = p_wcets;
+
+  mappingRules_do.insert(mappingRules_do.end(), program->n_programEntities(), -1);
+  mappingRules_doNot.insert(mappingRules_doNot.end(), program->n_programEntities(), vector<int>());
+
+  commSched.insert(commSched.end(), p_target->nodes(), vector<int>());
+  //initialize buffers
+  send_buff.assign(program->n_programChannels(), 0);
+  rec_buff.assign(program->n_programChannels(), 0);
+  comm_delay.assign(program->n_programChannels(), div_t());
+
+  maxIterationsTransPhEntity.assign(p_program->n_programEntities(), 1);
+  maxIterationsTransPhChannel.assign(p_program->n_programChannels(), 1);
+
+  sysConstr = SystemConstraints{0, 0, 0, 0, 0};
+  if(p_des_constr){
+    load_designConstraints(*p_des_constr);
+  }
+  if(p_xml_mapRules){
+    load_mappingRules(*p_xml_mapRules);
+  }
+}
+
 /*Mapping::Mapping(Applications* p_program, Platform* p_target, 
   vector<vector<int>>& p_mappingSched, vector<int>& p_slots,
   vector<int>& p_memLoad, vector<vector<SDFChannel*>>& p_msgOrder){
@@ -225,54 +284,78 @@ Mapping::Mapping(Applications* p_program, Platform* p_target, XMLdoc& p_xml_wcet
   }*/
 
 Mapping::~Mapping() {
-  delete program;
-  delete target;
+  //the applications and the platform belong to the caller (possibly the InputCache)
 }
 
 void Mapping::load_wcets(XMLdoc& xml){
-  //ofstream out; 
-  //out.open("./WCETsTODAES_tradeoff.xml");
-  //double scale[] = {1.6, 1.2, 1.0, 0.8, 0.4};
-  //string scalename[] = {"mode1", "mode2", "mode3", "mode4", "mode5"}; 
-  
-  //out << "<WCET_table>" << endl;
-  const char* my_xpathString = "///WCET_table/mapping";
-	LOG_DEBUG("running xpathString  " + tools::toString(my_xpathString) + " on WCET file ...");
-	auto xml_mappings = xml.xpathNodes(my_xpathString);
-	for (const auto& map : xml_mappings)
-	{
-		string task_type = xml.getProp(map, "task_type");
-    LOG_DEBUG("Reading mapping for task type: " + task_type + "...");
-    
-    //out << "\t<mapping task_type=\"" + task_type << "\">" << endl;
-    
-    /// Parsing the modes
-    string query = "///WCET_table/mapping[@task_type=\'" + task_type + "\']/wcet";
-    auto   proc_mappings = xml.xpathNodes(query.c_str());
-    for (auto p : proc_mappings) {
-      
-      string proc_type = xml.getProp(p, "processor");
-      string proc_mode = xml.getProp(p, "mode");
-      string task_wcet = xml.getProp(p, "wcet");
-      
-      setWCETs(task_type, proc_type, proc_mode, atoi(task_wcet.c_str()));
-        
-      //if(proc_type == "small" && proc_mode == "default"){
-        //for(size_t i=0; i<(sizeof(scale)/sizeof(double)); i++){
-          //out << "\t\t<wcet processor=\"" << "default";
-          //out << "\" mode=\"" << scalename[i];
-          //out << "\" wcet=\"" << ceil(scale[i]*atoi(task_wcet.c_str()));
-          //out << "\"/>" << endl;
-        //}
-      //}
-        
-      LOG_DEBUG("Proc: " + proc_type + ", proc_mode: " + proc_mode 
-                 + ", WCET: " + tools::toString(atoi(task_wcet.c_str())));		
+  //hash indices from names to ids, instead of comparing names for each entry
+  unordered_map<string, vector<size_t>> entitiesOfType;
+  for (size_t i = 0; i < program->n_programEntities(); i++){
+    entitiesOfType[program->getType(i)].push_back(i);
+  }
+  unordered_map<string, vector<pair<size_t,size_t>>> procModes; //"model\nmode" -> (proc, mode)
+  for (size_t j = 0; j < target->nodes(); j++){
+    for (size_t k = 0; k < target->getModes(j); k++){
+      procModes[target->getProcModel(j) + '\n' + target->getProcModelMode(j,k)].push_back(make_pair(j, k));
     }
-    
-    //out << "\t</mapping>" << endl;
-    
-	}	
+  }
+
+  const string& path = xml.getPath();
+  LOG_DEBUG("streaming WCET table from " + path + " ...");
+  xmlTextReaderPtr reader = xmlReaderForFile(path.c_str(), NULL, 0);
+  if(reader == NULL){
+    THROW_EXCEPTION(IOException, path, "cannot open WCET file");
+  }
+  auto attribute = [&reader, &path](const char* name) -> string {
+    xmlChar* value = xmlTextReaderGetAttribute(reader, BAD_CAST name);
+    if(value == NULL){
+      xmlFreeTextReader(reader);
+      THROW_EXCEPTION(InvalidArgumentException, path + ": missing attribute " + name);
+    }
+    string str = (const char*) value;
+    xmlFree(value);
+    return str;
+  };
+
+  //element names on the path from the root to the current element
+  vector<string> path_names;
+  const vector<size_t>* entities = nullptr; //of the task type of the current mapping
+  size_t n_entries = 0;
+  int ret;
+  while((ret = xmlTextReaderRead(reader)) == 1){
+    if(xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT)
+      continue;
+    size_t depth = xmlTextReaderDepth(reader);
+    path_names.resize(depth);
+    path_names.push_back((const char*) xmlTextReaderConstLocalName(reader));
+    //same elements as the XPath ///WCET_table/mapping/wcet
+    if(depth >= 1 && path_names[depth] == "mapping" && path_names[depth-1] == "WCET_table"){
+      string task_type = attribute("task_type");
+      LOG_DEBUG("Reading mapping for task type: " + task_type + "...");
+      auto it = entitiesOfType.find(task_type);
+      entities = it != entitiesOfType.end() ? &it->second : nullptr;
+    }else if(depth >= 2 && path_names[depth] == "wcet" && path_names[depth-1] == "mapping"
+             && path_names[depth-2] == "WCET_table"){
+      n_entries++;
+      if(!entities)
+        continue;
+      auto it = procModes.find(attribute("processor") + '\n' + attribute("mode"));
+      if(it == procModes.end())
+        continue;
+      int task_wcet = atoi(attribute("wcet").c_str());
+      for (size_t i : *entities){
+        for (const auto& jk : it->second){
+          wcets[i][jk.first][jk.second] = task_wcet * program->getFirings(i);
+        }
+      }
+    }
+  }
+  xmlFreeTextReader(reader);
+  if(ret != 0){
+    THROW_EXCEPTION(IOException, path, "failed to parse WCET file");
+  }
+  LOG_DEBUG("Read " + tools::toString(n_entries) + " WCET entries.");
+
     for (size_t i=0; i < wcets.size(); i++)
     {
       bool wcetSet = false;
@@ -293,9 +376,6 @@ void Mapping::load_wcets(XMLdoc& xml){
           THROW_EXCEPTION(InvalidArgumentException,"wcet is not specified for task "+program->getName(i)+"\n");
         }
     }
-  
-  //out << "</WCET_table>";
-  //out.close();
 }
 
 bool Mapping::isMappingRules(XMLdoc& xml){
@@ -498,6 +578,33 @@ bool Mapping::homogeneousModeNodes(int nodeI, int nodeJ) {
     return true;
 }
 
+bool Mapping::interchangeableProcs() {
+  //on a mesh, the distances between the processors differ
+  if (target->getInterconnectType() == TDN_NOC && target->nodes() > 2)
+    return false;
+  return homogeneousPlatform();
+}
+
+vector<vector<int>> Mapping::processorSymmetries() {
+  vector<vector<int>> symmetries;
+  for (auto& sigma : target->meshSymmetries()) {
+    bool valid = true;
+    for (size_t i = 0; i < program->n_programEntities() && valid; i++) {
+      for (size_t j = 0; j < target->nodes() && valid; j++) {
+        valid = wcets[i][j] == wcets[i][sigma[j]];
+      }
+      if (mappingRules_do[i] > -1)
+        valid = valid && sigma[mappingRules_do[i]] == mappingRules_do[i];
+      for (int j : mappingRules_doNot[i])
+        valid = valid && find(mappingRules_doNot[i].begin(), mappingRules_doNot[i].end(), sigma[j])
+                         != mappingRules_doNot[i].end();
+    }
+    if (valid)
+      symmetries.push_back(sigma);
+  }
+  return symmetries;
+}
+
 //void Mapping::setWCETs(string name, vector<int> _wcets) {
 //	//[Nima] n_SDFActors changed to n_programEntities()
 //	for (size_t i = 0; i < program->n_programEntities(); i++) {
@@ -521,7 +628,7 @@ void Mapping::setWCETs(string taskType, string procModel, string procMode, int _
               THROW_EXCEPTION(InvalidArgumentException,"wcet out of bound\n");
             } 
             if (procMode.compare(target->getProcModelMode(j,k)) == 0) {
-              wcets[i][j][k] = _wcet;
+              wcets[i][j][k] = _wcet * program->getFirings(i);
             }
           }
         }
@@ -574,6 +681,10 @@ vector<int> Mapping::getWCETsSingleMode(unsigned actorId) const {
 }
 
 //fixed
+const vector<vector<vector<int>>>& Mapping::getWCETTable() const {
+  return wcets;
+}
+
 vector<vector<int>> Mapping::getWCETs(unsigned actorId) const {
   return wcets[actorId];
 }
@@ -1165,7 +1276,7 @@ int Mapping::LeveliWorkload(int entityID, int t) {
      */
     if (procID == current_mapping[i]
         && program->getTaskPriority(entityID)
-        < program->getTaskPriority(i)) {
+        > program->getTaskPriority(i)) {
       W += ceil((double) t / program->getTaskPeriod(i))
         * getWCET(i, current_mapping[i],
                   current_modes[current_mapping[i]]);
@@ -1175,7 +1286,6 @@ int Mapping::LeveliWorkload(int entityID, int t) {
 }
 bool Mapping::FPSchedulable() {
   const clock_t begin_time = clock();
-  bool taski;
   //program->SetRMPriorities();
 
   for (size_t k = 0; k < target->nodes(); k++) {
@@ -1195,18 +1305,23 @@ bool Mapping::FPSchedulable() {
     if (task_on_k == 0 || util <= bound) {
       // cout << "proc " << k << " is schedulable based on utilization test\n";
     } else {
+      //response time analysis, priority 0 is the highest
+      vector<pair<int, int>> hp;
       for (size_t i = program->n_SDFActors();
            i < program->n_programEntities(); i++) {
         if ((size_t)current_mapping[i] == k) {
-          taski = false;
-          for (auto t = 1; t <= program->getTaskDeadline(i); t++) //This can be improved by Bini and Buttazzo's approach
-            {
-              if (LeveliWorkload(i, t) <= t) {
-                taski = true;
-                break;
-              }
+          hp.clear();
+          for (size_t j = program->n_SDFActors();
+               j < program->n_programEntities(); j++) {
+            if ((size_t)current_mapping[j] == k
+                && program->getTaskPriority(i) > program->getTaskPriority(j)) {
+              hp.push_back(make_pair(getWCET(j, k, current_modes[k]),
+                                     program->getTaskPeriod(j)));
             }
-          if (!taski) {
+          }
+          long long R = tools::responseTime(getWCET(i, k, current_modes[k]), hp,
+                                            program->getTaskDeadline(i));
+          if (R > program->getTaskDeadline(i)) {
             schedulabilityTime = clock() - begin_time;
             cout << "processor " << k << " is not schedulable \n";
             return false;
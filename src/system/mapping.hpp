@@ -55,8 +55,8 @@ struct SystemConstraints{
 class Mapping {
 protected:
 
-  Applications* program;            /*!< Reference to the applications. */
-  Platform* target;                 /*!< Reference to the target platform. */
+  Applications* program;            /*!< Reference to the applications, not owned. */
+  Platform* target;                 /*!< Reference to the target platform, not owned. */
   SystemConstraints sysConstr;      /*!< Constraints on the system. */
   int n_apps;                       /*!< Number of applications in the mapping (=SDF apps + no. of tasks). */
   vector<vector<int>> mappingSched; /*!< The mapping, in form of a schedule of actors, for each processing element. */
@@ -126,6 +126,8 @@ protected:
   vector<int>  current_modes;   /*!< Used by validation class. */  
   
   
+  /** Reads the WCET table in a single streaming pass over the file of xml,
+      which therefore does not need to be read into memory. */
   void load_wcets(XMLdoc& xml);
   bool isMappingRules(XMLdoc& xml);
   void load_mappingRules(XMLdoc& xml);
@@ -143,6 +145,9 @@ public:
   Mapping(Applications*, Platform*, XMLdoc&);
   Mapping(Applications*, Platform*, XMLdoc&, XMLdoc&);
   Mapping(Applications*, Platform*, XMLdoc&, XMLdoc&, XMLdoc&);
+  /** Uses an already loaded WCET table (e.g. from a snapshot). The design
+      constraints and mapping rules documents are optional (nullptr). */
+  Mapping(Applications*, Platform*, const vector<vector<vector<int>>>&, XMLdoc*, XMLdoc*);
   //Mapping(Applications*, Platform*, vector<vector<int>>&, vector<int>&, vector<int>&, vector<vector<SDFChannel*>>&);
 
   ~Mapping();
@@ -250,6 +255,9 @@ public:
   in all modes */
   vector<vector<int>> getWCETs(unsigned actorId) const;
 
+  /** @return the WCET table [entity][proc][mode] */
+  const vector<vector<vector<int>>>& getWCETTable() const;
+
   /** @return WCETs of an actor on a particular processor in different modes */ 
   vector<int> getWCETs(unsigned actorId, unsigned proc) const;
   
@@ -364,6 +372,13 @@ public:
   bool homogeneousPlatform(); /*!< Determines whether the platform is homogenous. */
   bool homogeneousNodes(int nodeI, int nodeJ); /*!< Determines whether nodes nodeI and nodeJ are homogenous. */
   bool homogeneousModeNodes(int nodeI, int nodeJ); /*!< Determines whether nodes nodeI and nodeJ have the same set of modes. */
+  bool interchangeableProcs(); /*!< Determines whether any permutation of the processors is a symmetry (homogeneous, and not a mesh). */
+  /**
+   * The symmetries of the mesh (see Platform::meshSymmetries) under which
+   * the WCETs and the mapping rules of all entities are invariant, as
+   * permutations of the processor ids.
+   */
+  vector<vector<int>> processorSymmetries();
 
   void setFirstMapping(vector<div_t>& _firstMapping);
 
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Randomized comparison of HowardMCR with boost::maximum_cycle_ratio (Howard's
+ * algorithm of the boost graph library) on random MSAGs.
+ *
+ * Like the MSAGs of the throughput propagators, the graphs have a self-loop
+ * with one token on every actor, edges without tokens only in one direction
+ * (so that every cycle has tokens) and edges with tokens in both. Each graph
+ * is then modified a few times (weights, tokens, added and removed edges) and
+ * solved again with the same solver, to cover the warm start from the policy
+ * of the previous graph. For every graph, the cycle ratio must equal the one
+ * of boost and the critical cycle must be a cycle with this ratio.
+ *
+ * Usage: howard_mcr_test [number of graphs] [seed]
+ */
+
+#include "../throughput/howardMCR.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/howard_cycle_ratio.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+typedef boost::property<boost::edge_weight_t, int, boost::property<boost::edge_weight2_t, int> > EdgeProperties;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property, EdgeProperties> Graph;
+
+struct Edge {
+  int src;
+  int dst;
+  int tokens;
+  int weight;
+};
+
+//a random edge that keeps every cycle with tokens: without tokens only from a lower to a higher actor
+Edge randomEdge(mt19937& rnd, int n) {
+  Edge e;
+  e.src = rnd() % n;
+  e.dst = rnd() % n;
+  e.tokens = e.src < e.dst && rnd() % 2 ? 0 : 1 + rnd() % 3;
+  e.weight = rnd() % 100;
+  return e;
+}
+
+double boostRatio(int n, const vector<Edge>& edges) {
+  Graph g(n);
+  for(const Edge& e : edges){
+    auto added = boost::add_edge(e.src, e.dst, g).first;
+    boost::put(boost::edge_weight, g, added, e.weight);
+    boost::put(boost::edge_weight2, g, added, e.tokens);
+  }
+  return boost::maximum_cycle_ratio(g, boost::get(boost::vertex_index, g), boost::get(boost::edge_weight, g),
+                                    boost::get(boost::edge_weight2, g));
+}
+
+//checks that the critical cycle of the solver is a cycle of g with the ratio mcr
+bool checkCriticalCycle(const MSAG& g, const vector<int>& cycle, double mcr) {
+  if(cycle.empty())
+    return false;
+  long weight = 0, tokens = 0;
+  for(size_t i = 0; i < cycle.size(); i++){
+    int e = cycle[i];
+    int next = cycle[(i + 1) % cycle.size()];
+    if(e < 0 || e >= g.edges() || g.succ[e] != g.source(next))
+      return false;
+    weight += g.weight[e];
+    tokens += g.tokens[e];
+  }
+  return tokens > 0 && fabs((double) weight / tokens - mcr) < 1e-9 * max(1.0, mcr);
+}
+
+}
+
+int main(int argc, const char** argv) {
+  int n_graphs = argc > 1 ? atoi(argv[1]) : 2000;
+  unsigned int seed = argc > 2 ? atoi(argv[2]) : 1;
+  const int modifications = 5;
+  mt19937 rnd(seed);
+  int failures = 0, solved = 0;
+
+  for(int k = 0; k < n_graphs; k++){
+    int n = 1 + rnd() % 40;
+    vector<Edge> edges;
+    for(int v = 0; v < n; v++){
+      edges.push_back(Edge{v, v, 1, (int) (rnd() % 100)});
+    }
+    int n_edges = rnd() % (3 * n + 1);
+    for(int i = 0; i < n_edges; i++){
+      edges.push_back(randomEdge(rnd, n));
+    }
+
+    HowardMCR solver;
+    for(int m = 0; m <= modifications; m++){
+      if(m > 0){
+        for(int i = 0; i < 3; i++){
+          size_t e = rnd() % edges.size();
+          switch(rnd() % 4){
+          case 0:
+            edges[e].weight = rnd() % 100;
+            break;
+          case 1:
+            if(edges[e].tokens > 0)
+              edges[e].tokens = 1 + rnd() % 3;
+            break;
+          case 2:
+            edges.push_back(randomEdge(rnd, n));
+            break;
+          default:
+            if(e >= (size_t) n) //keeps the self-loops
+              edges.erase(edges.begin() + e);
+          }
+        }
+      }
+
+      MSAG g;
+      g.clear(n);
+      for(const Edge& e : edges){
+        g.addEdge(e.src, e.dst, e.tokens, e.weight);
+      }
+      g.build();
+      double mcr = solver.solve(g);
+      double expected = boostRatio(n, edges);
+      solved++;
+      if(fabs(mcr - expected) > 1e-9 * max(1.0, expected)){
+        cout << "graph " << k << ", modification " << m << ": HowardMCR gives " << mcr << ", boost " << expected << endl;
+        failures++;
+      }else if(!checkCriticalCycle(g, solver.criticalCycle(), mcr)){
+        cout << "graph " << k << ", modification " << m << ": the critical cycle does not have the ratio " << mcr << endl;
+        failures++;
+      }
+    }
+  }
+
+  cout << "howard_mcr_test: " << solved << " graphs, " << failures << " failures" << endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#!/bin/bash
+# Round trip of a checkpoint on a TDN platform (examples/DSD18/exp_2): the
+# incumbent of a checkpointed run must be a solution of the model when the
+# search is resumed. On a TDN, tdmaAlloc is not branched, so this checks that
+# unassigned variables of the incumbent are not fixed by the resumed run.
+#
+# Usage: resume_tdn_test.sh <adse binary>
+
+ADSE=$(readlink -f "${1:-../bin/adse}")
+EXAMPLE=$(dirname "$(readlink -f "$0")")/../../examples/DSD18
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+mkdir -p "$OUT/out"
+
+run() {
+  (cd "$EXAMPLE" && "$ADSE" --config exp_2/config.cfg --output "$OUT/" --log-file "$OUT/$1.log" \
+                           --log-level WARNING --log-level INFO --dse.timeout 20000 20000 "${@:2}")
+}
+
+if ! run first --checkpoint 1000; then
+  echo "FAILED: checkpointed run"
+  exit 1
+fi
+if [ ! -s "$OUT/out/checkpoint.bin" ]; then
+  echo "FAILED: no checkpoint written to $OUT/out/checkpoint.bin"
+  exit 1
+fi
+if ! run resumed --resume; then
+  echo "FAILED: resumed run"
+  exit 1
+fi
+if ! grep -q "Resuming the search" "$OUT/resumed.log"; then
+  echo "FAILED: the checkpoint was not resumed"
+  exit 1
+fi
+echo "checkpoint resumed on a TDN platform"
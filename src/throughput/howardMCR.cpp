@@ -0,0 +1,200 @@
+#include "howardMCR.hpp"
+
+#include <cmath>
+#include <limits>
+
+HowardMCR::HowardMCR() : n_iterations(0) {}
+
+HowardMCR::HowardMCR(const HowardMCR& h) : policy(h.policy), critical(h.critical), n_iterations(h.n_iterations) {}
+
+HowardMCR& HowardMCR::operator=(const HowardMCR& h) {
+  policy = h.policy;
+  critical = h.critical;
+  n_iterations = h.n_iterations;
+  return *this;
+}
+
+const vector<int>& HowardMCR::criticalCycle() const {
+  return critical;
+}
+
+int HowardMCR::iterations() const {
+  return n_iterations;
+}
+
+void HowardMCR::reset() {
+  policy.clear();
+  critical.clear();
+}
+
+//tolerance for comparing ratios and potentials
+static inline bool greaterThan(double a, double b) {
+  return a > b + 1e-9 * (1.0 + fabs(b));
+}
+
+void HowardMCR::evaluate(const MSAG& g) {
+  //0: not visited, 1: on current walk, 2: evaluated
+  vector<char>& state = scratchState;
+  vector<int>& walk = scratchWalk;
+  state.assign(g.n, 0);
+  cycles.clear();
+  cycleOf.assign(g.n, -1);
+
+  for(int s = 0; s < g.n; s++){
+    if(state[s] || pol[s] < 0)
+      continue;
+    walk.clear();
+    int v = s;
+    while(state[v] == 0){
+      state[v] = 1;
+      walk.push_back(v);
+      v = g.succ[pol[v]];
+    }
+    size_t evaluated = walk.size(); //walk[evaluated..] still needs a potential
+    if(state[v] == 1){ //new cycle, starting at v
+      size_t head = 0;
+      while(walk[head] != v)
+        head++;
+      long sumW = 0, sumT = 0;
+      vector<int> cycle;
+      for(size_t i = head; i < walk.size(); i++){
+        sumW += g.weight[pol[walk[i]]];
+        sumT += g.tokens[pol[walk[i]]];
+        cycle.push_back(pol[walk[i]]);
+      }
+      double r;
+      if(sumT > 0)
+        r = (double) sumW / sumT;
+      else
+        r = sumW > 0 ? numeric_limits<double>::infinity() : 0.0;
+      cycles.push_back(cycle);
+      int c = cycles.size() - 1;
+      //potential of the head is 0, the others follow backwards along the cycle
+      ratio[v] = r;
+      pot[v] = 0;
+      cycleOf[v] = c;
+      state[v] = 2;
+      for(size_t i = walk.size() - 1; i > head; i--){
+        int e = pol[walk[i]];
+        ratio[walk[i]] = r;
+        pot[walk[i]] = std::isinf(r) ? 0 : g.weight[e] - r * g.tokens[e] + pot[g.succ[e]];
+        cycleOf[walk[i]] = c;
+        state[walk[i]] = 2;
+      }
+      evaluated = head;
+    }
+    //the tree part of the walk leads into an evaluated vertex
+    for(size_t i = evaluated; i-- > 0;){
+      int e = pol[walk[i]];
+      int dst = g.succ[e];
+      ratio[walk[i]] = ratio[dst];
+      pot[walk[i]] = std::isinf(ratio[dst]) ? 0 : g.weight[e] - ratio[dst] * g.tokens[e] + pot[dst];
+      cycleOf[walk[i]] = cycleOf[dst];
+      state[walk[i]] = 2;
+    }
+  }
+}
+
+double HowardMCR::solve(const MSAG& g) {
+  n_iterations = 0;
+  critical.clear();
+
+  //remove vertices that cannot reach a cycle (no outgoing edge to a remaining vertex)
+  vector<int>& outdeg = scratchInt;
+  outdeg.assign(g.n, 0);
+  for(int u = 0; u < g.n; u++){
+    outdeg[u] = g.succStart[u + 1] - g.succStart[u];
+  }
+  alive.assign(g.n, true);
+  bool pruned = true;
+  while(pruned){ //only iterates if the graph has dead ends (not the case for MSAGs)
+    pruned = false;
+    for(int v = 0; v < g.n; v++){
+      if(alive[v] && outdeg[v] == 0){
+        alive[v] = false;
+        pruned = true;
+        for(int k = g.predStart[v]; k < g.predStart[v + 1]; k++){
+          outdeg[g.pred[k]]--;
+        }
+      }
+    }
+  }
+
+  //start policy: the edge of the previous policy if it still exists, otherwise the heaviest edge
+  policy.resize(g.n, -1);
+  pol.assign(g.n, -1);
+  for(int u = 0; u < g.n; u++){
+    if(!alive[u])
+      continue;
+    for(int e = g.succStart[u]; e < g.succStart[u + 1]; e++){
+      if(!alive[g.succ[e]])
+        continue;
+      if(pol[u] < 0){
+        pol[u] = e;
+      }else if(g.succ[pol[u]] != policy[u]){
+        if(g.succ[e] == policy[u] || g.weight[e] > g.weight[pol[u]])
+          pol[u] = e;
+      }
+    }
+  }
+
+  ratio.assign(g.n, -1);
+  pot.assign(g.n, 0);
+  bool changed = true;
+  while(changed){
+    n_iterations++;
+    evaluate(g);
+    changed = false;
+
+    //phase 1: switch to edges leading to a cycle with larger ratio
+    for(int u = 0; u < g.n; u++){
+      if(!alive[u])
+        continue;
+      for(int e = g.succStart[u]; e < g.succStart[u + 1]; e++){
+        int v = g.succ[e];
+        if(alive[v] && greaterThan(ratio[v], ratio[g.succ[pol[u]]])){
+          pol[u] = e;
+          changed = true;
+        }
+      }
+    }
+    if(changed)
+      continue;
+
+    //phase 2: same ratio, switch to edges with larger potential
+    for(int u = 0; u < g.n; u++){
+      if(!alive[u] || std::isinf(ratio[u]))
+        continue;
+      double best = pot[u];
+      for(int e = g.succStart[u]; e < g.succStart[u + 1]; e++){
+        int v = g.succ[e];
+        if(!alive[v] || greaterThan(ratio[v], ratio[u]) || greaterThan(ratio[u], ratio[v]))
+          continue;
+        double val = g.weight[e] - ratio[u] * g.tokens[e] + pot[v];
+        if(greaterThan(val, best)){
+          best = val;
+          pol[u] = e;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  //store the policy for the next call
+  for(int v = 0; v < g.n; v++){
+    policy[v] = pol[v] < 0 ? -1 : g.succ[pol[v]];
+  }
+
+  double max_cr = -1;
+  int max_c = -1;
+  for(size_t c = 0; c < cycles.size(); c++){
+    int head = g.source(cycles[c][0]);
+    if(max_c < 0 || ratio[head] > max_cr){
+      max_cr = ratio[head];
+      max_c = c;
+    }
+  }
+  if(max_c >= 0)
+    critical = cycles[max_c];
+  return max_cr;
+}
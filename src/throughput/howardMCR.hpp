@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __HOWARDMCR__
+#define __HOWARDMCR__
+
+#include "msag.hpp"
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Maximum cycle ratio of an MSAG (edge weights = delays), using Howard's
+ * policy iteration (Cochet-Terrasson et al., Dasdan).
+ *
+ * In contrast to boost::maximum_cycle_ratio, the final policy is kept and
+ * used as start policy of the next call. Along a search path, the MSAG of a
+ * child space differs only slightly from the one of its parent, so the
+ * policy of the parent usually needs only few improvement steps.
+ */
+class HowardMCR {
+public:
+  HowardMCR();
+  //copies only the policy and the critical cycle, not the work memory
+  HowardMCR(const HowardMCR& h);
+  HowardMCR& operator=(const HowardMCR& h);
+
+  /**
+   * Computes the maximum cycle ratio (sum of weights / sum of tokens) of g.
+   * Only vertices with outgoing edges are considered. Returns -1 if the
+   * graph has no cycle, and numeric_limits<double>::infinity() if a cycle
+   * without tokens exists in the critical part of the graph.
+   */
+  double solve(const MSAG& g);
+
+  //edges (as indices into the edge arrays of the last graph) of the critical cycle
+  const vector<int>& criticalCycle() const;
+  //number of policy improvement iterations in the last call
+  int iterations() const;
+  //forgets the stored policy
+  void reset();
+
+private:
+  //policy[v]: destination vertex of the edge chosen for v (-1: none).
+  //Stored by destination rather than by edge index, so that it stays
+  //meaningful when the graph is rebuilt between calls.
+  vector<int> policy;
+  vector<int> critical;
+  int n_iterations;
+
+  //work memory, kept between calls to avoid allocations
+  vector<int> pol; //current policy, as edge index
+  vector<bool> alive;
+  vector<double> ratio;
+  vector<double> pot;
+  vector<int> cycleOf;
+  vector<vector<int>> cycles;
+  vector<char> scratchState;
+  vector<int> scratchWalk;
+  vector<int> scratchInt;
+
+  //evaluates the current policy: cycle ratio and potential for each vertex
+  void evaluate(const MSAG& g);
+};
+
+#endif
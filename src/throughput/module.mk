@@ -28,7 +28,7 @@
 # MODULE PATH AND FILES
 #=======================
 
-CPP_FILES := throughputSSE.cpp throughputMCR.cpp
+CPP_FILES := throughputSSE.cpp throughputMCR.cpp howardMCR.cpp msag.cpp
 
 
 
@@ -0,0 +1,101 @@
+#include "msag.hpp"
+
+#include <algorithm>
+
+MSAG::MSAG() : n(0) {}
+
+void MSAG::clear(int n_vertices) {
+  n = n_vertices;
+  pending.clear();
+  succStart.assign(n + 1, 0);
+  succ.clear();
+  tokens.clear();
+  weight.clear();
+  predStart.assign(n + 1, 0);
+  pred.clear();
+  predEdge.clear();
+}
+
+void MSAG::addEdge(int src, int dst, int tok, int w) {
+  PendingEdge e = {src, dst, tok, w, false};
+  pending.push_back(e);
+}
+
+void MSAG::setEdge(int src, int dst, int tok, int w) {
+  PendingEdge e = {src, dst, tok, w, true};
+  pending.push_back(e);
+}
+
+void MSAG::build() {
+  stable_sort(pending.begin(), pending.end(), [](const PendingEdge& a, const PendingEdge& b) {
+    return a.src < b.src || (a.src == b.src && a.dst < b.dst);
+  });
+
+  succ.clear();
+  tokens.clear();
+  weight.clear();
+  succStart.assign(n + 1, 0);
+  vector<int> edgeSrc;
+  for(size_t i = 0; i < pending.size(); i++){
+    const PendingEdge& e = pending[i];
+    //a set edge replaces the edges set before it between the same vertices
+    if(e.replace && !succ.empty() && edgeSrc.back() == e.src && succ.back() == e.dst){
+      size_t k = succ.size();
+      while(k > 0 && edgeSrc[k - 1] == e.src && succ[k - 1] == e.dst){
+        k--;
+      }
+      succ.resize(k);
+      tokens.resize(k);
+      weight.resize(k);
+      edgeSrc.resize(k);
+    }
+    edgeSrc.push_back(e.src);
+    succ.push_back(e.dst);
+    tokens.push_back(e.tok);
+    weight.push_back(e.w);
+  }
+  pending.clear();
+
+  for(size_t e = 0; e < succ.size(); e++){
+    succStart[edgeSrc[e] + 1]++;
+  }
+  for(int v = 0; v < n; v++){
+    succStart[v + 1] += succStart[v];
+  }
+
+  //incoming edges, sorted by source since the edges are sorted by source
+  predStart.assign(n + 1, 0);
+  for(size_t e = 0; e < succ.size(); e++){
+    predStart[succ[e] + 1]++;
+  }
+  for(int v = 0; v < n; v++){
+    predStart[v + 1] += predStart[v];
+  }
+  pred.assign(succ.size(), 0);
+  predEdge.assign(succ.size(), 0);
+  vector<int> fill(predStart.begin(), predStart.end() - 1);
+  for(size_t e = 0; e < succ.size(); e++){
+    int k = fill[succ[e]]++;
+    pred[k] = edgeSrc[e];
+    predEdge[k] = e;
+  }
+}
+
+int MSAG::source(int e) const {
+  //the vertex whose edge range contains e
+  return upper_bound(succStart.begin(), succStart.end(), e) - succStart.begin() - 1;
+}
+
+int MSAG::edge(int src, int dst) const {
+  auto first = succ.begin() + succStart[src];
+  auto last = succ.begin() + succStart[src + 1];
+  auto it = lower_bound(first, last, dst);
+  if(it != last && *it == dst)
+    return it - succ.begin();
+  return -1;
+}
+
+size_t MSAG::memory() const {
+  return sizeof(int) * (succStart.capacity() + succ.capacity() + tokens.capacity() + weight.capacity()
+                        + predStart.capacity() + pred.capacity() + predEdge.capacity());
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __MSAG__
+#define __MSAG__
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Compressed sparse row representation of an MSAG, shared by the SSE and
+ * MCR throughput propagators.
+ *
+ * Edges are first collected with addEdge/setEdge and then laid out by
+ * build(): the edges of vertex v are succStart[v]..succStart[v+1]-1, sorted
+ * by destination. The edge data is stored as separate arrays (succ, tokens,
+ * weight). The incoming edges of v are predStart[v]..predStart[v+1]-1 in
+ * pred (source vertex) and predEdge (index into the edge arrays), sorted
+ * by source.
+ */
+class MSAG {
+public:
+  int n; //number of vertices
+  vector<int> succStart; //|n+1|
+  vector<int> succ; //destination of each edge
+  vector<int> tokens; //tokens of each edge
+  vector<int> weight; //weight (delay) of each edge
+  vector<int> predStart; //|n+1|
+  vector<int> pred; //source of each incoming edge
+  vector<int> predEdge; //edge index of each incoming edge
+
+  MSAG();
+
+  //removes all edges and sets the number of vertices
+  void clear(int n_vertices);
+  //adds an edge, parallel edges are kept
+  void addEdge(int src, int dst, int tok, int w = 0);
+  //sets the edge src->dst, replacing an edge previously set between the same vertices
+  void setEdge(int src, int dst, int tok, int w = 0);
+  //lays out the collected edges
+  void build();
+
+  int edges() const { return succ.size(); }
+  int source(int e) const;
+  //index of the edge src->dst, -1 if there is none
+  int edge(int src, int dst) const;
+  //memory used by the edge arrays, in bytes
+  size_t memory() const;
+
+private:
+  //edges collected before build()
+  struct PendingEdge {
+    int src;
+    int dst;
+    int tok;
+    int w;
+    bool replace; //setEdge: replaces earlier edges between the same vertices
+  };
+  vector<PendingEdge> pending;
+};
+
+#endif
@@ -1,6 +1,14 @@
 #include "throughputMCR.hpp"
+#include "../tools/propagator_stats.hpp"
 #include "../tools/stringtools.hpp"
 
+//critical actors of the last fixed MSAGs analysed by this thread
+static thread_local vector<int> lastCriticalActors;
+
+vector<int> ThroughputMCR::criticalActors(){
+  return lastCriticalActors;
+}
+
 using namespace Gecode;
 using namespace Int;
 using namespace std;
@@ -14,7 +22,8 @@ ThroughputMCR::ThroughputMCR(Space& home, ViewArray<IntView> p_latency, ViewArra
     Propagator(home), latency(p_latency), period(p_period), //iterations(p_iterations), iterationsCh(p_iterationsCh), 
         sendbufferSz(p_sendbufferSz), recbufferSz(p_recbufferSz), next(p_next), wcet(p_wcet), sendingTime(p_sendingTime), 
         sendingLatency(p_sendingLatency), sendingNext(p_sendingNext), receivingTime(p_receivingTime), receivingNext(p_receivingNext), 
-        ch_src(p_ch_src), ch_dst(p_ch_dst), tok(p_tok), apps(p_apps), minIndices(p_minIndices), maxIndices(p_maxIndices) {
+        ch_src(p_ch_src), ch_dst(p_ch_dst), tok(p_tok), apps(p_apps), minIndices(p_minIndices), maxIndices(p_maxIndices),
+        council(home) {
 
   sendingTime.subscribe(home, *this, Int::PC_INT_BND);
   sendingLatency.subscribe(home, *this, Int::PC_INT_BND);
@@ -32,6 +41,11 @@ ThroughputMCR::ThroughputMCR(Space& home, ViewArray<IntView> p_latency, ViewArra
    receivingNext.subscribe(home, *this, Int::PC_INT_VAL);*/
 
   printDebug = false;
+  incremental = true;
+  calls = 0;
+  rebuilds = 0;
+  cycleRatios = 0;
+  total_time = 0;
 
   n_actors = p_wcet.size();
   n_channels = p_ch_src.size();
@@ -39,6 +53,25 @@ ThroughputMCR::ThroughputMCR(Space& home, ViewArray<IntView> p_latency, ViewArra
   wc_latency.insert(wc_latency.begin(), p_apps.size(), vector<int>());
   wc_period.insert(wc_period.begin(), p_apps.size(), 0);
 
+  //advisors: track which views have changed, in order to only patch the affected parts of the MSAG
+  for(int i = 0; i < next.size(); i++)
+    (void) new (home) ViewChange(home, *this, council, next[i], S_NEXT, i);
+  for(int i = 0; i < sendingNext.size(); i++)
+    (void) new (home) ViewChange(home, *this, council, sendingNext[i], S_SENDNEXT, i);
+  for(int i = 0; i < receivingNext.size(); i++)
+    (void) new (home) ViewChange(home, *this, council, receivingNext[i], S_RECNEXT, i);
+  for(int i = 0; i < wcet.size(); i++)
+    (void) new (home) ViewChange(home, *this, council, wcet[i], valueKey(V_WCET, i), i);
+  for(int i = 0; i < n_channels; i++){
+    (void) new (home) ViewChange(home, *this, council, sendingLatency[i], valueKey(V_SENDLAT, i), i);
+    (void) new (home) ViewChange(home, *this, council, sendingTime[i], valueKey(V_SENDTIME, i), i);
+    (void) new (home) ViewChange(home, *this, council, receivingTime[i], valueKey(V_RECTIME, i), i);
+    (void) new (home) ViewChange(home, *this, council, sendbufferSz[i], valueKey(V_SENDBUF, i), i);
+    (void) new (home) ViewChange(home, *this, council, recbufferSz[i], valueKey(V_RECBUF, i), i);
+  }
+  structureDirty = true;
+  keyRefsValid = false;
+
   home.notice(*this, AP_DISPOSE);
 }
 
@@ -58,18 +91,24 @@ size_t ThroughputMCR::dispose(Space& home) {
    sendingNext.cancel(home, *this, Int::PC_INT_VAL);
    receivingNext.cancel(home, *this, Int::PC_INT_VAL);*/
 
+  council.dispose(home);
+
   //b_msag.~adj_list_impl();
-  for(size_t t = 0; t < b_msags.size(); t++){
-    //b_msags[t]->clear();
-    delete b_msags[t];
-  }
-  
-  for(size_t t = 0; t < b_msags_upperBound.size(); t++){
-    //b_msags[t]->clear();
-    delete b_msags_upperBound[t];
-  }
-  b_msags.~vector<boost_msag*>();
-  b_msags_upperBound.~vector<boost_msag*>();
+  msagEdges.~vector<vector<MsagEdge>>();
+  msagGraph.~vector<MSAG>();
+  msagWeightUB.~vector<vector<int>>();
+  msagCsrEdge.~vector<vector<int>>();
+  msagMapCache.~vector<int>();
+  msagPeriod.~vector<int>();
+  msagPeriodUB.~vector<int>();
+  msagSolver.~vector<HowardMCR>();
+  msagSolverUB.~vector<HowardMCR>();
+  msagCritical.~vector<vector<int>>();
+  msagDirty.~vector<bool>();
+  onInterconnect.~vector<bool>();
+  sendAssigned.~vector<bool>();
+  dirtyKeys.~vector<int>();
+  keyRefs.~vector<vector<pair<int,int>>>();
   msaGraph.~unordered_map<int, vector<SuccessorNode>>();
   channelMapping.~vector<int>();
   receivingActors.~vector<int>();
@@ -97,8 +136,14 @@ size_t ThroughputMCR::dispose(Space& home) {
 ThroughputMCR::ThroughputMCR(Space& home, bool share, ThroughputMCR& p) :
     Propagator(home, share, p), ch_src(p.ch_src), ch_dst(p.ch_dst), tok(p.tok), apps(p.apps), minIndices(p.minIndices), maxIndices(p.maxIndices), 
     n_actors(p.n_actors), n_channels(p.n_channels), n_procs(p.n_procs), n_msagActors(p.n_msagActors), n_msagChannels(p.n_msagChannels), 
-    channel_count(p.channel_count), msaGraph(p.msaGraph), b_msag(p.b_msag), b_msags(p.b_msags), b_msags_upperBound(p.b_msags_upperBound), channelMapping(p.channelMapping), 
-    receivingActors(p.receivingActors), wc_latency(p.wc_latency), wc_period(p.wc_period), printDebug(p.printDebug) {
+    channel_count(p.channel_count), msaGraph(p.msaGraph), b_msag(p.b_msag), channelMapping(p.channelMapping), 
+    receivingActors(p.receivingActors), wc_latency(p.wc_latency), wc_period(p.wc_period), msagEdges(p.msagEdges), 
+    msagGraph(p.msagGraph), msagWeightUB(p.msagWeightUB), msagCsrEdge(p.msagCsrEdge), 
+    msagMapCache(p.msagMapCache), msagPeriod(p.msagPeriod), msagPeriodUB(p.msagPeriodUB), msagSolver(p.msagSolver), msagSolverUB(p.msagSolverUB), msagCritical(p.msagCritical), msagDirty(p.msagDirty), 
+    onInterconnect(p.onInterconnect), sendAssigned(p.sendAssigned), structureDirty(p.structureDirty), dirtyKeys(p.dirtyKeys), 
+    keyRefsValid(false), incremental(p.incremental), calls(p.calls), rebuilds(p.rebuilds), cycleRatios(p.cycleRatios), 
+    total_time(p.total_time), printDebug(p.printDebug) {
+  council.update(home, share, p.council);
   latency.update(home, share, p.latency);
   period.update(home, share, p.period);
   //iterations.update(home, share, p.iterations);
@@ -672,40 +717,92 @@ void ThroughputMCR::constructMSAG() {
   }
 }
 
-struct G {
-  typedef typename b::property_map<boost_msag, vertex_actorid_t>::const_type IdMap;
-  map<int, b::graph_traits<boost_msag>::vertex_descriptor> vertices;
+int ThroughputMCR::valueKey(ValueSource source, int index) const {
+  if(source == V_WCET)
+    return index;
+  return n_actors + ((int)source - 1) * n_channels + index;
+}
 
-  void addVertex(int id, b::graph_traits<boost_msag>::vertex_descriptor vertex) {
-    vertices[id] = vertex;
-  }
-  int getId(b::graph_traits<boost_msag>::vertex_descriptor vertex, const boost_msag& graph) {
-    IdMap id = b::get(vertex_actorid, graph);
-    auto id_ = b::get(id, vertex);
-    return id_;
+int ThroughputMCR::keyMin(int key) const {
+  if(key < n_actors)
+    return wcet[key].min();
+  int source = (key - n_actors) / n_channels + 1;
+  int i = (key - n_actors) % n_channels;
+  switch(source){
+    case V_SENDLAT:  return sendingLatency[i].min();
+    case V_SENDTIME: return sendingTime[i].min();
+    case V_RECTIME:  return receivingTime[i].min();
+    case V_SENDBUF:  return sendbufferSz[i].min();
+    default:         return recbufferSz[i].min();
   }
-  b::graph_traits<boost_msag>::vertex_descriptor getVertex(int id) {
-    return vertices[id];
+}
+
+int ThroughputMCR::keyMax(int key) const {
+  if(key < n_actors)
+    return wcet[key].max();
+  int source = (key - n_actors) / n_channels + 1;
+  int i = (key - n_actors) % n_channels;
+  switch(source){
+    case V_SENDLAT:  return sendingLatency[i].max();
+    case V_SENDTIME: return sendingTime[i].max();
+    case V_RECTIME:  return receivingTime[i].max();
+    case V_SENDBUF:  return sendbufferSz[i].max();
+    default:         return recbufferSz[i].max();
   }
-};
+}
 
-vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound) {
-  
-  vector<bool> allFixed(b_msags.size(), true);
+bool ThroughputMCR::refreshEdge(MsagEdge& e) const {
+  int delay = keyMin(e.w_key);
+  int delay_ub = keyMax(e.w_key);
+  int tokens = e.tokens;
+  if(e.t_key >= 0){
+    //buffer sizes: the sending buffer is used as is, the receiving buffer minus the initial tokens
+    int i = (e.t_key - n_actors) % n_channels;
+    tokens = e.t_key == valueKey(V_SENDBUF, i) ? keyMax(e.t_key) : keyMax(e.t_key) - tok[i];
+  }
+  bool changed = delay != e.delay || delay_ub != e.delay_ub || tokens != e.tokens;
+  e.delay = delay;
+  e.delay_ub = delay_ub;
+  e.tokens = tokens;
+  return changed;
+}
+
+void ThroughputMCR::addEdge(vector<vector<MsagEdge>>& edges, const vector<int>& msagId, int src, int dst,
+                            int w_key, int t_key, int tokens) const {
+  //an edge between two different MSAGs cannot be part of a cycle of either of them
+  if(msagId[src] != msagId[dst])
+    return;
+  MsagEdge e;
+  e.src = src;
+  e.dst = dst;
+  e.w_key = w_key;
+  e.t_key = t_key;
+  e.tokens = tokens;
+  e.delay = -1;
+  e.delay_ub = -1;
+  refreshEdge(e);
+  edges[msagId[src]].push_back(e);
+}
 
+void ThroughputMCR::constructMSAG(const vector<int> &msagMap, int n_msags) {
   if(printDebug)
     cout << "\tThroughputMCR::constructMSAG(vector<int> &msagMap)" << endl;
 
+  rebuilds++;
   msaGraph.clear();
   receivingActors.clear();
   channelMapping.clear();
   receivingActors.insert(receivingActors.begin(), n_actors, -1); //pre-fill with -1
+  onInterconnect.assign(n_channels, false);
+  sendAssigned.assign(n_channels, false);
   //to identify for each msag-actor, which msag it belongs to
   vector<int> msagId;
 
   //first, figure out how many actors there will be in the MSAG
   n_msagActors = n_actors;
   for(int i = 0; i < sendingTime.size(); i++){
+    onInterconnect[i] = sendingTime[i].min() > 0;
+    sendAssigned[i] = sendingTime[i].assigned();
     if(sendingTime[i].min() > 0){ //=> channel on interconnect
       n_msagActors += 3; //one blocking, one sending and one receiving actor
       //store mapping between block/send/rec_actor and channel i
@@ -718,49 +815,14 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
   for(int i = 0; i < n_msagActors; i++){
     msagId.push_back(msagMap[getApp(i)]);
   }
-  
-  for(int i = 0; i < sendingTime.size(); i++){
-    if(!sendingTime[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-    if(!sendingLatency[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-    if(!receivingTime[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-    if(!sendingNext[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-  }
-
-  b::graph_traits<boost_msag>::vertex_descriptor src, dst;
-  b::graph_traits<boost_msag>::edge_descriptor _e;
-  G g;
 
-  //add all actors as vertices, and self-loops
-  bool found;
-  for(int n = 0; n < n_msagActors; n++){
-    boost_msag& curr_graph = *b_msags[msagId[n]];
+  vector<vector<MsagEdge>> edges(n_msags, vector<MsagEdge>());
 
-    src = add_vertex(curr_graph);
-    b::put(vertex_actorid, curr_graph, src, n);
-    g.addVertex(n, src);
-    //add self-edges
-    tie(_e, found) = add_edge(src, src, curr_graph);
-    if(n < n_actors){
-      b::put(b::edge_weight, curr_graph, _e, wcet[n].min());
-      if(!wcet[n].assigned()) allFixed[msagId[n]] = false;
-    } //else{}: delay for communication actors are added further down
-    b::put(b::edge_weight2, curr_graph, _e, 1);
-    
-    if(upperBound){
-      boost_msag& curr_graph = *b_msags_upperBound[msagId[n]];
-
-      src = add_vertex(curr_graph);
-      b::put(vertex_actorid, curr_graph, src, n);
-      g.addVertex(n, src);
-      //add self-edges
-      tie(_e, found) = add_edge(src, src, curr_graph);
-      if(n < n_actors){
-        b::put(b::edge_weight, curr_graph, _e, wcet[n].max());
-      } //else{}: delay for communication actors are added further down
-      b::put(b::edge_weight2, curr_graph, _e, 1);  
-    }
+  //add self-loops for all actors
+  for(int n = 0; n < n_actors; n++){
+    addEdge(edges, msagId, n, n, valueKey(V_WCET, n), -1, 1);
   }
-  //next: add edges to boost-msag
+  //(self-loops for the communication actors are added together with the actors)
 
   channel_count = 0;
   n_msagChannels = 0; //to count the number of channels in the MSAG
@@ -777,204 +839,22 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
       int block_actor = n_actors + channel_count;
       int send_actor = block_actor + 1;
       int rec_actor = send_actor + 1;
-      //add the block actor as a successor of ch_src[i]
-      SuccessorNode succB;
-      succB.successor_key = block_actor;
-      succB.delay = sendingLatency[i].min();
-      succB.min_tok = 0;
-      succB.max_tok = 0;
-      succB.channel = i;
-
-      //add to boost-msag
-      boost_msag& curr_graph = *b_msags[msagId[ch_src[i]]];
-      src = g.getVertex(ch_src[i]);    //b::vertex(ch_src[i], *b_msags[msagId[ch_src[i]]]);
-      dst = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[ch_src[i]]]);
-      b::tie(_e, found) = b::add_edge(src, dst, curr_graph);
-      b::put(b::edge_weight, curr_graph, _e, sendingLatency[i].min());
-      if(!sendingLatency[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-      b::put(b::edge_weight2, curr_graph, _e, 0);
-      //delay-weight for self-loop on block-actor:
-      curr_graph = *b_msags[msagId[block_actor]];
-      tie(_e, found) = edge(dst, dst, curr_graph);
-      b::put(b::edge_weight, curr_graph, _e, sendingLatency[i].min());
-      
-      if(upperBound){
-        boost_msag& curr_graph = *b_msags_upperBound[msagId[ch_src[i]]];
-        src = g.getVertex(ch_src[i]);    //b::vertex(ch_src[i], *b_msags[msagId[ch_src[i]]]);
-        dst = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[ch_src[i]]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph);
-        b::put(b::edge_weight, curr_graph, _e, sendingLatency[i].max());
-        b::put(b::edge_weight2, curr_graph, _e, 0);
-        //delay-weight for self-loop on block-actor:
-        curr_graph = *b_msags_upperBound[msagId[block_actor]];
-        tie(_e, found) = edge(dst, dst, curr_graph);
-        b::put(b::edge_weight, curr_graph, _e, sendingLatency[i].max());
-      }
-
-      n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(ch_src[i]);
-        if(it != msaGraph.end()){    //i already has an entry in the map
-          msaGraph.at(ch_src[i]).push_back(succB);
-        }else{      //no entry for ch_src[i] yet
-          vector<SuccessorNode> succBv;
-          succBv.push_back(succB);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(ch_src[i], succBv));
-        }
-      }
-
-      //add ch_src[i] as successor of the block actor, with buffer size as tokens
-      SuccessorNode srcCh;
-      srcCh.successor_key = ch_src[i];
-      srcCh.delay = wcet[ch_src[i]].assigned() ? wcet[ch_src[i]].val() : wcet[ch_src[i]].min();
-      srcCh.min_tok = sendbufferSz[i].min();
-      srcCh.max_tok = sendbufferSz[i].max();
-
-      //add to boost-msag
-      boost_msag& curr_graph1 = *b_msags[msagId[block_actor]];
-      src = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[block_actor]]);
-      dst = g.getVertex(ch_src[i]);    //b::vertex(ch_src[i], *b_msags[msagId[block_actor]]);
-      b::tie(_e, found) = b::add_edge(src, dst, *b_msags[msagId[block_actor]]);
-      b::put(b::edge_weight, curr_graph1, _e, wcet[ch_src[i]].min());
-      if(!wcet[ch_src[i]].assigned()) allFixed[msagId[ch_src[i]]] = false;
-      b::put(b::edge_weight2, curr_graph1, _e, sendbufferSz[i].max());
-      
-      if(upperBound){
-        boost_msag& curr_graph1 = *b_msags_upperBound[msagId[block_actor]];
-        src = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[block_actor]]);
-        dst = g.getVertex(ch_src[i]);    //b::vertex(ch_src[i], *b_msags[msagId[block_actor]]);
-        b::tie(_e, found) = b::add_edge(src, dst, *b_msags[msagId[block_actor]]);
-        b::put(b::edge_weight, curr_graph1, _e, wcet[ch_src[i]].max());
-        b::put(b::edge_weight2, curr_graph1, _e, sendbufferSz[i].max());
-      }
-
-      n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(block_actor);
-        if(it != msaGraph.end()){    //i already has an entry in the map
-          msaGraph.at(block_actor).push_back(srcCh);
-        }else{      //no entry for block_actor yet
-          vector<SuccessorNode> srcChv;
-          srcChv.push_back(srcCh);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(block_actor, srcChv));
-        }
-      }
-//###
-      //add the send actor as a successor of the block actor
-      SuccessorNode succS;
-      succS.successor_key = send_actor;
-      succS.delay = sendingTime[i].min();
-      succS.min_tok = 0;
-      succS.max_tok = 0;
-      succS.channel = i;
-
-      //add to boost-msag
-      boost_msag& curr_graph2 = *b_msags[msagId[block_actor]];
-      src = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[block_actor]]);
-      dst = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[block_actor]]);
-      b::tie(_e, found) = b::add_edge(src, dst, curr_graph2);
-      b::put(b::edge_weight, curr_graph2, _e, sendingTime[i].min());
-      if(!sendingTime[i].assigned()) allFixed[msagId[ch_src[i]]] = false;
-      b::put(b::edge_weight2, curr_graph2, _e, 0);
-      //delay-weight for self-loop on send-actor:
-      tie(_e, found) = edge(dst, dst, curr_graph2);
-      b::put(b::edge_weight, curr_graph2, _e, sendingTime[i].min());
-      
-      if(upperBound){
-        boost_msag& curr_graph2 = *b_msags_upperBound[msagId[block_actor]];
-        src = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[block_actor]]);
-        dst = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[block_actor]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph2);
-        b::put(b::edge_weight, curr_graph2, _e, sendingTime[i].max());
-        b::put(b::edge_weight2, curr_graph2, _e, 0);
-        //delay-weight for self-loop on send-actor:
-        tie(_e, found) = edge(dst, dst, curr_graph2);
-        b::put(b::edge_weight, curr_graph2, _e, sendingTime[i].max());  
-      }
-
-      n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(block_actor);
-        if(it != msaGraph.end()){    //i already has an entry in the map
-          msaGraph.at(block_actor).push_back(succS);
-        }else{      //no entry for block_actor yet
-          vector<SuccessorNode> succSv;
-          succSv.push_back(succS);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(block_actor, succSv));
-        }
-      }
-
-      //add the block actor as successor of the send actor, with one token (serialization)
-      /*SuccessorNode succBS;
-      succBS.successor_key = block_actor;
-      succBS.delay = sendingLatency[i].min();
-      succBS.min_tok = 1;
-      succBS.max_tok = 1;
-      succBS.channel = i;*/
-
-      //add to boost-msag
-      /*boost_msag& curr_graph3 = *b_msags[msagId[send_actor]];
-      src = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[send_actor]]);
-      dst = g.getVertex(block_actor);  //b::vertex(block_actor, *b_msags[msagId[send_actor]]);
-      b::tie(_e, found) = b::add_edge(src, dst, *b_msags[msagId[send_actor]]);
-      b::put(b::edge_weight, curr_graph3, _e, sendingLatency[i].min());
-      b::put(b::edge_weight2, curr_graph3, _e, 1);*/
-
-      /*n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(send_actor);
-        if(it != msaGraph.end()){ //send actor already has an entry in the map
-          msaGraph.at(send_actor).push_back(succBS);
-        }else{      //no entry for send_actor yet
-          vector<SuccessorNode> succBSv;
-          succBSv.push_back(succBS);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(send_actor, succBSv));
-        }
-      }*/
-
-      //add receiving actor as successor of the send actor, with potential initial tokens
-      SuccessorNode dstCh;
-      dstCh.successor_key = rec_actor;
-      dstCh.delay = receivingTime[i].min();
-      dstCh.min_tok = tok[i];
-      dstCh.max_tok = tok[i];
-      dstCh.channel = i;
-      dstCh.recOrder = receivingNext[i].min();
 
-      //add to boost-msag
-      boost_msag& curr_graph4 = *b_msags[msagId[send_actor]];
-      src = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[send_actor]]);
-      dst = g.getVertex(rec_actor);    //b::vertex(rec_actor, *b_msags[msagId[send_actor]]);
-      b::tie(_e, found) = b::add_edge(src, dst, curr_graph4);
-      b::put(b::edge_weight, curr_graph4, _e, receivingTime[i].min());
-      b::put(b::edge_weight2, curr_graph4, _e, tok[i]);
-      //delay-weight for self-loop on rec-actor:
-      tie(_e, found) = edge(dst, dst, curr_graph4);
-      b::put(b::edge_weight, curr_graph4, _e, receivingTime[i].min());
-      
-      if(upperBound){
-        boost_msag& curr_graph4 = *b_msags_upperBound[msagId[send_actor]];
-        src = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[send_actor]]);
-        dst = g.getVertex(rec_actor);    //b::vertex(rec_actor, *b_msags[msagId[send_actor]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph4);
-        b::put(b::edge_weight, curr_graph4, _e, receivingTime[i].max());
-        b::put(b::edge_weight2, curr_graph4, _e, tok[i]);
-        //delay-weight for self-loop on rec-actor:
-        tie(_e, found) = edge(dst, dst, curr_graph4);
-        b::put(b::edge_weight, curr_graph4, _e, receivingTime[i].max());
-      }
-
-      n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(send_actor);
-        if(it != msaGraph.end()){    //i already has an entry in the map
-          msaGraph.at(send_actor).push_back(dstCh);
-        }else{      //no entry for i yet
-          vector<SuccessorNode> dstChv;
-          dstChv.push_back(dstCh);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(send_actor, dstChv));
-        }
-      }
+      //self-loops of the communication actors
+      addEdge(edges, msagId, block_actor, block_actor, valueKey(V_SENDLAT, i), -1, 1);
+      addEdge(edges, msagId, send_actor, send_actor, valueKey(V_SENDTIME, i), -1, 1);
+      addEdge(edges, msagId, rec_actor, rec_actor, valueKey(V_RECTIME, i), -1, 1);
+      //the block actor as a successor of ch_src[i]
+      addEdge(edges, msagId, ch_src[i], block_actor, valueKey(V_SENDLAT, i), -1, 0);
+      //ch_src[i] as successor of the block actor, with buffer size as tokens
+      addEdge(edges, msagId, block_actor, ch_src[i], valueKey(V_WCET, ch_src[i]), valueKey(V_SENDBUF, i), 0);
+      //the send actor as a successor of the block actor
+      addEdge(edges, msagId, block_actor, send_actor, valueKey(V_SENDTIME, i), -1, 0);
+      //receiving actor as successor of the send actor, with potential initial tokens
+      addEdge(edges, msagId, send_actor, rec_actor, valueKey(V_RECTIME, i), -1, tok[i]);
+      //the send actor as a successor node of the receiving actor, with rec. buffer size - initial tokens
+      addEdge(edges, msagId, rec_actor, send_actor, valueKey(V_SENDTIME, i), valueKey(V_RECBUF, i), 0);
+      n_msagChannels += 5;
 
       //save the receiving actors for each actor (for next order)
       if(receivingActors[ch_dst[i]] == -1){ //first rec_actor for the dst
@@ -997,207 +877,66 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
         }
       }
 
-      //add the send actor as a successor node of the receiving actor, with rec. buffer size - initial tokens
-      SuccessorNode succRec;
-      succRec.successor_key = send_actor;
-      succRec.delay = sendingTime[i].min();
-      succRec.min_tok = recbufferSz[i].min() - tok[i];
-      succRec.max_tok = recbufferSz[i].max() - tok[i];
-      succRec.channel = i;
-
-      //add to boost-msag
-      boost_msag& curr_graph5 = *b_msags[msagId[rec_actor]];
-      src = g.getVertex(rec_actor);   //b::vertex(rec_actor, *b_msags[msagId[rec_actor]]);
-      dst = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[rec_actor]]);
-      b::tie(_e, found) = b::add_edge(src, dst, curr_graph5);
-      b::put(b::edge_weight, curr_graph5, _e, sendingTime[i].min());
-      if(!sendingTime[i].assigned()) allFixed[msagId[ch_dst[i]]] = false;
-      b::put(b::edge_weight2, curr_graph5, _e, recbufferSz[i].max() - tok[i]);
-      
-      if(upperBound){
-        boost_msag& curr_graph5 = *b_msags_upperBound[msagId[rec_actor]];
-        src = g.getVertex(rec_actor);   //b::vertex(rec_actor, *b_msags[msagId[rec_actor]]);
-        dst = g.getVertex(send_actor);   //b::vertex(send_actor, *b_msags[msagId[rec_actor]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph5);
-        b::put(b::edge_weight, curr_graph5, _e, sendingTime[i].max());
-        b::put(b::edge_weight2, curr_graph5, _e, recbufferSz[i].max() - tok[i]);
-      }
-
-      n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(rec_actor);
-        if(it != msaGraph.end()){ //i already has an entry in the map
-          msaGraph.at(rec_actor).push_back(succRec);
-        }else{ //no entry for i yet
-          vector<SuccessorNode> succRecv;
-          succRecv.push_back(succRec);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(rec_actor, succRecv));
-        }
-      }
-
       channel_count += 3;
     }else if(sendingTime[i].min() == 0){ //Step 1b: add all edges from G to the MSAG
       if(!sendingTime[i].assigned() || (sendingTime[i].assigned() && tok[i] > 0) || (sendingTime[i].assigned() && !next[ch_src[i]].assigned())){
         //ch_src[i] -> ch_dst[i]: add channel destination as successor node of the channel source
-        SuccessorNode _dst;
-        _dst.successor_key = ch_dst[i];
-        _dst.delay = wcet[ch_dst[i]].min();
-        _dst.min_tok = tok[i];
-        _dst.max_tok = tok[i];
-        _dst.channel = i;
-
-        //add to boost-msag
-        boost_msag& curr_graph5 = *b_msags[msagId[ch_src[i]]];
-        src = g.getVertex(ch_src[i]);   //b::vertex(ch_src[i], *b_msags[msagId[ch_src[i]]]);
-        dst = g.getVertex(ch_dst[i]);   //b::vertex(ch_dst[i], *b_msags[msagId[ch_src[i]]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph5);
-        b::put(b::edge_weight, curr_graph5, _e, wcet[ch_dst[i]].min());
-        if(!wcet[ch_dst[i]].assigned()) allFixed[msagId[ch_dst[i]]] = false;
-        b::put(b::edge_weight2, curr_graph5, _e, tok[i]);
-        
-        if(upperBound){
-          boost_msag& curr_graph5 = *b_msags_upperBound[msagId[ch_src[i]]];
-          src = g.getVertex(ch_src[i]);   //b::vertex(ch_src[i], *b_msags[msagId[ch_src[i]]]);
-          dst = g.getVertex(ch_dst[i]);   //b::vertex(ch_dst[i], *b_msags[msagId[ch_src[i]]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph5);
-          b::put(b::edge_weight, curr_graph5, _e, wcet[ch_dst[i]].max());
-          b::put(b::edge_weight2, curr_graph5, _e, tok[i]);
-        }
-
+        addEdge(edges, msagId, ch_src[i], ch_dst[i], valueKey(V_WCET, ch_dst[i]), -1, tok[i]);
         n_msagChannels++;
-        if(printDebug){
-          unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(ch_src[i]);
-          if(it != msaGraph.end()){ //i already has an entry in the map
-            msaGraph.at(ch_src[i]).push_back(_dst);
-          }else{ //no entry for i yet
-            vector<SuccessorNode> dstv;
-            dstv.push_back(_dst);
-            msaGraph.insert(pair<int, vector<SuccessorNode>>(ch_src[i], dstv));
-          }
-        }
       }
     }
   }
-  /*
-   for(unsigned int i=0; i<receivingActors.size(); i++){
-   cout << receivingActors[i] << " ";
-   }
-   cout << endl;*/
-
-  /*
-   cout << "channelMapping.size() = " << channelMapping.size() << endl;
-   for(unsigned int i=0; i<channelMapping.size(); i+=3){
-   cout << channelMapping[i] << " ";
-   }
-   cout << endl;*/
 
   //put sendNext relations into the MSAG
-  if(channelMapping.size()){
-    for(unsigned int i = 1; i < channelMapping.size(); i += 3){ //for all sending actors
-      bool continues = true;
-      bool nextFound = false;
-      int nextCh = -1;
-      int x = channelMapping[i];
-      int tokens = 0; //is channel to add a cycle-closing back-edge?
-      while(!nextFound && continues){
-        if(sendingNext[x].assigned()){
-          nextCh = sendingNext[x].val();
-          if(nextCh >= n_channels){ //end of chain found
-            if(nextCh > n_channels){
-              nextCh = n_channels + ((nextCh - n_channels - 1) % n_procs);
-            }else{
-              nextCh = n_channels + n_procs - 1;
-            }
-            tokens = 1;
-            if(sendingNext[nextCh].assigned()){
-              nextCh = sendingNext[nextCh].val();
-              if(sendingTime[nextCh].min() > 0){
-                nextFound = true;
-              }else{
-                x = nextCh;
-              }
-            }else{
-              continues = false;
-            }
-          }else{ //not end of chain (nextCh < n_channels)
+  for(unsigned int i = 1; i < channelMapping.size(); i += 3){ //for all sending actors
+    bool continues = true;
+    bool nextFound = false;
+    int nextCh = -1;
+    int x = channelMapping[i];
+    int tokens = 0; //is channel to add a cycle-closing back-edge?
+    while(!nextFound && continues){
+      if(sendingNext[x].assigned()){
+        nextCh = sendingNext[x].val();
+        if(nextCh >= n_channels){ //end of chain found
+          if(nextCh > n_channels){
+            nextCh = n_channels + ((nextCh - n_channels - 1) % n_procs);
+          }else{
+            nextCh = n_channels + n_procs - 1;
+          }
+          tokens = 1;
+          if(sendingNext[nextCh].assigned()){
+            nextCh = sendingNext[nextCh].val();
             if(sendingTime[nextCh].min() > 0){
               nextFound = true;
-              if(tokens != 1)
-                tokens = 0;
             }else{
-              x = nextCh; //nextCh is not on interconnect. Continue with nextSend[nextCh].
+              x = nextCh;
             }
+          }else{
+            continues = false;
           }
-        }else{
-          continues = false;
-        }
-      }
-      if(nextFound){
-        //add block_actor of channel i -> block_actor of nextCh and
-        //add send_actor of channel i -> send_actor of nextCh and
-        if(channelMapping[i] != nextCh){ //if found successor is not the channel's own block/send_actor (then it is already in the graph)
-          int block_actor = i-1 + n_actors; //i is index of send actor
-          int send_actor = i + n_actors;
-          int next_block_actor = getBlockActor(nextCh);
-          int next_send_actor = getSendActor(nextCh);
-
-          //cout << "Next channel (send_actor of channel " << i << "): " << nextCh << endl;
-
-          SuccessorNode succBS;
-          succBS.successor_key = next_block_actor;
-          succBS.delay = sendingLatency[nextCh].min();
-          succBS.min_tok = tokens;
-          succBS.max_tok = tokens;
-          succBS.channel = nextCh;
-
-          //add to boost-msag
-          boost_msag& curr_graph6 = *b_msags[msagId[next_block_actor]];
-          //block -> next_block
-          src = g.getVertex(block_actor);   //b::vertex(i + n_actors, *b_msags[msagId[next_block_actor]]);
-          dst = g.getVertex(next_block_actor);    //b::vertex(next_block_actor, *b_msags[msagId[next_block_actor]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph6);
-          b::put(b::edge_weight, curr_graph6, _e, sendingLatency[nextCh].min());
-          if(!sendingLatency[nextCh].assigned()) allFixed[msagId[ch_dst[nextCh]]] = false;
-          b::put(b::edge_weight2, curr_graph6, _e, tokens);
-          //send -> next_send
-          src = g.getVertex(send_actor);   //b::vertex(i + n_actors, *b_msags[msagId[next_block_actor]]);
-          dst = g.getVertex(next_send_actor);    //b::vertex(next_block_actor, *b_msags[msagId[next_block_actor]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph6);
-          b::put(b::edge_weight, curr_graph6, _e, sendingTime[nextCh].min());
-          if(!sendingTime[nextCh].assigned()) allFixed[msagId[ch_dst[nextCh]]] = false;
-          b::put(b::edge_weight2, curr_graph6, _e, tokens);
-          
-          if(upperBound){
-            boost_msag& curr_graph6 = *b_msags_upperBound[msagId[next_block_actor]];
-            src = g.getVertex(block_actor);   //b::vertex(i + n_actors, *b_msags[msagId[next_block_actor]]);
-            dst = g.getVertex(next_block_actor);    //b::vertex(next_block_actor, *b_msags[msagId[next_block_actor]]);
-            b::tie(_e, found) = b::add_edge(src, dst, curr_graph6);
-            b::put(b::edge_weight, curr_graph6, _e, sendingLatency[nextCh].max());
-            if(!sendingLatency[nextCh].assigned()) allFixed[msagId[ch_dst[nextCh]]] = false;
-            b::put(b::edge_weight2, curr_graph6, _e, tokens);
-            //send -> next_send
-            src = g.getVertex(send_actor);   //b::vertex(i + n_actors, *b_msags[msagId[next_block_actor]]);
-            dst = g.getVertex(next_send_actor);    //b::vertex(next_block_actor, *b_msags[msagId[next_block_actor]]);
-            b::tie(_e, found) = b::add_edge(src, dst, curr_graph6);
-            b::put(b::edge_weight, curr_graph6, _e, sendingTime[nextCh].max());
-            if(!sendingTime[nextCh].assigned()) allFixed[msagId[ch_dst[nextCh]]] = false;
-            b::put(b::edge_weight2, curr_graph6, _e, tokens);
-          }
-
-          n_msagChannels++;
-          if(printDebug){
-            unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(i + n_actors);
-            if(it != msaGraph.end()){ //send actor already has an entry in the map
-              msaGraph.at(i + n_actors).push_back(succBS);
-            }else{ //no entry for send_actor i yet
-              vector<SuccessorNode> succBSv;
-              succBSv.push_back(succBS);
-              msaGraph.insert(pair<int, vector<SuccessorNode>>(i + n_actors, succBSv));
-            }
+        }else{ //not end of chain (nextCh < n_channels)
+          if(sendingTime[nextCh].min() > 0){
+            nextFound = true;
+            if(tokens != 1)
+              tokens = 0;
+          }else{
+            x = nextCh; //nextCh is not on interconnect. Continue with nextSend[nextCh].
           }
         }
+      }else{
+        continues = false;
       }
     }
+    //add block_actor of channel i -> block_actor of nextCh and
+    //add send_actor of channel i -> send_actor of nextCh
+    //(unless the found successor is the channel's own block/send_actor, then it is already in the graph)
+    if(nextFound && channelMapping[i] != nextCh){
+      int block_actor = i-1 + n_actors; //i is index of send actor
+      int send_actor = i + n_actors;
+      addEdge(edges, msagId, block_actor, getBlockActor(nextCh), valueKey(V_SENDLAT, nextCh), -1, tokens);
+      addEdge(edges, msagId, send_actor, getSendActor(nextCh), valueKey(V_SENDTIME, nextCh), -1, tokens);
+      n_msagChannels += 2;
+    }
   }
 
   //put recNext relations into the MSAG
@@ -1206,17 +945,15 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
     int nextCh;
     int x = channelMapping[i];
 
-    //cout << "looking for recNext, channel " << i << endl;
-
     while(!nextFound){
       if(receivingNext[x].assigned()){
         nextCh = receivingNext[x].val();
         if(nextCh >= n_channels){ //end of chain found
-          nextCh = -1; //nextCh = ch_dst[channelMapping[i]];
+          nextCh = -1;
           nextFound = true;
         }else{ //not end of chain (nextCh < n_channels)
           if(ch_dst[nextCh] != ch_dst[channelMapping[i]]){ //next rec actor belongs to other dst
-            nextCh = -1; //nextCh = ch_dst[channelMapping[i]];
+            nextCh = -1;
             nextFound = true;
           }else{ //same dst
             if(sendingTime[nextCh].min() > 0){
@@ -1227,130 +964,34 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
           }
         }
       }else{
-        nextCh = -1; //nextCh = ch_dst[channelMapping[i]];
+        nextCh = -1;
         nextFound = true;
       }
     }
 
-    //cout << "  found " << nextCh;
-
-    SuccessorNode succRec;
-    succRec.successor_key = nextCh == -1 ? ch_dst[channelMapping[i]] : getRecActor(nextCh);
-    succRec.delay = nextCh == -1 ? wcet[ch_dst[channelMapping[i]]].min() : receivingTime[nextCh].min();
-    succRec.min_tok = 0;
-    succRec.max_tok = 0;
-    if(nextCh != -1)
-      succRec.channel = nextCh;
-
-    //cout << " ( "<< succRec.successor_key <<")" << endl;
-
-    //add to boost-msag
-    int tmp = i + n_actors;
-    boost_msag& curr_graph7 = *b_msags[msagId[tmp]];
-    src = g.getVertex(tmp);            //b::vertex(tmp, *b_msags[msagId[tmp]]);
-    dst = g.getVertex(nextCh == -1 ? ch_dst[channelMapping[i]] : getRecActor(nextCh)); //b::vertex(nextCh == -1 ? ch_dst[channelMapping[i]] : getRecActor(nextCh),*b_msags[msagId[tmp]]);
-    b::tie(_e, found) = b::add_edge(src, dst, curr_graph7);
-    b::put(b::edge_weight, curr_graph7, _e, nextCh == -1 ? wcet[ch_dst[channelMapping[i]]].min() : receivingTime[nextCh].min());
     if(nextCh == -1){
-      if(!wcet[ch_dst[channelMapping[i]]].assigned()) allFixed[msagId[ch_dst[channelMapping[i]]]] = false;
+      addEdge(edges, msagId, i + n_actors, ch_dst[channelMapping[i]], valueKey(V_WCET, ch_dst[channelMapping[i]]), -1, 0);
     }else{
-      if(!receivingTime[nextCh].assigned()) allFixed[msagId[ch_dst[nextCh]]] = false;
-    }
-    b::put(b::edge_weight2, curr_graph7, _e, 0);
-    
-    if(upperBound){
-      boost_msag& curr_graph7 = *b_msags_upperBound[msagId[tmp]];
-      src = g.getVertex(tmp);            //b::vertex(tmp, *b_msags[msagId[tmp]]);
-      dst = g.getVertex(nextCh == -1 ? ch_dst[channelMapping[i]] : getRecActor(nextCh)); //b::vertex(nextCh == -1 ? ch_dst[channelMapping[i]] : getRecActor(nextCh),*b_msags[msagId[tmp]]);
-      b::tie(_e, found) = b::add_edge(src, dst, curr_graph7);
-      b::put(b::edge_weight, curr_graph7, _e, nextCh == -1 ? wcet[ch_dst[channelMapping[i]]].max() : receivingTime[nextCh].max());
-      b::put(b::edge_weight2, curr_graph7, _e, 0);
+      addEdge(edges, msagId, i + n_actors, getRecActor(nextCh), valueKey(V_RECTIME, nextCh), -1, 0);
     }
-
     n_msagChannels++;
-    if(printDebug){
-      unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(i + n_actors);
-      if(it != msaGraph.end()){ //send actor already has an entry in the map
-        msaGraph.at(i + n_actors).push_back(succRec);
-      }else{ //no entry for send_actor i yet
-        vector<SuccessorNode> succRecv;
-        succRecv.push_back(succRec);
-        msaGraph.insert(pair<int, vector<SuccessorNode>>(i + n_actors, succRecv));
-      }
-    }
   }
 
   for(int i = 0; i < n_actors; i++){
-    if(!next[i].assigned()) allFixed[msagId[i]] = false;
     //Step 2
     if(next[i].assigned() && next[i].val() < n_actors){ //if next[i] is decided, the forward edge goes from i to next[i]
       int nextActor = next[i].val();
 
       //check whether nextActor has preceding rec_actor
-      SuccessorNode nextA;
       if(receivingActors[nextActor] == -1){
         //add edge i -> nextActor
-        nextA.successor_key = nextActor;
-        nextA.delay = wcet[nextActor].min();
-        nextA.min_tok = 0;
-        nextA.max_tok = 0;
-
-        //add to boost-msag
-        boost_msag& curr_graph8 = *b_msags[msagId[i]];
-        src = g.getVertex(i);         //b::vertex(i, *b_msags[msagId[i]]);
-        dst = g.getVertex(nextActor); //b::vertex(nextActor, *b_msags[msagId[i]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph8);
-        b::put(b::edge_weight, curr_graph8, _e, wcet[nextActor].min());
-        if(!wcet[nextActor].assigned()) allFixed[msagId[nextActor]] = false;
-        b::put(b::edge_weight2, curr_graph8, _e, 0);
-        
-        if(upperBound){
-          boost_msag& curr_graph8 = *b_msags_upperBound[msagId[i]];
-          src = g.getVertex(i);         //b::vertex(i, *b_msags[msagId[i]]);
-          dst = g.getVertex(nextActor); //b::vertex(nextActor, *b_msags[msagId[i]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph8);
-          b::put(b::edge_weight, curr_graph8, _e, wcet[nextActor].max());
-          b::put(b::edge_weight2, curr_graph8, _e, 0);
-        }
-        
+        addEdge(edges, msagId, i, nextActor, valueKey(V_WCET, nextActor), -1, 0);
       }else{
         //add edge i -> receivingActor[nextActor]
-        nextA.successor_key = receivingActors[nextActor];
-        nextA.delay = receivingTime[channelMapping[receivingActors[nextActor] - n_actors]].min();
-        nextA.min_tok = 0;
-        nextA.max_tok = 0;
-        nextA.channel = channelMapping[receivingActors[nextActor] - n_actors];
-
-        //add to boost-msag
-        boost_msag& curr_graph9 = *b_msags[msagId[i]];
-        src = g.getVertex(i);                          //b::vertex(i, *b_msags[msagId[i]]);
-        dst = g.getVertex(receivingActors[nextActor]); //b::vertex(receivingActors[nextActor], *b_msags[msagId[i]]);
-        b::tie(_e, found) = b::add_edge(src, dst, curr_graph9);
-        b::put(b::edge_weight, curr_graph9, _e, receivingTime[channelMapping[receivingActors[nextActor] - n_actors]].min());
-        if(!receivingTime[channelMapping[receivingActors[nextActor] - n_actors]].assigned()) allFixed[msagId[ch_src[channelMapping[receivingActors[nextActor] - n_actors]]]] = false;
-        b::put(b::edge_weight2, curr_graph9, _e, 0);
-        
-        if(upperBound){
-          boost_msag& curr_graph9 = *b_msags_upperBound[msagId[i]];
-          src = g.getVertex(i);                          //b::vertex(i, *b_msags[msagId[i]]);
-          dst = g.getVertex(receivingActors[nextActor]); //b::vertex(receivingActors[nextActor], *b_msags[msagId[i]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph9);
-          b::put(b::edge_weight, curr_graph9, _e, receivingTime[channelMapping[receivingActors[nextActor] - n_actors]].max());
-          b::put(b::edge_weight2, curr_graph9, _e, 0);
-        }
+        int ch = channelMapping[receivingActors[nextActor] - n_actors];
+        addEdge(edges, msagId, i, receivingActors[nextActor], valueKey(V_RECTIME, ch), -1, 0);
       }
-
       n_msagChannels++;
-      if(printDebug){
-        unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(i);
-        if(it != msaGraph.end()){ //i already has an entry in the map
-          msaGraph.at(i).push_back(nextA);
-        }else{ //no entry for i yet
-          vector<SuccessorNode> nextAv;
-          nextAv.push_back(nextA);
-          msaGraph.insert(pair<int, vector<SuccessorNode>>(i, nextAv));
-        }
-      }
 
     }else if(next[i].assigned() && next[i].val() >= n_actors){ //next[i]>=n_actors
     //Step 3: add cycle-closing edge on each proc
@@ -1364,94 +1005,229 @@ vector<bool> ThroughputMCR::constructMSAG(vector<int> &msagMap, bool upperBound)
         firstActor = next[firstActor].val();
 
         //check whether firstActor has preceding rec_actor
-        SuccessorNode first;
         if(receivingActors[firstActor] == -1){
           //add edge i -> firstActor
-          first.successor_key = firstActor;
-          first.delay = wcet[firstActor].min();
-          first.min_tok = 1;
-          first.max_tok = 1;
-
-          //add to boost-msag
-          boost_msag& curr_graph10 = *b_msags[msagId[i]];
-          src = g.getVertex(i);          //b::vertex(i, *b_msags[msagId[i]]);
-          dst = g.getVertex(firstActor); //b::vertex(firstActor, *b_msags[msagId[i]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph10);
-          b::put(b::edge_weight, curr_graph10, _e, wcet[firstActor].min());
-          if(!wcet[firstActor].assigned()) allFixed[msagId[firstActor]] = false;
-          b::put(b::edge_weight2, curr_graph10, _e, 1);
-          
-          if(upperBound){
-            boost_msag& curr_graph10 = *b_msags_upperBound[msagId[i]];
-            src = g.getVertex(i);          //b::vertex(i, *b_msags[msagId[i]]);
-            dst = g.getVertex(firstActor); //b::vertex(firstActor, *b_msags[msagId[i]]);
-            b::tie(_e, found) = b::add_edge(src, dst, curr_graph10);
-            b::put(b::edge_weight, curr_graph10, _e, wcet[firstActor].max());
-            b::put(b::edge_weight2, curr_graph10, _e, 1);
-          }
+          addEdge(edges, msagId, i, firstActor, valueKey(V_WCET, firstActor), -1, 1);
         }else{
           //add edge i -> receivingActor[firstActor]
-          first.successor_key = receivingActors[firstActor];
-          first.delay = receivingTime[channelMapping[receivingActors[firstActor] - n_actors]].min();
-          first.min_tok = 1;
-          first.max_tok = 1;
-          first.channel = channelMapping[receivingActors[firstActor] - n_actors];
-
-          //add to boost-msag
-          boost_msag& curr_graph11 = *b_msags[msagId[i]];
-          src = g.getVertex(i);                           //b::vertex(i, *b_msags[msagId[i]]);
-          dst = g.getVertex(receivingActors[firstActor]); //b::vertex(receivingActors[firstActor], *b_msags[msagId[i]]);
-          b::tie(_e, found) = b::add_edge(src, dst, curr_graph11);
-          b::put(b::edge_weight, curr_graph11, _e, receivingTime[channelMapping[receivingActors[firstActor] - n_actors]].min());
-          if(!receivingTime[channelMapping[receivingActors[firstActor] - n_actors]].assigned()) allFixed[msagId[ch_src[channelMapping[receivingActors[firstActor] - n_actors]]]] = false;
-          b::put(b::edge_weight2, curr_graph11, _e, 1);
-          
-          if(upperBound){
-            boost_msag& curr_graph11 = *b_msags_upperBound[msagId[i]];
-            src = g.getVertex(i);                           //b::vertex(i, *b_msags[msagId[i]]);
-            dst = g.getVertex(receivingActors[firstActor]); //b::vertex(receivingActors[firstActor], *b_msags[msagId[i]]);
-            b::tie(_e, found) = b::add_edge(src, dst, curr_graph11);
-            b::put(b::edge_weight, curr_graph11, _e, receivingTime[channelMapping[receivingActors[firstActor] - n_actors]].max());
-            b::put(b::edge_weight2, curr_graph11, _e, 1);
-          }
+          int ch = channelMapping[receivingActors[firstActor] - n_actors];
+          addEdge(edges, msagId, i, receivingActors[firstActor], valueKey(V_RECTIME, ch), -1, 1);
         }
-
         n_msagChannels++;
-        if(printDebug){
-          unordered_map<int, vector<SuccessorNode>>::const_iterator it = msaGraph.find(i);
-          if(it != msaGraph.end()){ //i already has an entry in the map
-            msaGraph.at(i).push_back(first);
-          }else{    //no entry for i yet
-            vector<SuccessorNode> firstv;
-            firstv.push_back(first);
-            msaGraph.insert(pair<int, vector<SuccessorNode>>(i, firstv));
-          }
-        }
       }
     }
   }
-  
-  
-  for(int i=n_actors; i<next.size(); i++){
-    for(int j=0; j<n_actors; j++){
-      if(!next[i].assigned() && next[i].in(j)) allFixed[msagId[j]] = false;
+
+  //compare with the previous MSAGs: only changed MSAGs need a new cycle ratio
+  bool sameMap = msagMap == msagMapCache && (int)msagEdges.size() == n_msags;
+  msagPeriod.resize(n_msags, -1);
+  msagPeriodUB.resize(n_msags, -1);
+  msagDirty.resize(n_msags, true);
+  msagSolver.resize(n_msags);
+  msagSolverUB.resize(n_msags);
+  msagCritical.resize(n_msags);
+  msagGraph.resize(n_msags);
+  msagWeightUB.resize(n_msags);
+  msagCsrEdge.resize(n_msags);
+  vector<bool> changed(n_msags, false);
+  for(int m = 0; m < n_msags; m++){
+    if(!sameMap || !(edges[m] == msagEdges[m])){
+      msagDirty[m] = true;
+      changed[m] = true;
     }
   }
-  
-  for(int i=n_channels; i<sendingNext.size(); i++){
-    for(int j=0; j<n_channels; j++){
-      if(!sendingNext[i].assigned() && sendingNext[i].in(j)) allFixed[msagId[ch_src[j]]] = false;
-    }
+  msagEdges.swap(edges);
+  msagMapCache = msagMap;
+  keyRefsValid = false;
+  for(int m = 0; m < n_msags; m++){
+    if(changed[m] || msagGraph[m].n != n_msagActors)
+      layoutMSAG(m);
   }
-  
 
   if(printDebug){
-    //printThroughputGraphAsDot(".");
+    for(auto& m_edges : msagEdges){
+      for(auto& e : m_edges){
+        if(e.src == e.dst)
+          continue;
+        SuccessorNode succ;
+        succ.successor_key = e.dst;
+        succ.delay = e.delay;
+        succ.min_tok = e.tokens;
+        succ.max_tok = e.tokens;
+        succ.channel = e.w_key >= n_actors ? (e.w_key - n_actors) % n_channels : -1;
+        msaGraph[e.src].push_back(succ);
+      }
+    }
+  }
+}
+
+void ThroughputMCR::layoutMSAG(int m) {
+  const vector<MsagEdge>& edges = msagEdges[m];
+  MSAG& graph = msagGraph[m];
+  graph.clear(n_msagActors);
+  for(auto& e : edges){
+    graph.addEdge(e.src, e.dst, e.tokens, e.delay);
+  }
+  graph.build();
+  //build() orders the edges stably by source and destination
+  vector<int> order(edges.size());
+  for(size_t e = 0; e < edges.size(); e++){
+    order[e] = e;
+  }
+  stable_sort(order.begin(), order.end(), [&edges](int a, int b) {
+    return edges[a].src < edges[b].src || (edges[a].src == edges[b].src && edges[a].dst < edges[b].dst);
+  });
+  msagCsrEdge[m].resize(edges.size());
+  msagWeightUB[m].resize(edges.size());
+  for(size_t k = 0; k < order.size(); k++){
+    msagCsrEdge[m][order[k]] = k;
+    msagWeightUB[m][k] = edges[order[k]].delay_ub;
   }
-  
+}
+
+void ThroughputMCR::indexMSAG() {
+  keyRefs.assign(n_actors + 5 * n_channels, vector<pair<int,int>>());
+  for(size_t m = 0; m < msagEdges.size(); m++){
+    for(size_t e = 0; e < msagEdges[m].size(); e++){
+      keyRefs[msagEdges[m][e].w_key].push_back(make_pair(m, e));
+      if(msagEdges[m][e].t_key >= 0)
+        keyRefs[msagEdges[m][e].t_key].push_back(make_pair(m, e));
+    }
+  }
+  keyRefsValid = true;
+}
+
+void ThroughputMCR::patchMSAG() {
+  if(printDebug)
+    cout << "\tThroughputMCR::patchMSAG(), " << dirtyKeys.size() << " modified views" << endl;
+
+  if(!keyRefsValid)
+    indexMSAG();
+  sort(dirtyKeys.begin(), dirtyKeys.end());
+  dirtyKeys.erase(unique(dirtyKeys.begin(), dirtyKeys.end()), dirtyKeys.end());
+  for(int key : dirtyKeys){
+    for(auto& ref : keyRefs[key]){
+      MsagEdge& e = msagEdges[ref.first][ref.second];
+      if(refreshEdge(e)){
+        msagDirty[ref.first] = true;
+        int k = msagCsrEdge[ref.first][ref.second];
+        msagGraph[ref.first].weight[k] = e.delay;
+        msagGraph[ref.first].tokens[k] = e.tokens;
+        msagWeightUB[ref.first][k] = e.delay_ub;
+      }
+    }
+  }
+}
+
+void ThroughputMCR::checkPatchedMSAG(const vector<int> &msagMap, int n_msags) {
+  vector<vector<MsagEdge>> patched = msagEdges;
+  vector<MSAG> patchedGraph = msagGraph;
+  vector<vector<int>> patchedWeightUB = msagWeightUB;
+  vector<bool> dirty = msagDirty;
+  constructMSAG(msagMap, n_msags);
+  rebuilds--;
+  for(int m = 0; m < n_msags; m++){
+    const MSAG& g = msagGraph[m];
+    const MSAG& p = patchedGraph[m];
+    if(!(patched[m] == msagEdges[m]) || p.succStart != g.succStart || p.succ != g.succ || p.tokens != g.tokens
+       || p.weight != g.weight || patchedWeightUB[m] != msagWeightUB[m]){
+      cout << "Warning: the patched MSAG " << m << " differs from the rebuilt one" << endl;
+    }else{
+      msagDirty[m] = dirty[m];
+    }
+  }
+}
+
+vector<bool> ThroughputMCR::fixedMSAGs(const vector<int> &msagMap, int n_msags) const {
+  vector<bool> allFixed(n_msags, true);
+
+  for(int i = 0; i < n_channels; i++){
+    if(!sendingTime[i].assigned() || !sendingLatency[i].assigned() || !receivingTime[i].assigned() ||
+       !sendingNext[i].assigned()){
+      allFixed[msagMap[getApp(ch_src[i])]] = false;
+    }
+  }
+  for(int i = 0; i < n_actors; i++){
+    if(!wcet[i].assigned() || !next[i].assigned())
+      allFixed[msagMap[getApp(i)]] = false;
+  }
+  for(int i = n_actors; i < next.size(); i++){
+    if(!next[i].assigned()){
+      for(int j = 0; j < n_actors; j++){
+        if(next[i].in(j)) allFixed[msagMap[getApp(j)]] = false;
+      }
+    }
+  }
+  for(int i = n_channels; i < sendingNext.size(); i++){
+    if(!sendingNext[i].assigned()){
+      for(int j = 0; j < n_channels; j++){
+        if(sendingNext[i].in(j)) allFixed[msagMap[getApp(ch_src[j])]] = false;
+      }
+    }
+  }
+
   return allFixed;
 }
 
+void ThroughputMCR::toBoostMSAG(int m, bool upperBound, boost_msag& graph) const {
+  b::graph_traits<boost_msag>::edge_descriptor _e;
+  bool found;
+  vector<int> vertices(n_msagActors, -1);
+  for(auto& e : msagEdges[m]){
+    for(int v : {e.src, e.dst}){
+      if(vertices[v] == -1){
+        vertices[v] = b::add_vertex(graph);
+        b::put(vertex_actorid, graph, vertices[v], v);
+      }
+    }
+    b::tie(_e, found) = b::add_edge(vertices[e.src], vertices[e.dst], graph);
+    b::put(b::edge_weight, graph, _e, upperBound ? e.delay_ub : e.delay);
+    b::put(b::edge_weight2, graph, _e, e.tokens);
+  }
+}
+
+int ThroughputMCR::cycleRatio(int m, bool upperBound) {
+  cycleRatios++;
+  MSAG& graph = msagGraph[m];
+
+  //warm start from the policy of the last computation (possibly inherited from the parent space)
+  HowardMCR& solver = upperBound ? msagSolverUB[m] : msagSolver[m];
+  if(upperBound) //the upper-bound delays take the place of the weights for this computation
+    graph.weight.swap(msagWeightUB[m]);
+  double mcr = solver.solve(graph);
+  if(upperBound)
+    graph.weight.swap(msagWeightUB[m]);
+  int max_cr = mcr > Int::Limits::max ? Int::Limits::max : (int) mcr; /// maximum cycle ratio
+  if(!upperBound){
+    msagCritical[m].clear();
+    for(int e : solver.criticalCycle()){
+      if(graph.source(e) < n_actors) msagCritical[m].push_back(graph.source(e));
+    }
+  }
+
+  if(printDebug && !upperBound){
+    cout << "Period of MSAG " << m << ": " << max_cr << " (" << solver.iterations() << " iterations)" << endl;
+    cout << "Critical cycle:\n";
+    for(int e : solver.criticalCycle()){
+      cout << "(" << graph.source(e) << "," << graph.succ[e] << ") ";
+    }
+    cout << endl;
+
+    //cross-check against the boost implementation
+    using namespace boost;
+    boost_msag b_graph;
+    toBoostMSAG(m, upperBound, b_graph);
+    property_map<boost_msag, vertex_index_t>::type vim = get(vertex_index, b_graph);
+    property_map<boost_msag, edge_weight_t>::type ew1 = get(edge_weight, b_graph);
+    property_map<boost_msag, edge_weight2_t>::type ew2 = get(edge_weight2, b_graph);
+    int boost_cr = maximum_cycle_ratio(b_graph, vim, ew1, ew2);
+    if(boost_cr != max_cr){
+      cout << "Warning: boost::maximum_cycle_ratio gives " << boost_cr << " for MSAG " << m << endl;
+    }
+  }
+  return max_cr;
+}
+
 void checkApp(int app, unordered_map<int, set<int>>& coMappedApps, vector<int>& uncheckedApps, set<int>& res) {
   res.insert(app);
   uncheckedApps[app] = 0;
@@ -1460,220 +1236,146 @@ void checkApp(int app, unordered_map<int, set<int>>& coMappedApps, vector<int>&
       checkApp(appl, coMappedApps, uncheckedApps, res);
 }
 
-ExecStatus ThroughputMCR::propagate(Space& home, const ModEventDelta&) {
+ExecStatus ThroughputMCR::advise(Space& home, Advisor& _a, const Delta& d) {
+  ViewChange& a = static_cast<ViewChange&>(_a);
+
+  if(a.key < 0){ //next, sendingNext or receivingNext: only decided values change the MSAG structure
+    if(a.view().assigned()){
+      structureDirty = true;
+      return home.ES_FIX_DISPOSE(council, a);
+    }
+    return ES_FIX;
+  }
+
+  if(a.key == valueKey(V_SENDTIME, a.index)){
+    //moving a channel on or off the interconnect adds or removes communication actors
+    if((a.view().min() > 0) != onInterconnect[a.index] || a.view().assigned() != sendAssigned[a.index])
+      structureDirty = true;
+  }
+  dirtyKeys.push_back(a.key);
+
+  if(a.view().assigned())
+    return home.ES_FIX_DISPOSE(council, a);
+  return ES_FIX;
+}
+
+ExecStatus ThroughputMCR::propagate(Space& home, const ModEventDelta& med){
+  tools::PropagatorStats::Call call(tools::PropagatorStats::THROUGHPUT_MCR);
+  ExecStatus es = doPropagate(home, med);
+  call.failed(es == ES_FAILED);
+  return es;
+}
+
+ExecStatus ThroughputMCR::doPropagate(Space& home, const ModEventDelta&) {
   if(printDebug)
     cout << "\tThroughputMCR::propagate()" << endl;
 
-  //auto _start = std::chrono::high_resolution_clock::now(); //timer
-  //int time; //runtime of period calculation
-  
+  auto _start = std::chrono::high_resolution_clock::now(); //timer
+  calls++;
+
   vector<int> appFixed(apps.size(), true);
   vector<int> msagMap(apps.size(), 0);
   bool findUpperBound = sendingNext.assigned() && next.assigned() && receivingNext.assigned() &&
                      (!sendingTime.assigned() || !sendingLatency.assigned() || !wcet.assigned());
   vector<int> period_upperBound(apps.size(), 0);
 
-  //if(apps.size() > 1){
-    //check which application graphs are mapped to same processor (= combined into the same MSAG)
-    vector<set<int>> result;
-    unordered_map<int, set<int>> coMappedApps;
-    vector<int> uncheckedApps(apps.size(), 1);
-    for(int a = 0; a < apps.size(); a++){
-      coMappedApps.insert(pair<int, set<int>>(a, set<int>()));
-    }
-    for(int i = 0; i < n_actors; i++){
-      if(next[i].assigned() && next[i].val() < n_actors){ //next[i] is decided and points to an application actor
-        int actor = i;
-        int nextActor = next[i].val();
-        if(getApp(actor) != getApp(nextActor)){ //from different applications
-          unordered_map<int, set<int>>::const_iterator it = coMappedApps.find(getApp(actor));
-          if(it != coMappedApps.end()){ //i already has an entry in the map
-            coMappedApps.at(getApp(actor)).insert(getApp(nextActor));
-          }else{ //no entry for ch_src[i] yet
-            set<int> coApp;
-            coApp.insert(getApp(nextActor));
-            coMappedApps.insert(pair<int, set<int>>(getApp(actor), coApp));
-          }
-          it = coMappedApps.find(getApp(nextActor));
-          if(it != coMappedApps.end()){ //i already has an entry in the map
-            coMappedApps.at(getApp(nextActor)).insert(getApp(actor));
-          }else{ //no entry for ch_src[i] yet
-            set<int> coApp;
-            coApp.insert(getApp(actor));
-            coMappedApps.insert(pair<int, set<int>>(getApp(nextActor), coApp));
-          }
-        }
-      }
-    }
-//    if(coMappedApps.size() > 0){
-
-      int sum_unchecked = 0;
-      for(int x : uncheckedApps)
-        sum_unchecked += x;
-      while(sum_unchecked){
-
-        for(auto& mapp : coMappedApps){
-          if(printDebug){
-            cout << "App " << mapp.first << " is" << (mapp.second.empty() ? " not " : " ") << "co-mapped with ";
-            cout << (mapp.second.empty() ? string(" any other app") : tools::toString(mapp.second)) << endl;
-          }
-
-          if(uncheckedApps[mapp.first]){
-            set<int> res;
-            result.push_back(res);
-            checkApp(mapp.first, coMappedApps, uncheckedApps, result.back());
-          }
-        }
-
-        sum_unchecked = 0;
-        for(int x : uncheckedApps)
-          sum_unchecked += x;
-
-      }
-
-//    }else{
-//      for(size_t i = 0; i < wc_period.size(); i++){
-//        set<int> res;
-//        res.insert(i);
-//        result.push_back(res);
-//      }
-//    }
-    for(size_t i = 0; i < result.size(); i++){
-      b_msags.push_back(new boost_msag());
-      for(auto it = result[i].begin(); it != result[i].end(); ++it){
-        msagMap[*it] = i;
+  //check which application graphs are mapped to same processor (= combined into the same MSAG)
+  vector<set<int>> result;
+  unordered_map<int, set<int>> coMappedApps;
+  vector<int> uncheckedApps(apps.size(), 1);
+  for(int a = 0; a < apps.size(); a++){
+    coMappedApps.insert(pair<int, set<int>>(a, set<int>()));
+  }
+  for(int i = 0; i < n_actors; i++){
+    if(next[i].assigned() && next[i].val() < n_actors){ //next[i] is decided and points to an application actor
+      int app = getApp(i);
+      int nextApp = getApp(next[i].val());
+      if(app != nextApp){ //from different applications
+        coMappedApps.at(app).insert(nextApp);
+        coMappedApps.at(nextApp).insert(app);
       }
-      if(findUpperBound) b_msags_upperBound.push_back(new boost_msag());
     }
-    vector<bool> msagFixed = constructMSAG(msagMap, findUpperBound);
-
+  }
+  //iterate the applications in order, so that the MSAG numbering is stable between propagations
+  for(int a = 0; a < apps.size(); a++){
     if(printDebug){
-      if(next.assigned() && wcet.assigned()){
-        cout << "trying to print " << b_msags.size() << " boost-msags." << endl;
-        for(size_t t = 0; t < b_msags.size(); t++){
-          cout << "Graph " << t << endl;
-          cout << "  Vertices number: " << num_vertices(*b_msags[t]) << endl;
-          cout << "  Edges number: " << num_edges(*b_msags[t]) << endl;
-          string graphName = "boost_msag" + to_string(t);
-          ofstream out;
-          string outputFile = ".";
-          outputFile += (outputFile.back() == '/') ? (graphName + ".dot") : ("/" + graphName + ".dot");
-          out.open(outputFile.c_str());
-          write_graphviz(out, *b_msags[t]);
-          out.close();
-          cout << "  Printed dot graph file " << outputFile << endl;
-        }
-        printThroughputGraphAsDot(".");
-      }
+      cout << "App " << a << " is" << (coMappedApps[a].empty() ? " not " : " ") << "co-mapped with ";
+      cout << (coMappedApps[a].empty() ? string(" any other app") : tools::toString(coMappedApps[a])) << endl;
     }
-
-    vector<int> msag_mcrs;
-    for(auto m : b_msags){
-      using namespace boost;
-      int max_cr; /// maximum cycle ratio
-      typedef std::vector<graph_traits<boost_msag>::edge_descriptor> t_critCycl;
-      t_critCycl cc; ///critical cycle
-      property_map<boost_msag, vertex_index_t>::type vim = get(vertex_index, *m);
-      property_map<boost_msag, edge_weight_t>::type ew1 = get(edge_weight, *m);
-      property_map<boost_msag, edge_weight2_t>::type ew2 = get(edge_weight2, *m);
-
-      //do MCR analysis
-      max_cr = maximum_cycle_ratio(*m, vim, ew1, ew2, &cc);
-      msag_mcrs.push_back(max_cr);
-
-      if(printDebug){
-        cout << "Period of app(s) " << tools::toString(result[msag_mcrs.size()-1]) << ": ";
-        cout <<  max_cr << endl;
-        cout << "Critical cycle:\n";
-        for(t_critCycl::iterator itr = cc.begin(); itr != cc.end(); ++itr){
-          cout << "(" << vim[source(*itr, *m)] << "," << vim[target(*itr, *m)] << ") ";
-        }
-        cout << endl;
-      }
+    if(uncheckedApps[a]){
+      set<int> res;
+      result.push_back(res);
+      checkApp(a, coMappedApps, uncheckedApps, result.back());
     }
-    vector<int> msag_mcrs_upperBound;
-    if(findUpperBound){
-      for(auto m : b_msags_upperBound){
-        using namespace boost;
-        int max_cr; /// maximum cycle ratio
-        typedef std::vector<graph_traits<boost_msag>::edge_descriptor> t_critCycl;
-        t_critCycl cc; ///critical cycle
-        property_map<boost_msag, vertex_index_t>::type vim = get(vertex_index, *m);
-        property_map<boost_msag, edge_weight_t>::type ew1 = get(edge_weight, *m);
-        property_map<boost_msag, edge_weight2_t>::type ew2 = get(edge_weight2, *m);
-
-        //do MCR analysis
-        max_cr = maximum_cycle_ratio(*m, vim, ew1, ew2, &cc);
-        msag_mcrs_upperBound.push_back(max_cr);
-      }
+  }
+  for(size_t i = 0; i < result.size(); i++){
+    for(auto it = result[i].begin(); it != result[i].end(); ++it){
+      msagMap[*it] = i;
     }
-    for(size_t i = 0; i < msag_mcrs.size(); i++){
-      for(auto r: result[i]){
-        wc_period[r] = msag_mcrs[i];
-        if(findUpperBound) period_upperBound[r] = msag_mcrs_upperBound[i];
-        appFixed[r] = msagFixed[i];
-      }
+  }
+  int n_msags = result.size();
+
+  //rebuild the edge lists only if the structure of the MSAG changed, otherwise only update the delays and tokens
+  if(!incremental || structureDirty || msagMap != msagMapCache || (int)msagEdges.size() != n_msags){
+    constructMSAG(msagMap, n_msags);
+  }else{
+    patchMSAG();
+    if(printDebug)
+      checkPatchedMSAG(msagMap, n_msags);
+  }
+  dirtyKeys.clear();
+  structureDirty = false;
+  tools::PropagatorStats::size(n_msagActors);
+  vector<bool> msagFixed = fixedMSAGs(msagMap, n_msags);
+
+  for(int m = 0; m < n_msags; m++){
+    if(msagDirty[m] || msagPeriod[m] < 0){
+      msagPeriod[m] = cycleRatio(m, false);
+      msagPeriodUB[m] = -1;
+      msagDirty[m] = false;
     }
+    if(findUpperBound && msagPeriodUB[m] < 0){
+      msagPeriodUB[m] = cycleRatio(m, true);
+    }
+  }
+  if(find(msagFixed.begin(), msagFixed.end(), false) == msagFixed.end()){ //a solution: report its critical cycles
+    lastCriticalActors.clear();
+    for(int m = 0; m < n_msags; m++){
+      lastCriticalActors.insert(lastCriticalActors.end(), msagCritical[m].begin(), msagCritical[m].end());
+    }
+    sort(lastCriticalActors.begin(), lastCriticalActors.end());
+    lastCriticalActors.erase(unique(lastCriticalActors.begin(), lastCriticalActors.end()), lastCriticalActors.end());
+  }
 
-  /*}else{ //only a single application
-    constructMSAG();
-    using namespace boost;
-    int max_cr; /// maximum cycle ratio
-    typedef std::vector<graph_traits<boost_msag>::edge_descriptor> t_critCycl;
-    t_critCycl cc; ///critical cycle
-
-    property_map<boost_msag, vertex_index_t>::type vim = get(vertex_index, b_msag);
-    property_map<boost_msag, edge_weight_t>::type ew1 = get(edge_weight, b_msag);
-    property_map<boost_msag, edge_weight2_t>::type ew2 = get(edge_weight2, b_msag);
-    //do MCR analysis
-    max_cr = maximum_cycle_ratio(b_msag, vim, ew1, ew2, &cc);
-    wc_period[0] = max_cr;
-    appFixed[0] = next.assigned() && wcet.assigned() && sendingTime.assigned() 
-                  && sendingLatency.assigned() && sendingNext.assigned()
-                  && receivingTime.assigned(); 
-
-    if(printDebug){
-      if(next.assigned() && wcet.assigned()){
-        string graphName = "boost_msag";
+  if(printDebug){
+    if(next.assigned() && wcet.assigned()){
+      cout << "trying to print " << n_msags << " boost-msags." << endl;
+      for(int t = 0; t < n_msags; t++){
+        boost_msag graph;
+        toBoostMSAG(t, false, graph);
+        cout << "Graph " << t << endl;
+        cout << "  Vertices number: " << num_vertices(graph) << endl;
+        cout << "  Edges number: " << num_edges(graph) << endl;
+        string graphName = "boost_msag" + to_string(t);
         ofstream out;
         string outputFile = ".";
         outputFile += (outputFile.back() == '/') ? (graphName + ".dot") : ("/" + graphName + ".dot");
         out.open(outputFile.c_str());
-        write_graphviz(out, b_msag);
+        write_graphviz(out, graph);
         out.close();
-        printThroughputGraphAsDot(".");
+        cout << "  Printed dot graph file " << outputFile << endl;
       }
+      printThroughputGraphAsDot(".");
+    }
+  }
 
-      cout << "Maximum cycle ratio is " << max_cr << endl;
-      cout << "Critical cycle:\n";
-      for(t_critCycl::iterator itr = cc.begin(); itr != cc.end(); ++itr){
-        cout << "(" << vim[source(*itr, b_msag)] << "," << vim[target(*itr, b_msag)] << ") ";
-      }
-      cout << endl;
+  for(size_t i = 0; i < result.size(); i++){
+    for(auto r: result[i]){
+      wc_period[r] = msagPeriod[i];
+      if(findUpperBound) period_upperBound[r] = msagPeriodUB[i];
+      appFixed[r] = msagFixed[i];
     }
-  }*/
-
-  //constructMSAG();
-
-//    if(next.assigned() && wcet.assigned()){
-//        printThroughputGraphAsDot(".");
-//        getchar();
-//    }
-
-  //bool all_assigned = next.assigned() && wcet.assigned() && sendingTime.assigned() && sendingLatency.assigned() && sendingNext.assigned()
-   //   && receivingTime.assigned(); //&&
-      //receivingNext.assigned() &&
-      //sendbufferSz.assigned() &&
-      //recbufferSz.assigned();
-//cout << "next.assigned(): " << next.assigned() << endl;
-//cout << "wcet.assigned(): " << wcet.assigned() << endl;
-//cout << "sendingTime.assigned(): " << sendingTime.assigned() << endl;
-//cout << "sendingLatency.assigned(): " << sendingLatency.assigned() << endl;
-//cout << "sendingNext.assigned(): " << sendingNext.assigned() << endl;
-//cout << "receivingTime.assigned(): " << receivingTime.assigned() << endl;
-//cout << "receivingNext.assigned(): " << receivingNext.assigned() << endl;
-
-//cout << "all_assigned: " << all_assigned  << endl;
+  }
 
   bool all_ch_local = true;
   for(int i = 0; i < n_channels; i++){
@@ -1692,45 +1394,10 @@ ExecStatus ThroughputMCR::propagate(Space& home, const ModEventDelta&) {
         GECODE_ME_CHECK(period[i].lq(home, period_upperBound[i]));
       }
     }
-
-    //if(!all_assigned && !all_ch_local){
-//          GECODE_ME_CHECK(latency[i].gq(home, wc_latency[i][0]));
-      //GECODE_ME_CHECK(period[i].gq(home, wc_period[i]));
-    //}else if(all_assigned){
-//          GECODE_ME_CHECK(latency[i].eq(home, wc_latency[i][0]));
-      //GECODE_ME_CHECK(period[i].eq(home, wc_period[i]));
-    //}
   }
-  /*
-   //propagate bounds on iterations of entities and channels in time-based schedule
-   for(int i=0; i<n_actors; i++){
-   //if(next.assigned())GECODE_ME_CHECK(iterations[i].gq(home,min_iterations[i]));
-   //if(all_assigned)GECODE_ME_CHECK(iterations[i].gq(home,min_iterations[i]));
-   if(all_assigned)GECODE_ME_CHECK(iterations[i].lq(home,max_iterations[i])); //upper bound can increase from "no mapping" until "fixed mapping" (due to added communication delays)
-   }
-   for(int i=n_actors; i<n_msagActors; i++){
-   //for now, only consider the sending part for each channel
-   if((i-n_actors)%2==0){
-   //if(next.assigned())GECODE_ME_CHECK(iterationsCh[channelMapping[i]].gq(home,min_iterations[i]));
-   //if(all_assigned)GECODE_ME_CHECK(iterationsCh[channelMapping[i]].gq(home,min_iterations[i]));
-   if(all_assigned)GECODE_ME_CHECK(iterationsCh[channelMapping[i]].lq(home,max_iterations[i])); //upper bound can increase from "no mapping" until "fixed mapping" (due to added communication delays)
-   }
-   }*/
 
-  b_msag.clear();
-  for(size_t t = 0; t < b_msags.size(); t++){
-    //b_msags[t]->clear();
-    delete b_msags[t];
-  }
-  b_msags.clear();
-  for(size_t t = 0; t < b_msags_upperBound.size(); t++){
-    //b_msags[t]->clear();
-    delete b_msags_upperBound[t];
-  }
-  b_msags_upperBound.clear();
+  //the edge lists, channelMapping and receivingActors are kept for the next propagation
   msaGraph.clear();
-  channelMapping.clear();
-  receivingActors.clear();
 
   max_start.clear();
   max_end.clear();
@@ -1738,19 +1405,28 @@ ExecStatus ThroughputMCR::propagate(Space& home, const ModEventDelta&) {
   min_end.clear();
   start_pp.clear();
   end_pp.clear();
-  //min_iterations.clear();
-  //max_iterations.clear();
   min_send_buffer.clear();
   max_send_buffer.clear();
   min_rec_buffer.clear();
   max_rec_buffer.clear();
-  
+
+  auto _end = std::chrono::high_resolution_clock::now();
+  total_time += std::chrono::duration_cast<std::chrono::microseconds>(_end - _start).count();
+  if(printDebug){
+    cout << "\tThroughputMCR: " << calls << " calls, " << rebuilds << " rebuilds, " << cycleRatios;
+    cout << " cycle ratios, " << total_time << " us" << endl;
+    size_t edges = 0;
+    for(auto& m_edges : msagEdges)
+      edges += m_edges.size();
+    cout << "\tThroughputMCR: " << n_msags << " MSAGs with " << edges << " edges, ";
+    cout << edges * sizeof(MsagEdge) << " bytes" << endl;
+  }
+
   bool allFixed = true;
   for(int i = 0; i < period.size(); i++){
     allFixed &= appFixed[i];
   }
 
-  //if(next.assigned() && wcet.assigned() && sendingTime.assigned() && sendingLatency.assigned() && receivingTime.assigned() && receivingNext.assigned()){
   if(allFixed){
     return home.ES_SUBSUMED(*this);
   }
@@ -29,6 +29,7 @@
 
 
 #include "../tools/tools.hpp"
+#include "howardMCR.hpp"
 
 #include <gecode/int.hh>
 #include <vector>
@@ -78,6 +79,40 @@ private:
       SuccessorNode():successor_key(-1){};
 
   };
+  //sources of the values (delays and tokens) of MSAG edges, used to compute value keys
+  enum ValueSource { V_WCET, V_SENDLAT, V_SENDTIME, V_RECTIME, V_SENDBUF, V_RECBUF };
+  //codes for the advisors on the views that determine the structure of the MSAG
+  enum StructureSource { S_NEXT = -1, S_SENDNEXT = -2, S_RECNEXT = -3 };
+  //an edge of the (incrementally maintained) MSAG
+  class MsagEdge{
+    public:
+      int src;
+      int dst;
+      int w_key; //value key of the view the delay is read from
+      int t_key; //value key of the view the tokens are read from (-1: constant tokens)
+      int tokens;
+      int delay; //delay for the lower bound (view min)
+      int delay_ub; //delay for the upper bound (view max)
+
+      bool operator==(const MsagEdge& e) const {
+        return src == e.src && dst == e.dst && w_key == e.w_key && t_key == e.t_key
+               && tokens == e.tokens && delay == e.delay && delay_ub == e.delay_ub;
+      }
+  };
+  //advisor recording which view has been modified
+  class ViewChange : public ViewAdvisor<IntView> {
+    public:
+      int key; //value key, or StructureSource for next/sendingNext/receivingNext
+      int index; //index of the view in its array
+
+      ViewChange(Space& home, Propagator& p, Council<ViewChange>& c, IntView x, int _key, int _index)
+        : ViewAdvisor<IntView>(home, p, c, x), key(_key), index(_index) {}
+      ViewChange(Space& home, bool share, ViewChange& a)
+        : ViewAdvisor<IntView>(home, share, a), key(a.key), index(a.index) {}
+      void dispose(Space& home, Council<ViewChange>& c) {
+        ViewAdvisor<IntView>::dispose(home, c);
+      }
+  };
 protected:
   ViewArray<IntView> latency; //resulting initial latency
   ViewArray<IntView> period; //resulting period
@@ -110,9 +145,6 @@ protected:
   unordered_map<int,vector<SuccessorNode>> msaGraph;
   //MSAG representation for boost
   boost_msag b_msag;
-  //MSAG representation for boost
-  vector<boost_msag*> b_msags;
-  vector<boost_msag*> b_msags_upperBound;
   //for mapping from msag send/rec actors to appG-channels
   vector<int> channelMapping;
   //receivingActors: for storing/finding the first receiving actor for each dst
@@ -134,14 +166,59 @@ protected:
   vector<int> min_rec_buffer; //min buffer size of all appG-channels
   vector<int> max_rec_buffer; //max buffer size of all appG-channels
 
+  //incremental MSAG: one edge list per MSAG, patched between propagations
+  Council<ViewChange> council; //advisors on all views the MSAG depends on
+  vector<vector<MsagEdge>> msagEdges; //msagEdges[m]: edges of MSAG m
+  vector<MSAG> msagGraph; //CSR layout of msagEdges[m] (lower-bound delays), patched together with the edges
+  vector<vector<int>> msagWeightUB; //upper-bound delays of msagGraph[m], by CSR edge index
+  vector<vector<int>> msagCsrEdge; //msagCsrEdge[m][e]: CSR edge index of msagEdges[m][e]
+  vector<int> msagMapCache; //app -> MSAG mapping the edge lists were built for
+  vector<int> msagPeriod; //cached cycle ratio of each MSAG (-1: not computed)
+  vector<int> msagPeriodUB; //cached cycle ratio of each MSAG with upper-bound delays (-1: not computed)
+  vector<HowardMCR> msagSolver; //cycle ratio solver of each MSAG, keeps the last policy for warm starts
+  vector<HowardMCR> msagSolverUB; //same, for the upper bound
+  vector<vector<int>> msagCritical; //actors on the critical cycle of each MSAG (lower bound)
+  vector<bool> msagDirty; //MSAG has changed since its cycle ratio was computed
+  vector<bool> onInterconnect; //channel was on the interconnect when the edges were built
+  vector<bool> sendAssigned; //sendingTime of channel was assigned when the edges were built
+  bool structureDirty; //next, sendingNext, receivingNext or the channel placement has changed
+  vector<int> dirtyKeys; //value keys of views modified since the last propagation
+  vector<vector<pair<int,int>>> keyRefs; //value key -> (MSAG, edge) pairs that read the value
+  bool keyRefsValid; //keyRefs is derived data and not copied with the propagator
+
   //for evaluation purposes
+  bool incremental; //false: rebuild the MSAG on every propagation (for comparison)
+  int calls;
+  int rebuilds; //number of propagations that rebuilt the MSAG edges
+  int cycleRatios; //number of cycle ratio computations
+  long total_time; //total propagation time (us)
   bool printDebug;
   
   //builds the msaGraph based on the current state of the solution
   void constructMSAG();
-  //builds the msaGraph based on the current state of the solution
-  //the coMapped vector specifies for each application, which MSAG it is part of
-  vector<bool> constructMSAG(vector<int> &msagMap, bool upperBound);
+  //builds the edge lists of all MSAGs based on the current state of the solution
+  //msagMap specifies for each application, which MSAG it is part of
+  void constructMSAG(const vector<int> &msagMap, int n_msags);
+  //updates only the edges that read a value modified since the last propagation
+  void patchMSAG();
+  //debug: rebuilds the MSAGs and warns if they differ from the patched ones
+  void checkPatchedMSAG(const vector<int> &msagMap, int n_msags);
+  //builds keyRefs from the current edge lists
+  void indexMSAG();
+  //lays out the edges of MSAG m in msagGraph[m], after its edge list has changed
+  void layoutMSAG(int m);
+  //for each MSAG, whether all views it depends on are assigned
+  vector<bool> fixedMSAGs(const vector<int> &msagMap, int n_msags) const;
+  void addEdge(vector<vector<MsagEdge>>& edges, const vector<int>& msagId, int src, int dst,
+               int w_key, int t_key, int tokens) const;
+  //re-reads delay and tokens of e from the views, returns whether they changed
+  bool refreshEdge(MsagEdge& e) const;
+  int valueKey(ValueSource source, int index) const;
+  int keyMin(int key) const;
+  int keyMax(int key) const;
+  //converts MSAG m into a boost graph, with upper-bound delays if upperBound
+  void toBoostMSAG(int m, bool upperBound, boost_msag& graph) const;
+  int cycleRatio(int m, bool upperBound);
   int getBlockActor(int ch_id) const;
   int getSendActor(int ch_id) const;
   int getRecActor(int ch_id) const;
@@ -151,6 +228,13 @@ protected:
 
 
 public:
+  /**
+   * Actors on the critical cycles of the last solution (all MSAGs fixed)
+   * that was analysed in the calling thread, in increasing order. Used to
+   * guide the neighbourhoods of large neighbourhood search.
+   */
+  static vector<int> criticalActors();
+
 ThroughputMCR(Space& home, ViewArray<IntView> p_latency,
                          ViewArray<IntView> p_period,  
                          //ViewArray<IntView> p_iterations, 
@@ -209,8 +293,13 @@ virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
 
 virtual void reschedule(Space& home);
 
+virtual ExecStatus advise(Space& home, Advisor& a, const Delta& d);
+
 virtual ExecStatus propagate(Space& home, const ModEventDelta&);
 
+//the propagation itself, propagate() accounts its CPU time
+ExecStatus doPropagate(Space& home, const ModEventDelta&);
+
 };
 
 
@@ -1,5 +1,6 @@
 
 #include "throughputSSE.hpp"
+#include "../tools/propagator_stats.hpp"
 
 using namespace Gecode;
 using namespace Int;
@@ -71,6 +72,8 @@ Propagator(home), latency(p_latency), period(p_period),
 
   calls=0;
   total_time=0;
+  sseSteps=0;
+  total_sseSteps=0;
 
   home.notice(*this, AP_DISPOSE);
   }
@@ -94,7 +97,7 @@ size_t ThroughputSSE::dispose(Space& home){
   msaGraph.~unordered_map<int,vector<SuccessorNode>>();
   channelMapping.~vector<int>();
   receivingActors.~vector<int>();
-  ch_state.~vector<int>();
+  msag.~MSAG();
   actor_delay.~vector<int>();
 
   wc_latency.~vector<vector<int>>(); 
@@ -133,12 +136,14 @@ ThroughputSSE::ThroughputSSE(Space& home, bool share, ThroughputSSE& p):
   msaGraph(p.msaGraph),
   channelMapping(p.channelMapping),
   receivingActors(p.receivingActors),
-  ch_state(p.ch_state),
+  msag(p.msag),
   actor_delay(p.actor_delay),
   wc_latency(p.wc_latency),
   wc_period(p.wc_period),
   calls(p.calls),
   total_time(p.total_time),
+  sseSteps(p.sseSteps),
+  total_sseSteps(p.total_sseSteps),
   printDebug(p.printDebug) {
   latency.update(home, share, p.latency);
   period.update(home, share, p.period);
@@ -191,12 +196,11 @@ void ThroughputSSE::debug_constructMSAG(){
   }
   
   msaGraph.clear();
-  ch_state.clear();
   actor_delay.clear();
   receivingActors.clear();
   channelMapping.clear();
   
-  ch_state.insert(ch_state.begin(), n_msagActors*n_msagActors, -1);
+  msag.clear(n_msagActors);
   actor_delay.insert(actor_delay.begin(), n_msagActors, 0);
   receivingActors.insert(receivingActors.begin(), n_actors, -1); //pre-fill with -1
 
@@ -239,7 +243,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add ch_src[i]->block_actor to state of SSE
-      ch_state[ch_src[i]*n_msagActors+block_actor] = succB.max_tok;
+      msag.setEdge(ch_src[i], block_actor, succB.max_tok);
       actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
       actor_delay[block_actor] = sendingLatency[i].min();
 
@@ -262,7 +266,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add block_actor->ch_src[i] to state of SSE
-      ch_state[block_actor*n_msagActors+ch_src[i]] = srcCh.max_tok;
+      msag.setEdge(block_actor, ch_src[i], srcCh.max_tok);
       actor_delay[block_actor] = sendingLatency[i].min();
       actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
       //###
@@ -286,7 +290,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add block_actor->send_actor to state of SSE
-      ch_state[block_actor*n_msagActors+send_actor] = succS.max_tok;
+      msag.setEdge(block_actor, send_actor, succS.max_tok);
       actor_delay[block_actor] = sendingLatency[i].min();
       actor_delay[send_actor] = sendingTime[i].min();
 
@@ -310,7 +314,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add send_actor -> block_actor to state of SSE
-      ch_state[send_actor*n_msagActors+block_actor] = succBS.max_tok;
+      msag.setEdge(send_actor, block_actor, succBS.max_tok);
       actor_delay[send_actor] = sendingTime[i].min();
       actor_delay[block_actor] = sendingLatency[i].min();
       //###
@@ -335,7 +339,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add send_actor->rec_actor to state of SSE
-      ch_state[send_actor*n_msagActors+rec_actor] = dstCh.max_tok;
+      msag.setEdge(send_actor, rec_actor, dstCh.max_tok);
       actor_delay[send_actor] = sendingTime[i].min();
       actor_delay[rec_actor] = receivingTime[i].min();
      
@@ -394,7 +398,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add rec_actor->send_actor to state of SSE
-      ch_state[rec_actor*n_msagActors+send_actor] = succRec.max_tok;
+      msag.setEdge(rec_actor, send_actor, succRec.max_tok);
       actor_delay[rec_actor] = receivingTime[i].min();
       actor_delay[send_actor] = sendingTime[i].min();
       
@@ -424,7 +428,7 @@ void ThroughputSSE::debug_constructMSAG(){
           }
         }
         //add ch_src[i]->ch_dst[i] to state of SSE
-        ch_state[ch_src[i]*n_msagActors+ch_dst[i]] = tok[i];
+        msag.setEdge(ch_src[i], ch_dst[i], tok[i]);
         actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
         actor_delay[ch_dst[i]] = wcet[ch_dst[i]].min();
       }
@@ -534,7 +538,7 @@ void ThroughputSSE::debug_constructMSAG(){
           }
         }
         //add i -> block_actor to state of SSE
-        ch_state[(i+n_actors)*n_msagActors+block_actor] = succBS.max_tok;
+        msag.setEdge((i+n_actors), block_actor, succBS.max_tok);
         actor_delay[i+n_actors] = sendingTime[channelMapping[i]].min();
         actor_delay[block_actor] = sendingLatency[nextCh].min();
       }
@@ -607,7 +611,7 @@ void ThroughputSSE::debug_constructMSAG(){
       }
     }
     //add i -> block_actor to state of SSE
-    ch_state[(i+n_actors)*n_msagActors+succRec.successor_key] = succRec.max_tok;
+    msag.setEdge((i+n_actors), succRec.successor_key, succRec.max_tok);
     actor_delay[i+n_actors] = receivingTime[channelMapping[i]].min();
     actor_delay[succRec.successor_key] = succRec.delay;
   }
@@ -661,7 +665,7 @@ void ThroughputSSE::debug_constructMSAG(){
         }
       }
       //add i->nextA to state of SSE
-      ch_state[i*n_msagActors+nextA.successor_key] = nextA.max_tok;
+      msag.setEdge(i, nextA.successor_key, nextA.max_tok);
       actor_delay[i] = wcet[i].min();
       actor_delay[nextA.successor_key] = nextA.delay;
         
@@ -738,12 +742,13 @@ void ThroughputSSE::debug_constructMSAG(){
           }
         }
         //add i->ch_first to state of SSE
-        ch_state[i*n_msagActors+first.successor_key] = first.max_tok;
+        msag.setEdge(i, first.successor_key, first.max_tok);
         actor_delay[i] = wcet[i].min();
         actor_delay[first.successor_key] = first.delay;
       }
     }
   }
+  msag.build();
  
   if(printDebug){
     /*cout << "initial state for SSE: " << endl;
@@ -783,12 +788,11 @@ void ThroughputSSE::constructMSAG(){
   }
   
   msaGraph.clear();
-  ch_state.clear();
   actor_delay.clear();
   receivingActors.clear();
   channelMapping.clear();
   
-  ch_state.insert(ch_state.begin(), n_msagActors*n_msagActors, -1);
+  msag.clear(n_msagActors);
   actor_delay.insert(actor_delay.begin(), n_msagActors, 0);
   receivingActors.insert(receivingActors.begin(), n_actors, -1); //pre-fill with -1
 
@@ -831,7 +835,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add ch_src[i]->block_actor to state of SSE
-      ch_state[ch_src[i]*n_msagActors+block_actor] = succB.max_tok;
+      msag.setEdge(ch_src[i], block_actor, succB.max_tok);
       actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
       actor_delay[block_actor] = sendingLatency[i].min();
 
@@ -854,7 +858,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add block_actor->ch_src[i] to state of SSE
-      ch_state[block_actor*n_msagActors+ch_src[i]] = srcCh.max_tok;
+      msag.setEdge(block_actor, ch_src[i], srcCh.max_tok);
       actor_delay[block_actor] = sendingLatency[i].min();
       actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
       //###
@@ -878,7 +882,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add block_actor->send_actor to state of SSE
-      ch_state[block_actor*n_msagActors+send_actor] = succS.max_tok;
+      msag.setEdge(block_actor, send_actor, succS.max_tok);
       actor_delay[block_actor] = sendingLatency[i].min();
       actor_delay[send_actor] = sendingTime[i].min();
 
@@ -902,7 +906,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add send_actor -> block_actor to state of SSE
-      ch_state[send_actor*n_msagActors+block_actor] = succBS.max_tok;
+      msag.setEdge(send_actor, block_actor, succBS.max_tok);
       actor_delay[send_actor] = sendingTime[i].min();
       actor_delay[block_actor] = sendingLatency[i].min();
       //###
@@ -927,7 +931,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add send_actor->rec_actor to state of SSE
-      ch_state[send_actor*n_msagActors+rec_actor] = dstCh.max_tok;
+      msag.setEdge(send_actor, rec_actor, dstCh.max_tok);
       actor_delay[send_actor] = sendingTime[i].min();
       actor_delay[rec_actor] = receivingTime[i].min();
      
@@ -972,7 +976,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add rec_actor->send_actor to state of SSE
-      ch_state[rec_actor*n_msagActors+send_actor] = succRec.max_tok;
+      msag.setEdge(rec_actor, send_actor, succRec.max_tok);
       actor_delay[rec_actor] = receivingTime[i].min();
       actor_delay[send_actor] = sendingTime[i].min();
       
@@ -1002,7 +1006,7 @@ void ThroughputSSE::constructMSAG(){
           }
         }
         //add ch_src[i]->ch_dst[i] to state of SSE
-        ch_state[ch_src[i]*n_msagActors+ch_dst[i]] = tok[i];
+        msag.setEdge(ch_src[i], ch_dst[i], tok[i]);
         actor_delay[ch_src[i]] = wcet[ch_src[i]].min();
         actor_delay[ch_dst[i]] = wcet[ch_dst[i]].min();
       }
@@ -1085,7 +1089,7 @@ void ThroughputSSE::constructMSAG(){
           }
         }
         //add i -> block_actor to state of SSE
-        ch_state[(i+n_actors)*n_msagActors+block_actor] = succBS.max_tok;
+        msag.setEdge((i+n_actors), block_actor, succBS.max_tok);
         actor_delay[i+n_actors] = sendingTime[channelMapping[i]].min();
         actor_delay[block_actor] = sendingLatency[nextCh].min();
       }
@@ -1148,7 +1152,7 @@ void ThroughputSSE::constructMSAG(){
       }
     }
     //add i -> block_actor to state of SSE
-    ch_state[(i+n_actors)*n_msagActors+succRec.successor_key] = succRec.max_tok;
+    msag.setEdge((i+n_actors), succRec.successor_key, succRec.max_tok);
     actor_delay[i+n_actors] = receivingTime[channelMapping[i]].min();
     actor_delay[succRec.successor_key] = succRec.delay;
   }
@@ -1190,7 +1194,7 @@ void ThroughputSSE::constructMSAG(){
         }
       }
       //add i->nextA to state of SSE
-      ch_state[i*n_msagActors+nextA.successor_key] = nextA.max_tok;
+      msag.setEdge(i, nextA.successor_key, nextA.max_tok);
       actor_delay[i] = wcet[i].min();
       actor_delay[nextA.successor_key] = nextA.delay;
         
@@ -1234,12 +1238,13 @@ void ThroughputSSE::constructMSAG(){
           }
         }
         //add i->ch_first to state of SSE
-        ch_state[i*n_msagActors+first.successor_key] = first.max_tok;
+        msag.setEdge(i, first.successor_key, first.max_tok);
         actor_delay[i] = wcet[i].min();
         actor_delay[first.successor_key] = first.delay;
       }
     }
   }
+  msag.build();
  
   if(printDebug){
     /*cout << "initial state for SSE: " << endl;
@@ -1260,12 +1265,19 @@ void ThroughputSSE::constructMSAG(){
 }
 
 
-ExecStatus ThroughputSSE::propagate(Space& home, const ModEventDelta&){
+ExecStatus ThroughputSSE::propagate(Space& home, const ModEventDelta& med){
+  tools::PropagatorStats::Call call(tools::PropagatorStats::THROUGHPUT_SSE);
+  ExecStatus es = doPropagate(home, med);
+  call.failed(es == ES_FAILED);
+  return es;
+}
+
+ExecStatus ThroughputSSE::doPropagate(Space& home, const ModEventDelta&){
   if(printDebug) cout << "\tThroughputSSE::propagate()" << endl;
-  // auto _start = std::chrono::high_resolution_clock::now(); //timer
-  // int time; //runtime of period calculation
+  auto _start = std::chrono::high_resolution_clock::now(); //timer
   
   constructMSAG();
+  tools::PropagatorStats::size(n_msagActors);
   calls++;
   
   //debug_constructMSAG();
@@ -1300,7 +1312,18 @@ ExecStatus ThroughputSSE::propagate(Space& home, const ModEventDelta&){
     }
     cout << endl;*/
   
-  stateSpaceExploration();
+  bool explored = stateSpaceExploration();
+  tools::PropagatorStats::steps(sseSteps);
+  if(!explored){
+    return ES_FAILED;
+  }
+  total_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()-_start).count();
+  if(printDebug){
+    cout << "\tThroughputSSE: " << sseSteps << " SSE steps (" << total_sseSteps << " in " << calls << " calls), ";
+    cout << total_time << " us in total" << endl;
+    cout << "\tThroughputSSE: MSAG with " << n_msagActors << " actors and " << msag.edges() << " channels, ";
+    cout << msag.memory() << " bytes (dense: " << sizeof(int)*n_msagActors*n_msagActors << " bytes)" << endl;
+  }
   
   
   
@@ -1633,7 +1656,6 @@ ExecStatus ThroughputSSE::propagate(Space& home, const ModEventDelta&){
   msaGraph.clear();
   channelMapping.clear();
   receivingActors.clear();
-  ch_state.clear();
   actor_delay.clear();
 
   max_start.clear();
@@ -2021,43 +2043,25 @@ int ThroughputSSE::getApp(int msagActor_id) const{
 }
 
 /* Perform the state space exploration
- * state represented by: vector<int> ch_state and vector<int> actor_state
+ * state represented by: tokens on the edges of msag and vector<int> actor_state
  * execution times stored in: vector<int> actor_delay
  */
-void ThroughputSSE::stateSpaceExploration(){
+bool ThroughputSSE::stateSpaceExploration(){
   if(printDebug) cout << "\tThroughputSSE::stateSpaceExploration()" << endl;
   //for checking whether all actors have had two iterations
   int minIterations=0;
   //for checking whether min-schedule needs to be done
   int maxIterations=2;
   //for saving the states during SSE
-  vector<int> tokens(ch_state);
+  vector<int> tokens(msag.tokens); //tokens on each MSAG edge
   vector<int> execution;
   execution.insert(execution.begin(), n_msagActors, -1);
   //for passing time
   int time = 0;
   int timeStep = -1;
   
-  //for finding the minimal timed schedule, flip the MSAG
-  vector<int> ch_state_flipped(n_msagActors*n_msagActors, 0);
-  //Step 0: Flip the MSAG (mirror on diagonal)
-  for (auto i=0; i<n_msagActors; i++){
-    for (auto j=0; j<n_msagActors; j++){
-      ch_state_flipped[j*n_msagActors+i] = ch_state[i*n_msagActors+j];
-    }
-  }
-  /*  for (auto i=0; i<n_msagActors; i++){
-      for (auto j=0; j<n_msagActors; j++){
-      if(ch_state_flipped[i*n_msagActors+j] != -1)
-      if(ch_state_flipped[i*n_msagActors+j]>10)
-      cout << "B ";
-      else
-      cout << ch_state_flipped[i*n_msagActors+j] << " ";
-      else
-      cout << "X ";
-      }
-      cout << endl;
-      }*/
+  //for finding the minimal timed schedule, the MSAG is flipped: the edges are traversed
+  //in the opposite direction (incoming edges become outgoing ones and vice versa)
 
   //Initialize (initial state already set in function propagate)
   wc_latency.clear();
@@ -2094,140 +2098,141 @@ void ThroughputSSE::stateSpaceExploration(){
   vector<int> recBufferBound_min(ch_src.size(), 0);
 
 
-  //Three repeating steps:
+  sseSteps = 0;
+
+  //Event-driven, three repeating steps:
   //Step 1: start transitions, update state with consumed tokens & actor state
-  //Step 2: time transition, update state: actor state
+  //Step 2: time transition, directly to the next firing completion (min-heap)
   //Step 3: end transitions, update state with produced tokens & actor state
+  //Only actors that finished or received tokens in Step 3 can be activated in the following Step 1.
+  priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> events; //(end time, actor)
+  vector<int> candidates;
+  vector<bool> isCandidate(n_msagActors, true);
+  for (auto i=0; i<n_msagActors; i++){
+    candidates.push_back(i);
+  }
+  vector<int> finished;
+  //recurrent state detection: state = (tokens, remaining execution times). The exploration is
+  //deterministic, so once a state recurs, the states repeat in a cycle. Only one state is kept,
+  //with its hash and the iterations at that state, and replaced after 1, 2, 4, ... steps (Brent's
+  //cycle detection), which finds a recurrence within about twice the steps to the first one
+  vector<int> state;
+  vector<int> saved;
+  vector<int> savedIterations;
+  size_t savedHash = 0;
+  size_t power = 1, sinceSaved = 0;
   while(minIterations<2){
+    sseSteps++;
     //Step 1
-    for (auto i=0; i<n_msagActors; i++){
+    sort(candidates.begin(), candidates.end());
+    for (int i : candidates){
+      isCandidate[i] = false;
       if(execution[i] == -1){
         bool activate = true;
-        for (auto j=0; j<n_msagActors; j++){
-          if(tokens[j*n_msagActors+i] == 0){ //an incoming channel with no tokens
+        for (int k=msag.predStart[i]; k<msag.predStart[i+1]; k++){
+          if(tokens[msag.predEdge[k]] == 0){ //an incoming channel with no tokens
             activate = false;
+            break;
           }
         }
         if(activate){ //start transition for actor i (consume tokens, update actor state)
-          for (auto j=0; j<n_msagActors; j++){
-            if(tokens[j*n_msagActors+i] != -1){ 
-              tokens[j*n_msagActors+i] -= 1; //consume tokens
-              //cout << i << " consumes a token from " << j << endl;
-              //cout << ". New amount of tokens on (" << j << ", " << i << "): " << tokens[j*n_msagActors+i] << endl;
-              
+          for (int k=msag.predStart[i]; k<msag.predStart[i+1]; k++){
+            int j = msag.pred[k];
+            if(tokens[msag.predEdge[k]] != -1){
+              tokens[msag.predEdge[k]] -= 1; //consume tokens
+
               //buffer size analysis
               if(minIterations<1){ //during the latency phase
                 //if i is a src and j a block actor, consider the send buffer
                 if(i<n_actors && j>=n_actors && (j-n_actors)%3 == 0){
-                  max_send_buffer[channelMapping[j-n_actors]]--;  
+                  max_send_buffer[channelMapping[j-n_actors]]--;
                   if(max_send_buffer[channelMapping[j-n_actors]]<sendBufferBound_max[channelMapping[j-n_actors]])
                     sendBufferBound_max[channelMapping[j-n_actors]] = max_send_buffer[channelMapping[j-n_actors]];
                 }
                 //if i is a send actor and j a receive actor, consider the rec actor size
                 if(i>n_actors && j>n_actors && (i-n_actors)%3==1 && i+1==j){
-                  max_rec_buffer[channelMapping[i-n_actors]]--; 
-                  //cout << "a: Ch " << i << ": " << max_rec_buffer[channelMapping[i-n_actors]];
-                  //cout << " at time " << time << endl;
+                  max_rec_buffer[channelMapping[i-n_actors]]--;
                   if(max_rec_buffer[channelMapping[i-n_actors]]<recBufferBound_max[channelMapping[i-n_actors]])
                     recBufferBound_max[channelMapping[i-n_actors]] = max_rec_buffer[channelMapping[i-n_actors]];
                 }
               }
             }
           }
-          execution[i] = actor_delay[i];
+          execution[i] = time+actor_delay[i]; //end time of the firing
           max_start[i].push_back(time);
-          //cout << "max_start[" << i << "].size() = " << max_start[i].size() << endl;
-          //determine length of next time transition (min. remaining actor execution demand)
-          if(timeStep == -1)
-            timeStep = actor_delay[i];
-          else if(timeStep > actor_delay[i])
-            timeStep = actor_delay[i];
+          events.push(make_pair(time+actor_delay[i], i));
         }
       }
     }
-    
-    //cout << " Actor state: ";
-    //for (auto i=0; i<n_msagActors; i++){
-    //  cout << execution[i] << " ";
-    //}
-    //cout << endl;
-    
+    candidates.clear();
+
     //Step 2
-    int nextTimeStep = -1;
-    for (auto i=0; i<n_msagActors; i++){
-      if(execution[i] != -1){
-        execution[i] -= timeStep;
-        if(nextTimeStep <= 0)
-          nextTimeStep = execution[i];
-        else if(nextTimeStep > execution[i] && execution[i]>0)
-          nextTimeStep = execution[i];
-      }
+    if(events.empty()){ //no actor can fire anymore: the MSAG is deadlocked
+      if(printDebug) cout << "\tThroughputSSE: deadlock at time " << time << endl;
+      return false;
+    }
+    time = events.top().first;
+    finished.clear();
+    while(!events.empty() && events.top().first == time){
+      finished.push_back(events.top().second);
+      events.pop();
     }
-    time += timeStep;
-    timeStep = nextTimeStep;
-    //cout << "time transition: " << time << endl;
+    sort(finished.begin(), finished.end());
+
     //Step 3
     bool checkIterations = false;
-    for (auto i=0; i<n_msagActors; i++){
-      if(execution[i] == 0){
-        for (auto j=0; j<n_msagActors; j++){
-          if(tokens[i*n_msagActors+j] != -1){ 
-            tokens[i*n_msagActors+j] += 1; //produce tokens
-            //cout << i << " produces a token to " << j << endl;
-            
-            //buffer size analysis
-            if(minIterations<1){ //during the latency phase
-              //if i is a block actor and j a src actor, consider the send buffer
-              if(j<n_actors && i>=n_actors && (i-n_actors)%3 == 0){
-                max_send_buffer[channelMapping[i-n_actors]]++;  
-                if(max_send_buffer[channelMapping[i-n_actors]]<sendBufferBound_max[channelMapping[i-n_actors]])
-                  sendBufferBound_max[channelMapping[i-n_actors]] = max_send_buffer[channelMapping[i-n_actors]];
-              }
-              //if i is a rec actor and j a send actor, consider the rec actor size
-              if(i>n_actors && j>n_actors && (j-n_actors)%3==1 && j+1==i){
-                max_rec_buffer[channelMapping[i-n_actors]]++; 
-                //cout << "b: Ch " << j << ": " << max_rec_buffer[channelMapping[j-n_actors]];
-                //cout << " at time " << time << endl;
-                if(max_rec_buffer[channelMapping[i-n_actors]]<recBufferBound_max[channelMapping[i-n_actors]])
-                  recBufferBound_max[channelMapping[i-n_actors]] = max_rec_buffer[channelMapping[i-n_actors]];
-              }
+    for (int i : finished){
+      for (int e=msag.succStart[i]; e<msag.succStart[i+1]; e++){
+        int j = msag.succ[e];
+        if(tokens[e] != -1){
+          tokens[e] += 1; //produce tokens
+          if(!isCandidate[j]){
+            isCandidate[j] = true;
+            candidates.push_back(j);
+          }
+
+          //buffer size analysis
+          if(minIterations<1){ //during the latency phase
+            //if i is a block actor and j a src actor, consider the send buffer
+            if(j<n_actors && i>=n_actors && (i-n_actors)%3 == 0){
+              max_send_buffer[channelMapping[i-n_actors]]++;
+              if(max_send_buffer[channelMapping[i-n_actors]]<sendBufferBound_max[channelMapping[i-n_actors]])
+                sendBufferBound_max[channelMapping[i-n_actors]] = max_send_buffer[channelMapping[i-n_actors]];
+            }
+            //if i is a rec actor and j a send actor, consider the rec actor size
+            if(i>n_actors && j>n_actors && (j-n_actors)%3==1 && j+1==i){
+              max_rec_buffer[channelMapping[i-n_actors]]++;
+              if(max_rec_buffer[channelMapping[i-n_actors]]<recBufferBound_max[channelMapping[i-n_actors]])
+                recBufferBound_max[channelMapping[i-n_actors]] = max_rec_buffer[channelMapping[i-n_actors]];
             }
           }
         }
-        max_end[i].push_back(time);
-        max_iterations[i]++;
-        if(max_iterations[i] == 1) {
-          checkIterations = true; //to know when latency is fixed
-          if (wc_latency[getApp(i)].size() == 0){
-            wc_latency[getApp(i)].push_back(time);
-          }else{
-            wc_latency[getApp(i)][0] = time;
-          }
-        }else if(max_iterations[i] == 2) {
-          checkIterations = true;
-          wc_period[getApp(i)] = time - wc_latency[getApp(i)][0];
-          //cout << "New period: " << wc_period[getApp(i)];
-          //cout << " (because of " << i << " made 2. it.)" << endl;
-        }else if(max_iterations[i]>2){
-          if(wc_period[getApp(i)] < max_end[i].back() - max_end[i][max_end[i].size()-2]){
-            wc_period[getApp(i)] = max_end[i].back() - max_end[i][max_end[i].size()-2];
-            //cout << "New period: " << wc_period[getApp(i)];
-            //cout << " (because of " << i << " made "<<max_iterations[i]<<" it.)" << endl;
-          }
-          if(maxIterations<max_iterations[i]) maxIterations = max_iterations[i];
+      }
+      if(!isCandidate[i]){
+        isCandidate[i] = true;
+        candidates.push_back(i);
+      }
+      max_end[i].push_back(time);
+      max_iterations[i]++;
+      if(max_iterations[i] == 1) {
+        checkIterations = true; //to know when latency is fixed
+        if (wc_latency[getApp(i)].size() == 0){
+          wc_latency[getApp(i)].push_back(time);
+        }else{
+          wc_latency[getApp(i)][0] = time;
         }
-        
-        execution[i] = -1; //update actor state
+      }else if(max_iterations[i] == 2) {
+        checkIterations = true;
+        wc_period[getApp(i)] = time - wc_latency[getApp(i)][0];
+      }else if(max_iterations[i]>2){
+        if(wc_period[getApp(i)] < max_end[i].back() - max_end[i][max_end[i].size()-2]){
+          wc_period[getApp(i)] = max_end[i].back() - max_end[i][max_end[i].size()-2];
+        }
+        if(maxIterations<max_iterations[i]) maxIterations = max_iterations[i];
       }
+
+      execution[i] = -1; //update actor state
     }
-    
-    //cout << " Actor state: ";
-    //for (auto i=0; i<n_msagActors; i++){
-    //  cout << execution[i] << " ";
-    //}
-    //cout << endl;
-    //cout << "---------------------------------" << endl;
- 
 
     if(checkIterations){
       int curMinIts = 2;
@@ -2236,7 +2241,36 @@ void ThroughputSSE::stateSpaceExploration(){
       }
       minIterations = curMinIts;
     }
+
+    //if the state has been visited before, the exploration has entered a cycle. Actors that
+    //have not fired since then will never fire again: then the MSAG is deadlocked
+    if(minIterations<2){
+      size_t hash = 0;
+      state = tokens;
+      for (auto i=0; i<n_msagActors; i++){
+        state.push_back(execution[i] == -1 ? -1 : execution[i]-time);
+      }
+      for (int x : state){
+        hash ^= std::hash<int>()(x) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      if(hash == savedHash && state == saved){
+        for (auto i=0; i<n_msagActors; i++){
+          if(max_iterations[i]<2 && max_iterations[i] == savedIterations[i]){
+            if(printDebug) cout << "\tThroughputSSE: deadlock of actor " << i << " at time " << time << endl;
+            return false;
+          }
+        }
+      }
+      if(++sinceSaved == power){
+        saved.swap(state);
+        savedHash = hash;
+        savedIterations = max_iterations;
+        power *= 2;
+        sinceSaved = 0;
+      }
+    }
   }
+  total_sseSteps += sseSteps;
   
   //cout  << "\twc_latency: ";
   //for (auto i=0; i<apps.size()-1; i++){
@@ -2267,8 +2301,7 @@ void ThroughputSSE::stateSpaceExploration(){
     
     execution.clear();
     execution.insert(execution.begin(), n_msagActors, -1);
-    tokens.clear();
-    tokens=ch_state_flipped;
+    tokens=msag.tokens;
     
     //Three repeating steps:
     //Step 1: start transitions, update state with consumed tokens & actor state
@@ -2278,12 +2311,10 @@ void ThroughputSSE::stateSpaceExploration(){
       //Step 1
       for (auto i=0; i<n_msagActors; i++){
         if(execution[i] == -1){
-          bool activate = true;
-          for (auto j=0; j<n_msagActors; j++){
-            if(tokens[j*n_msagActors+i] == 0){ //an incoming channel with no tokens
-              activate = false;
-            }
-            if(min_iterations[i]>=max_iterations[i]){
+          //(incoming channels of i in the flipped MSAG are its outgoing channels in the MSAG)
+          bool activate = min_iterations[i]<max_iterations[i];
+          for (int e=msag.succStart[i]; e<msag.succStart[i+1]; e++){
+            if(tokens[e] == 0){ //an incoming channel with no tokens
               activate = false;
             }
           }
@@ -2302,9 +2333,10 @@ void ThroughputSSE::stateSpaceExploration(){
             }
           }
           if(activate){ //start transition for actor i (consume tokens, update actor state)
-            for (auto j=0; j<n_msagActors; j++){
-              if(tokens[j*n_msagActors+i] != -1){ 
-                tokens[j*n_msagActors+i] -= 1; //consume tokens
+            for (int e=msag.succStart[i]; e<msag.succStart[i+1]; e++){
+              int j = msag.succ[e];
+              if(tokens[e] != -1){ 
+                tokens[e] -= 1; //consume tokens
                 //cout << i << "_" << min_iterations[i] << " consumes a token from " << j;
                 //cout << ". New amount of tokens on (" << j << ", " << i << "): " << tokens[j*n_msagActors+i] << endl;
                 
@@ -2373,9 +2405,10 @@ void ThroughputSSE::stateSpaceExploration(){
       bool checkIterations = false;
       for (auto i=0; i<n_msagActors; i++){
         if(execution[i] == 0){
-          for (auto j=0; j<n_msagActors; j++){
-            if(tokens[i*n_msagActors+j] != -1){ 
-              tokens[i*n_msagActors+j] += 1; //produce tokens
+          for (int k=msag.predStart[i]; k<msag.predStart[i+1]; k++){
+            int j = msag.pred[k];
+            if(tokens[msag.predEdge[k]] != -1){ 
+              tokens[msag.predEdge[k]] += 1; //produce tokens
               //cout << i << " produces a token to " << j << endl;
               
               //buffer size analysis
@@ -2561,6 +2594,7 @@ void ThroughputSSE::stateSpaceExploration(){
       cout << min_rec_buffer[i] << "/" << max_rec_buffer[i] << " ";
       }
       cout << endl;*/
+  return true;
 }
 
 
@@ -26,9 +26,11 @@
 #ifndef __THROUGHPUTSSE__
 #define __THROUGHPUTSSE__
 
+#include "msag.hpp"
 #include <gecode/int.hh>
 #include <vector>
 #include <algorithm>
+#include <queue>
 #include <unordered_map>
 #include <chrono>
 #include <sstream>
@@ -97,7 +99,7 @@ protected:
   //receivingActors: for storing/finding the first receiving actor for each dst
   vector<int> receivingActors;
   //to represent the state of state space exploration
-  vector<int> ch_state; //tokens on channels of msag
+  MSAG msag; //channels of msag with their tokens
   vector<int> actor_delay; //actor wcets of msag
 
   //SSE results
@@ -119,7 +121,9 @@ protected:
 
   //for evaluation purposes
   int calls;
-  int total_time;
+  long total_time; //total propagation time (us)
+  int sseSteps; //number of SSE steps (events) in the last call
+  long total_sseSteps; //number of SSE steps in all calls
   bool printDebug;
   
   //builds the intial msaGraph & SSE-matrices
@@ -129,7 +133,8 @@ protected:
   int getSendActor(int ch_id) const;
   int getRecActor(int ch_id) const;
   int getApp(int msagActor_id) const;
-  void stateSpaceExploration();
+  //returns false if the MSAG deadlocks
+  bool stateSpaceExploration();
   void printThroughputGraph();
   void printThroughputGraphAsDot(const string &dir) const;
   void printSchedule(string type, int length, string dir);
@@ -215,6 +220,9 @@ virtual void reschedule(Space& home);
 
 virtual ExecStatus propagate(Space& home, const ModEventDelta&);
 
+//the propagation itself, propagate() accounts its CPU time
+ExecStatus doPropagate(Space& home, const ModEventDelta&);
+
 };
 
 //throughput constraint with propagation on time-based schedule
@@ -28,7 +28,7 @@
 # MODULE PATH AND FILES
 #=======================
 
-CPP_FILES := stringtools.cpp systools.cpp solvers.cpp
+CPP_FILES := stringtools.cpp systools.cpp solvers.cpp snapshot.cpp propagator_stats.cpp solution_file.cpp
 
 
 
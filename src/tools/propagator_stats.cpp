@@ -0,0 +1,248 @@
+#include "propagator_stats.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+namespace tools {
+
+namespace {
+
+const char* names[PropagatorStats::N_PROPAGATORS] = {"ThroughputSSE", "ThroughputMCR", "Schedulability"};
+
+const int TIME_BUCKETS = 496; //8 per power of two, up to 2^64 ns
+const int SIZE_BUCKETS = 33;  //0, then one per power of two
+
+/**
+ * Counters of one thread. Only the owning thread writes, so the atomics
+ * are only needed to make the reads of summary() well-defined; relaxed
+ * loads and stores compile to plain moves.
+ */
+struct Counters {
+  atomic<unsigned long long> calls[PropagatorStats::N_PROPAGATORS];
+  atomic<unsigned long long> failures[PropagatorStats::N_PROPAGATORS];
+  atomic<unsigned long long> total_ns[PropagatorStats::N_PROPAGATORS];
+  atomic<unsigned long long> times[PropagatorStats::N_PROPAGATORS][TIME_BUCKETS];
+  atomic<unsigned long long> sizes[PropagatorStats::N_PROPAGATORS][SIZE_BUCKETS];
+  atomic<unsigned long long> steps[PropagatorStats::N_PROPAGATORS];
+  atomic<unsigned long long> max_steps[PropagatorStats::N_PROPAGATORS];
+
+  Counters() { clear(); }
+
+  void clear() {
+    for(int p = 0; p < PropagatorStats::N_PROPAGATORS; p++){
+      calls[p] = 0;
+      failures[p] = 0;
+      total_ns[p] = 0;
+      steps[p] = 0;
+      max_steps[p] = 0;
+      for(int b = 0; b < TIME_BUCKETS; b++)
+        times[p][b] = 0;
+      for(int b = 0; b < SIZE_BUCKETS; b++)
+        sizes[p][b] = 0;
+    }
+  }
+
+  void addTo(Counters& c) const {
+    for(int p = 0; p < PropagatorStats::N_PROPAGATORS; p++){
+      c.calls[p] += calls[p].load(memory_order_relaxed);
+      c.failures[p] += failures[p].load(memory_order_relaxed);
+      c.total_ns[p] += total_ns[p].load(memory_order_relaxed);
+      c.steps[p] += steps[p].load(memory_order_relaxed);
+      c.max_steps[p] = max(c.max_steps[p].load(memory_order_relaxed), max_steps[p].load(memory_order_relaxed));
+      for(int b = 0; b < TIME_BUCKETS; b++)
+        c.times[p][b] += times[p][b].load(memory_order_relaxed);
+      for(int b = 0; b < SIZE_BUCKETS; b++)
+        c.sizes[p][b] += sizes[p][b].load(memory_order_relaxed);
+    }
+  }
+};
+
+inline void add(atomic<unsigned long long>& c, unsigned long long v) {
+  c.store(c.load(memory_order_relaxed) + v, memory_order_relaxed);
+}
+
+/**
+ * The counters of the running threads, and the sum of the counters of the
+ * threads that have ended.
+ */
+struct Registry {
+  mutex lock;
+  vector<Counters*> live;
+  Counters retired;
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+//counters of the current thread, merged into the retired counters when the thread ends
+struct Local {
+  Counters* counters;
+  Local() : counters(new Counters()) {
+    Registry& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    r.live.push_back(counters);
+  }
+  ~Local() {
+    Registry& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    counters->addTo(r.retired);
+    r.live.erase(find(r.live.begin(), r.live.end(), counters));
+    delete counters;
+  }
+};
+
+thread_local Local local;
+thread_local PropagatorStats::Call* current = nullptr;
+
+int timeBucket(unsigned long long ns) {
+  if(ns < 8)
+    return ns;
+  int msb = 63 - __builtin_clzll(ns);
+  return (msb - 2) * 8 + ((ns >> (msb - 3)) & 7);
+}
+
+//middle of the time range of a bucket
+double bucketTime(int b) {
+  if(b < 8)
+    return b;
+  int msb = b / 8 + 2;
+  double width = (double) (1ULL << (msb - 3));
+  return (8 + b % 8) * width + width / 2;
+}
+
+int sizeBucket(int n) {
+  if(n <= 0)
+    return 0;
+  return 32 - __builtin_clz((unsigned int) n);
+}
+
+double percentile(const atomic<unsigned long long>* hist, unsigned long long calls, double q) {
+  unsigned long long rank = (unsigned long long) (q * calls);
+  if(rank >= calls)
+    rank = calls - 1;
+  unsigned long long seen = 0;
+  for(int b = 0; b < TIME_BUCKETS; b++){
+    seen += hist[b].load(memory_order_relaxed);
+    if(seen > rank)
+      return bucketTime(b);
+  }
+  return 0;
+}
+
+}
+
+PropagatorStats::Call::Call(Propagator p) :
+    prop(p), fail(false), msagSize(-1), n_steps(0), start(chrono::steady_clock::now()) {
+  current = this;
+}
+
+PropagatorStats::Call::~Call() {
+  unsigned long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+  Counters& c = *local.counters;
+  add(c.calls[prop], 1);
+  add(c.total_ns[prop], ns);
+  add(c.times[prop][timeBucket(ns)], 1);
+  if(fail)
+    add(c.failures[prop], 1);
+  if(msagSize >= 0)
+    add(c.sizes[prop][sizeBucket(msagSize)], 1);
+  add(c.steps[prop], n_steps);
+  if(n_steps > c.max_steps[prop].load(memory_order_relaxed))
+    c.max_steps[prop].store(n_steps, memory_order_relaxed);
+  current = nullptr;
+}
+
+void PropagatorStats::size(int n) {
+  if(current != nullptr)
+    current->msagSize = n;
+}
+
+void PropagatorStats::steps(unsigned long long n) {
+  if(current != nullptr)
+    current->n_steps += n;
+}
+
+vector<PropagatorStats::Summary> PropagatorStats::summary() {
+  Counters* total = new Counters(); //too large for the stack of a search thread
+  {
+    Registry& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    r.retired.addTo(*total);
+    for(Counters* c : r.live)
+      c->addTo(*total);
+  }
+  vector<Summary> result;
+  for(int p = 0; p < N_PROPAGATORS; p++){
+    unsigned long long calls = total->calls[p];
+    if(calls == 0)
+      continue;
+    Summary s;
+    s.name = names[p];
+    s.calls = calls;
+    s.failures = total->failures[p];
+    s.total_ms = total->total_ns[p] / 1e6;
+    s.p50_us = percentile(total->times[p], calls, 0.5) / 1000;
+    s.p99_us = percentile(total->times[p], calls, 0.99) / 1000;
+    s.steps = total->steps[p];
+    s.max_steps = total->max_steps[p];
+    for(int b = 0; b < SIZE_BUCKETS; b++){
+      if(total->sizes[p][b] > 0)
+        s.sizes.push_back(make_pair(b == 0 ? 0 : 1 << (b - 1), (unsigned long long) total->sizes[p][b]));
+    }
+    result.push_back(s);
+  }
+  delete total;
+  return result;
+}
+
+void PropagatorStats::reset() {
+  Registry& r = registry();
+  lock_guard<mutex> guard(r.lock);
+  r.retired.clear();
+  for(Counters* c : r.live)
+    c->clear();
+}
+
+void PropagatorStats::print(ostream& out, double search_ms) {
+  vector<Summary> stats = summary();
+  if(stats.empty())
+    return;
+  ios::fmtflags flags = out.flags();
+  streamsize precision = out.precision();
+  out << "*** Propagator CPU accounting ***" << endl;
+  out << left << setw(16) << "propagator" << right << setw(12) << "calls" << setw(10) << "failures"
+      << setw(12) << "total [ms]" << setw(12) << "search [%]" << setw(11) << "mean [us]"
+      << setw(10) << "p50 [us]" << setw(10) << "p99 [us]" << endl;
+  out << fixed << setprecision(1);
+  for(const Summary& s : stats){
+    out << left << setw(16) << s.name << right << setw(12) << s.calls << setw(10) << s.failures
+        << setw(12) << s.total_ms << setw(12) << (search_ms > 0 ? 100 * s.total_ms / search_ms : 0)
+        << setw(11) << 1000 * s.total_ms / s.calls << setw(10) << s.p50_us << setw(10) << s.p99_us << endl;
+  }
+  for(const Summary& s : stats){
+    if(s.sizes.empty())
+      continue;
+    out << "  " << s.name << " MSAG actors:";
+    for(auto& b : s.sizes){
+      out << " " << b.first << (b.first > 1 ? "-" + to_string(2 * b.first - 1) : "") << ": " << b.second;
+    }
+    out << endl;
+  }
+  for(const Summary& s : stats){
+    if(s.steps == 0)
+      continue;
+    out << "  " << s.name << " steps: " << s.steps << " (mean " << (double) s.steps / s.calls
+        << ", max " << s.max_steps << " per call)" << endl;
+  }
+  out << "  (search [%]: share of the wall time of the search, summed over all search threads)" << endl;
+  out.flags(flags);
+  out.precision(precision);
+}
+
+}
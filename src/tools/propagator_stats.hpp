@@ -0,0 +1,74 @@
+#ifndef TOOLS_PROPAGATOR_STATS_HPP_
+#define TOOLS_PROPAGATOR_STATS_HPP_
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <chrono>
+
+namespace tools {
+
+/**
+ * CPU accounting of the expensive propagators (throughput analysis and
+ * schedulability): number of propagate() calls, failures, time per call,
+ * the size of the analysed MSAG and the steps of the analysis (SSE steps).
+ *
+ * Each thread counts into its own block, so that the propagators of all
+ * clones and search threads can record without synchronization; the blocks
+ * are only summed up when a summary is requested. Times are kept in a
+ * logarithmic histogram (8 buckets per power of two), from which the
+ * percentiles are taken, so p50/p99 are exact up to about 6%.
+ */
+class PropagatorStats {
+public:
+  enum Propagator { THROUGHPUT_SSE, THROUGHPUT_MCR, SCHEDULABILITY, N_PROPAGATORS };
+
+  /**
+   * Times one call of propagate(), from construction to destruction.
+   */
+  class Call {
+  public:
+    Call(Propagator p);
+    ~Call();
+    //marks the call as failed (ES_FAILED)
+    void failed(bool f) { fail = f; }
+  private:
+    Propagator prop;
+    bool fail;
+    int msagSize;
+    unsigned long long n_steps;
+    std::chrono::steady_clock::time_point start;
+    friend class PropagatorStats;
+  };
+
+  //size of the MSAG analysed in the current call of this thread (number of actors)
+  static void size(int n);
+  //steps of the analysis in the current call of this thread (events of the SSE)
+  static void steps(unsigned long long n);
+
+  struct Summary {
+    std::string name;
+    unsigned long long calls;
+    unsigned long long failures;
+    double total_ms;
+    double p50_us;
+    double p99_us;
+    unsigned long long steps; //of all calls, 0: not counted
+    unsigned long long max_steps; //of one call
+    //(smallest size of the bucket, number of calls), for sizes in [2^k, 2^(k+1))
+    std::vector<std::pair<int, unsigned long long>> sizes;
+  };
+  //sums up the counters of all threads, for the propagators with at least one call
+  static std::vector<Summary> summary();
+  //clears the counters of all threads
+  static void reset();
+  /**
+   * Prints the summary as a table.
+   * @param search_ms wall time of the search, for the share of the propagators
+   */
+  static void print(std::ostream& out, double search_ms);
+};
+
+}
+
+#endif /* TOOLS_PROPAGATOR_STATS_HPP_ */
@@ -0,0 +1,49 @@
+#ifndef TOOLS_RESPONSE_TIME_HPP_
+#define TOOLS_RESPONSE_TIME_HPP_
+
+#include <vector>
+#include <utility>
+
+namespace tools {
+
+/**
+ * Worst-case response time of a task under preemptive fixed-priority
+ * scheduling, i.e. the least fixpoint of
+ *
+ *   R = C + sum_j ceil(R / T_j) * C_j
+ *
+ * over the higher-priority tasks j on the same processor. The iteration
+ * only visits the scheduling points where the workload steps, so it takes
+ * a handful of steps instead of one per time unit up to the deadline.
+ *
+ * The task is schedulable iff the result is <= deadline; this is the same
+ * as the time demand test (some t in [1, deadline] with workload(t) <= t).
+ *
+ * @param wcet C of the task
+ * @param hp (wcet, period) of the higher-priority tasks
+ * @param deadline the iteration stops as soon as R exceeds it
+ * @param start a lower bound of R to start from, e.g. the response time
+ *        computed before tasks were added or WCETs increased
+ * @return the response time, or deadline+1 if it exceeds the deadline
+ */
+inline long long responseTime(long long wcet, const std::vector<std::pair<int, int>>& hp,
+                              long long deadline, long long start = 0) {
+  long long R = wcet;
+  for(auto& t : hp)
+    R += t.first;
+  if(start > R)
+    R = start;
+  while(R <= deadline){
+    long long W = wcet;
+    for(auto& t : hp)
+      W += ((R + t.second - 1) / t.second) * t.first;
+    if(W == R)
+      return R;
+    R = W;
+  }
+  return deadline + 1;
+}
+
+}
+
+#endif /* TOOLS_RESPONSE_TIME_HPP_ */
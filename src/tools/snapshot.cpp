@@ -0,0 +1,162 @@
+#include "snapshot.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+//incremented whenever the layout of a stored object changes
+const int64_t SNAPSHOT_VERSION = 3;
+const char SNAPSHOT_MAGIC[8] = {'D', 'S', 'Y', 'S', 'N', 'A', 'P', '\0'};
+
+const uint64_t FNV_PRIME = 1099511628211ULL;
+}
+
+uint64_t tools::hashString(const std::string& str, uint64_t h) throw () {
+  for(unsigned char c : str){
+    h ^= c;
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+uint64_t tools::hashFile(const std::string& path) throw (IOException) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    THROW_EXCEPTION(IOException, path, "cannot open file");
+  struct stat st;
+  fstat(fd, &st);
+  uint64_t h = 14695981039346656037ULL;
+  if(st.st_size > 0){
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(p == MAP_FAILED){
+      ::close(fd);
+      THROW_EXCEPTION(IOException, path, "cannot map file");
+    }
+    const unsigned char* c = (const unsigned char*) p;
+    for(off_t i = 0; i < st.st_size; i++){
+      h ^= c[i];
+      h *= FNV_PRIME;
+    }
+    munmap(p, st.st_size);
+  }
+  ::close(fd);
+  return h;
+}
+
+tools::SnapshotWriter::SnapshotWriter(const std::string& _path, const std::string& kind) throw (IOException)
+  : path(_path), tmp_path(_path + ".tmp" + std::to_string(getpid())) {
+  file = fopen(tmp_path.c_str(), "wb");
+  if(!file)
+    THROW_EXCEPTION(IOException, tmp_path, "cannot write snapshot");
+  fwrite(SNAPSHOT_MAGIC, 1, sizeof(SNAPSHOT_MAGIC), file);
+  put(SNAPSHOT_VERSION);
+  put(kind);
+}
+
+tools::SnapshotWriter::~SnapshotWriter() {
+  if(file){ //not committed
+    fclose(file);
+    remove(tmp_path.c_str());
+  }
+}
+
+void tools::SnapshotWriter::put(int64_t v) {
+  fwrite(&v, sizeof(v), 1, file);
+}
+
+void tools::SnapshotWriter::put(double v) {
+  fwrite(&v, sizeof(v), 1, file);
+}
+
+void tools::SnapshotWriter::put(const std::string& v) {
+  put((int64_t) v.size());
+  fwrite(v.data(), 1, v.size(), file);
+}
+
+void tools::SnapshotWriter::commit() throw (IOException) {
+  bool ok = !ferror(file);
+  ok = (fclose(file) == 0) && ok;
+  file = nullptr;
+  if(!ok || rename(tmp_path.c_str(), path.c_str()) != 0){
+    remove(tmp_path.c_str());
+    THROW_EXCEPTION(IOException, path, "cannot write snapshot");
+  }
+}
+
+tools::SnapshotReader::SnapshotReader() : data(nullptr), size(0), pos(0) {}
+
+tools::SnapshotReader::~SnapshotReader() {
+  close();
+}
+
+void tools::SnapshotReader::close() {
+  if(data)
+    munmap((void*) data, size);
+  data = nullptr;
+  size = pos = 0;
+}
+
+bool tools::SnapshotReader::open(const std::string& _path, const std::string& kind) {
+  close();
+  path = _path;
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    return false;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(SNAPSHOT_MAGIC)){
+    ::close(fd);
+    return false;
+  }
+  void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(p == MAP_FAILED)
+    return false;
+  data = (const char*) p;
+  size = st.st_size;
+  pos = sizeof(SNAPSHOT_MAGIC);
+  try {
+    if(memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+       && getInt() == SNAPSHOT_VERSION && getString() == kind)
+      return true;
+  } catch (IOException&) {}
+  close();
+  return false;
+}
+
+void tools::SnapshotReader::need(size_t n) throw (IOException) {
+  if(pos + n > size)
+    THROW_EXCEPTION(IOException, path, "truncated snapshot");
+}
+
+size_t tools::SnapshotReader::checkedSize() throw (IOException) {
+  int64_t n = getInt();
+  if(n < 0 || (size_t) n > size - pos)
+    THROW_EXCEPTION(IOException, path, "corrupt snapshot");
+  return n;
+}
+
+int64_t tools::SnapshotReader::getInt() throw (IOException) {
+  int64_t v;
+  need(sizeof(v));
+  memcpy(&v, data + pos, sizeof(v));
+  pos += sizeof(v);
+  return v;
+}
+
+double tools::SnapshotReader::getDouble() throw (IOException) {
+  double v;
+  need(sizeof(v));
+  memcpy(&v, data + pos, sizeof(v));
+  pos += sizeof(v);
+  return v;
+}
+
+std::string tools::SnapshotReader::getString() throw (IOException) {
+  size_t n = checkedSize();
+  std::string v(data + pos, n);
+  pos += n;
+  return v;
+}
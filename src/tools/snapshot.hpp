@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TOOLS_SNAPSHOT_HPP_
+#define TOOLS_SNAPSHOT_HPP_
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <cstdio>
+#include "../exceptions/ioexception.h"
+
+using namespace DeSyDe;
+
+namespace tools {
+
+/**
+ * 64-bit FNV-1a hash of the content of a file.
+ */
+uint64_t hashFile(const std::string& path) throw (IOException);
+
+/**
+ * 64-bit FNV-1a hash of a string, continuing from h.
+ */
+uint64_t hashString(const std::string& str, uint64_t h = 14695981039346656037ULL) throw ();
+
+/**
+ * Writes a binary snapshot of built objects. The data is written to a
+ * temporary file, which replaces the snapshot in commit(), so that readers
+ * never see a partial snapshot.
+ */
+class SnapshotWriter {
+public:
+  /**
+   * @param path snapshot file
+   * @param kind kind of the stored object, checked by the reader
+   */
+  SnapshotWriter(const std::string& path, const std::string& kind) throw (IOException);
+  ~SnapshotWriter();
+
+  void put(int64_t v);
+  void put(double v);
+  void put(const std::string& v);
+  template<class T> void put(const std::vector<T>& v) {
+    put((int64_t) v.size());
+    for(const auto& x : v)
+      put(x);
+  }
+  template<class T> void put(const std::set<T>& v) {
+    put((int64_t) v.size());
+    for(const auto& x : v)
+      put(x);
+  }
+  void put(int v) { put((int64_t) v); }
+  void put(size_t v) { put((int64_t) v); }
+  void put(bool v) { put((int64_t) v); }
+
+  void commit() throw (IOException);
+
+private:
+  std::string path;
+  std::string tmp_path;
+  FILE* file;
+};
+
+/**
+ * Reads a snapshot written by SnapshotWriter. The file is memory-mapped and
+ * decoded in place.
+ */
+class SnapshotReader {
+public:
+  SnapshotReader();
+  ~SnapshotReader();
+
+  /**
+   * Opens the snapshot. Returns false if it does not exist or was written
+   * for another kind of object or another format version.
+   */
+  bool open(const std::string& path, const std::string& kind);
+
+  int64_t getInt() throw (IOException);
+  double getDouble() throw (IOException);
+  std::string getString() throw (IOException);
+  void get(int& v) { v = getInt(); }
+  void get(size_t& v) { v = getInt(); }
+  void get(bool& v) { v = getInt(); }
+  void get(int64_t& v) { v = getInt(); }
+  void get(double& v) { v = getDouble(); }
+  void get(std::string& v) { v = getString(); }
+  template<class T> void get(std::vector<T>& v) {
+    v.resize(checkedSize());
+    for(size_t i = 0; i < v.size(); i++){
+      T x;
+      get(x);
+      v[i] = x;
+    }
+  }
+  template<class T> void get(std::set<T>& v) {
+    v.clear();
+    size_t n = checkedSize();
+    for(size_t i = 0; i < n; i++){
+      T x;
+      get(x);
+      v.insert(x);
+    }
+  }
+
+private:
+  const char* data;
+  size_t size;
+  size_t pos;
+  std::string path;
+
+  void need(size_t n) throw (IOException);
+  //reads a container size, bounded by the remaining data
+  size_t checkedSize() throw (IOException);
+  void close();
+};
+
+}
+
+#endif
@@ -0,0 +1,301 @@
+#include "solution_file.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+//incremented whenever the layout changes
+const uint32_t SOLUTION_FILE_VERSION = 1;
+const char SOLUTION_FILE_MAGIC[8] = {'D', 'S', 'Y', 'S', 'O', 'L', 'S', '\0'};
+const uint32_t FLAG_DELTA = 1;
+const size_t BLOCK_HEADER = 8;
+
+size_t pad8(size_t n){
+  return (n + 7) & ~(size_t) 7;
+}
+
+int widthOf(int lo, int hi){
+  int64_t range = (int64_t) hi - lo;
+  if(range <= INT8_MAX) return 1;
+  if(range <= INT16_MAX) return 2;
+  return 4;
+}
+
+//stores the lower width bytes of the two's complement of v
+void store(char* p, uint32_t v, int width){
+  if(width == 1){
+    int8_t x = (int8_t) v;
+    memcpy(p, &x, 1);
+  }else if(width == 2){
+    int16_t x = (int16_t) v;
+    memcpy(p, &x, 2);
+  }else{
+    memcpy(p, &v, 4);
+  }
+}
+
+//sign-extends a stored value
+uint32_t load(const char* p, int width){
+  if(width == 1){
+    int8_t x;
+    memcpy(&x, p, 1);
+    return (uint32_t) (int32_t) x;
+  }else if(width == 2){
+    int16_t x;
+    memcpy(&x, p, 2);
+    return (uint32_t) (int32_t) x;
+  }
+  uint32_t x;
+  memcpy(&x, p, 4);
+  return x;
+}
+
+template<class T> void putRaw(std::vector<char>& buf, const T& v){
+  const char* p = (const char*) &v;
+  buf.insert(buf.end(), p, p + sizeof(T));
+}
+}
+
+size_t tools::solutionBlockSize(const std::vector<SolutionColumn>& columns, size_t rows){
+  size_t n = 0;
+  for(auto& c : columns)
+    n += c.count * pad8(rows * c.width);
+  return n;
+}
+
+tools::SolutionFileWriter::SolutionFileWriter(const std::string& _path, const std::vector<SolutionColumn>& columns,
+                                              bool _delta, uint32_t _block_rows) throw (IOException)
+  : path(_path), file(nullptr), schema(columns), delta(_delta), block_rows(_block_rows), row_width(0) {
+  if(block_rows == 0)
+    THROW_EXCEPTION(IOException, path, "a block needs at least one solution");
+  std::vector<char> header(SOLUTION_FILE_MAGIC, SOLUTION_FILE_MAGIC + sizeof(SOLUTION_FILE_MAGIC));
+  putRaw(header, SOLUTION_FILE_VERSION);
+  putRaw(header, delta ? FLAG_DELTA : (uint32_t) 0);
+  putRaw(header, block_rows);
+  putRaw(header, (uint32_t) schema.size());
+  for(auto& c : schema){
+    if(c.count < 0 || c.hi < c.lo)
+      THROW_EXCEPTION(IOException, path, "invalid column " + c.name);
+    c.width = widthOf(c.lo, c.hi);
+    row_width += c.count;
+    putRaw(header, (uint32_t) c.name.size());
+    header.insert(header.end(), c.name.begin(), c.name.end());
+    putRaw(header, (int32_t) c.count);
+    putRaw(header, (int32_t) c.lo);
+    putRaw(header, (int32_t) c.hi);
+    putRaw(header, (int32_t) c.width);
+  }
+  header.resize(pad8(header.size()), 0);
+
+  file = fopen(path.c_str(), "wb");
+  if(!file)
+    THROW_EXCEPTION(IOException, path, "cannot write solution file");
+  if(fwrite(header.data(), 1, header.size(), file) != header.size())
+    THROW_EXCEPTION(IOException, path, "cannot write solution file");
+  rows.reserve(block_rows * row_width);
+}
+
+tools::SolutionFileWriter::~SolutionFileWriter() {
+  try{
+    close();
+  }catch(IOException&){
+  }
+}
+
+void tools::SolutionFileWriter::append(const std::vector<int>& values) throw (IOException) {
+  if(!file)
+    THROW_EXCEPTION(IOException, path, "solution file is closed");
+  if(values.size() != row_width)
+    THROW_EXCEPTION(IOException, path, "solution does not match the columns");
+  size_t k = 0;
+  for(auto& c : schema){
+    for(int e = 0; e < c.count; e++, k++){
+      if(values[k] < c.lo || values[k] > c.hi)
+        THROW_EXCEPTION(IOException, path, "value " + std::to_string(values[k]) + " of column " + c.name + " out of range");
+    }
+  }
+  rows.insert(rows.end(), values.begin(), values.end());
+  if(rows.size() == block_rows * row_width)
+    writeBlock();
+}
+
+void tools::SolutionFileWriter::writeBlock() throw (IOException) {
+  size_t n = row_width > 0 ? rows.size() / row_width : 0;
+  if(n == 0)
+    return;
+  block.assign(BLOCK_HEADER + solutionBlockSize(schema, n), 0);
+  uint32_t n32 = n;
+  memcpy(block.data(), &n32, sizeof(n32));
+  char* p = block.data() + BLOCK_HEADER;
+  size_t k = 0; //element in the row
+  for(auto& c : schema){
+    for(int e = 0; e < c.count; e++, k++){
+      for(size_t r = 0; r < n; r++){
+        int prev = delta && r > 0 ? rows[(r-1) * row_width + k] : c.lo;
+        store(p + r * c.width, (uint32_t) rows[r * row_width + k] - (uint32_t) prev, c.width);
+      }
+      p += pad8(n * c.width);
+    }
+  }
+  if(fwrite(block.data(), 1, block.size(), file) != block.size())
+    THROW_EXCEPTION(IOException, path, "cannot write solution file");
+  rows.clear();
+}
+
+void tools::SolutionFileWriter::close() throw (IOException) {
+  if(!file)
+    return;
+  writeBlock();
+  bool ok = !ferror(file);
+  ok = (fclose(file) == 0) && ok;
+  file = nullptr;
+  if(!ok)
+    THROW_EXCEPTION(IOException, path, "cannot write solution file");
+}
+
+tools::SolutionFileReader::SolutionFileReader()
+  : data(nullptr), size(0), delta(false), block_rows(0), row_width(0),
+    data_start(0), block_size(0), n_blocks(0), n_rows(0) {}
+
+tools::SolutionFileReader::~SolutionFileReader() {
+  close();
+}
+
+void tools::SolutionFileReader::close() {
+  if(data)
+    munmap((void*) data, size);
+  data = nullptr;
+  size = 0;
+  schema.clear();
+  n_blocks = n_rows = row_width = 0;
+}
+
+void tools::SolutionFileReader::open(const std::string& _path) throw (IOException) {
+  close();
+  path = _path;
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    THROW_EXCEPTION(IOException, path, "cannot open file");
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(SOLUTION_FILE_MAGIC)){
+    ::close(fd);
+    THROW_EXCEPTION(IOException, path, "not a solution file");
+  }
+  void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(p == MAP_FAILED)
+    THROW_EXCEPTION(IOException, path, "cannot map file");
+  data = (const char*) p;
+  size = st.st_size;
+
+  size_t pos = 0;
+  auto get = [&](void* v, size_t n){
+    if(pos + n > size)
+      THROW_EXCEPTION(IOException, path, "truncated header");
+    memcpy(v, data + pos, n);
+    pos += n;
+  };
+  char magic[sizeof(SOLUTION_FILE_MAGIC)];
+  uint32_t version, flags, n_columns;
+  get(magic, sizeof(magic));
+  get(&version, sizeof(version));
+  if(memcmp(magic, SOLUTION_FILE_MAGIC, sizeof(magic)) != 0 || version != SOLUTION_FILE_VERSION)
+    THROW_EXCEPTION(IOException, path, "not a solution file of version " + std::to_string(SOLUTION_FILE_VERSION));
+  get(&flags, sizeof(flags));
+  get(&block_rows, sizeof(block_rows));
+  get(&n_columns, sizeof(n_columns));
+  delta = flags & FLAG_DELTA;
+  for(uint32_t i = 0; i < n_columns; i++){
+    SolutionColumn c;
+    uint32_t length;
+    int32_t v[4];
+    get(&length, sizeof(length));
+    if(pos + length > size)
+      THROW_EXCEPTION(IOException, path, "truncated header");
+    c.name.assign(data + pos, length);
+    pos += length;
+    get(v, sizeof(v));
+    c.count = v[0];
+    c.lo = v[1];
+    c.hi = v[2];
+    c.width = v[3];
+    if(c.count < 0 || (c.width != 1 && c.width != 2 && c.width != 4))
+      THROW_EXCEPTION(IOException, path, "invalid column " + c.name);
+    row_width += c.count;
+    schema.push_back(c);
+  }
+  data_start = pad8(pos);
+  block_size = BLOCK_HEADER + solutionBlockSize(schema, block_rows);
+  if(block_rows == 0 || data_start > size)
+    THROW_EXCEPTION(IOException, path, "invalid header");
+
+  //all blocks but the last are full, an incomplete last block (interrupted run) is ignored
+  n_blocks = (size - data_start) / block_size;
+  n_rows = n_blocks * block_rows;
+  size_t rest = size - data_start - n_blocks * block_size;
+  uint32_t last_rows = block_rows;
+  if(n_blocks > 0)
+    memcpy(&last_rows, data + data_start + (n_blocks - 1) * block_size, sizeof(last_rows));
+  if(last_rows < block_rows){ //with padding, a last block can be as large as a full one
+    n_rows -= block_rows - last_rows;
+  }else if(rest >= BLOCK_HEADER){
+    uint32_t rows;
+    memcpy(&rows, data + data_start + n_blocks * block_size, sizeof(rows));
+    if(rows > 0 && rows < block_rows && BLOCK_HEADER + solutionBlockSize(schema, rows) <= rest){
+      n_blocks++;
+      n_rows += rows;
+    }
+  }
+}
+
+size_t tools::SolutionFileReader::blockAt(size_t b, size_t& rows) const throw (IOException) {
+  if(b >= n_blocks)
+    THROW_EXCEPTION(IOException, path, "no block " + std::to_string(b));
+  size_t offset = data_start + b * block_size;
+  uint32_t r;
+  memcpy(&r, data + offset, sizeof(r));
+  if(r > block_rows || (r < block_rows && b + 1 < n_blocks))
+    THROW_EXCEPTION(IOException, path, "corrupt block " + std::to_string(b));
+  rows = r;
+  return offset + BLOCK_HEADER;
+}
+
+size_t tools::SolutionFileReader::readBlock(size_t b, std::vector<int>& values) const throw (IOException) {
+  size_t n;
+  const char* p = data + blockAt(b, n);
+  values.resize(n * row_width);
+  size_t k = 0;
+  for(auto& c : schema){
+    for(int e = 0; e < c.count; e++, k++){
+      for(size_t r = 0; r < n; r++){
+        uint32_t prev = delta && r > 0 ? (uint32_t) values[(r-1) * row_width + k] : (uint32_t) c.lo;
+        values[r * row_width + k] = (int) (prev + load(p + r * c.width, c.width));
+      }
+      p += pad8(n * c.width);
+    }
+  }
+  return n;
+}
+
+int tools::SolutionFileReader::value(size_t row, size_t column, int element) const throw (IOException) {
+  if(row >= n_rows || column >= schema.size() || element < 0 || element >= schema[column].count)
+    THROW_EXCEPTION(IOException, path, "no value at solution " + std::to_string(row) + ", column " + std::to_string(column));
+  size_t n;
+  const char* p = data + blockAt(row / block_rows, n);
+  size_t r = row % block_rows;
+  for(size_t c = 0; c < column; c++)
+    p += schema[c].count * pad8(n * schema[c].width);
+  const SolutionColumn& c = schema[column];
+  p += element * pad8(n * c.width);
+  uint32_t v = c.lo;
+  if(delta){
+    for(size_t i = 0; i <= r; i++)
+      v += load(p + i * c.width, c.width);
+  }else{
+    v += load(p + r * c.width, c.width);
+  }
+  return (int) v;
+}
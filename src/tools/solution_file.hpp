@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2013-2016, Kathrin Rosvall  <krosvall@kth.se>
+ *                          George Ungureanu <ugeorge@kth.se>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TOOLS_SOLUTION_FILE_HPP_
+#define TOOLS_SOLUTION_FILE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include "../exceptions/ioexception.h"
+
+using namespace DeSyDe;
+
+namespace tools {
+
+/**
+ * Column of a solution file: count integers per solution, all in [lo, hi].
+ */
+struct SolutionColumn {
+  std::string name;
+  int count;
+  int lo, hi;
+  int width; /**< bytes per stored value (1, 2 or 4), set by the writer. */
+};
+
+/**
+ * Writes the solutions of an enumeration into a binary columnar file
+ * (output-file-type BIN).
+ *
+ * The schema is fixed when the file is created. The solutions are stored
+ * in blocks of block_rows rows, and within a block every element of every
+ * column is stored contiguously over the rows. A value takes 1, 2 or 4
+ * bytes, depending on hi - lo of its column, and is stored as v - lo, or
+ * with delta encoding as the difference to the previous row of the block
+ * (the first row of a block stores v - lo). All blocks but the last are
+ * full and have the same size, so a memory-mapped file gives random access
+ * to the blocks.
+ *
+ * Layout, in native byte order:
+ *   header: magic "DSYSOLS\0", uint32 version, uint32 flags (1: delta),
+ *           uint32 block_rows, uint32 n_columns,
+ *           per column: uint32 name length, name, int32 count, lo, hi, width,
+ *           padding to 8 bytes
+ *   block:  uint32 rows, uint32 0,
+ *           per column and element: rows values, padding to 8 bytes
+ */
+class SolutionFileWriter {
+public:
+  /**
+   * Creates the file and writes the header.
+   */
+  SolutionFileWriter(const std::string& path, const std::vector<SolutionColumn>& columns,
+                     bool delta, uint32_t block_rows = 4096) throw (IOException);
+  ~SolutionFileWriter();
+
+  /**
+   * Appends a solution.
+   * @param values the values of all columns, in the order of the schema
+   */
+  void append(const std::vector<int>& values) throw (IOException);
+  /**
+   * Writes the last block and closes the file.
+   */
+  void close() throw (IOException);
+
+  const std::vector<SolutionColumn>& columns() const { return schema; }
+
+private:
+  std::string path;
+  FILE* file;
+  std::vector<SolutionColumn> schema;
+  bool delta;
+  uint32_t block_rows;
+  size_t row_width; /**< integers per solution. */
+  std::vector<int> rows; /**< solutions of the current block, row by row. */
+  std::vector<char> block; /**< encoding buffer of a block. */
+
+  void writeBlock() throw (IOException);
+};
+
+/**
+ * Reads a file written by SolutionFileWriter. The file is memory-mapped
+ * and decoded block by block.
+ */
+class SolutionFileReader {
+public:
+  SolutionFileReader();
+  ~SolutionFileReader();
+
+  void open(const std::string& path) throw (IOException);
+
+  const std::vector<SolutionColumn>& columns() const { return schema; }
+  bool deltaEncoded() const { return delta; }
+  size_t rows() const { return n_rows; }
+  size_t blocks() const { return n_blocks; }
+  /** integers per solution. */
+  size_t rowWidth() const { return row_width; }
+
+  /**
+   * Decodes block b.
+   * @param values the solutions of the block, row by row
+   * @return the number of solutions of the block
+   */
+  size_t readBlock(size_t b, std::vector<int>& values) const throw (IOException);
+  /**
+   * Decodes one value: element of column of solution row.
+   */
+  int value(size_t row, size_t column, int element) const throw (IOException);
+
+private:
+  const char* data;
+  size_t size;
+  std::string path;
+  std::vector<SolutionColumn> schema;
+  bool delta;
+  uint32_t block_rows;
+  size_t row_width;
+  size_t data_start; /**< offset of the first block. */
+  size_t block_size; /**< size of a full block. */
+  size_t n_blocks, n_rows;
+
+  //offset and number of rows of block b
+  size_t blockAt(size_t b, size_t& rows) const throw (IOException);
+  void close();
+};
+
+/**
+ * Size of the values of a block of rows solutions, with padding.
+ */
+size_t solutionBlockSize(const std::vector<SolutionColumn>& columns, size_t rows);
+
+}
+
+#endif
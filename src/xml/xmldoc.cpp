@@ -109,6 +109,10 @@ void XMLdoc::readXSD (const char* xsd_uri) throw (IOException) {
 }
 
 
+const string& XMLdoc::getPath() const throw () {
+  return path_;
+}
+
 void XMLdoc::dump (string filepath) throw (IOException) {
   fs::path p (filepath);
   if (!fs::exists(p.parent_path()) || !fs::is_directory(p.parent_path()))
@@ -101,6 +101,9 @@ public:
   void readXSD(const char* xsd_uri) throw (IOException);
 
 
+  /** @brief Path of the XML file */
+  const std::string& getPath() const throw ();
+
   /** @brief Dumps this document to a file */
   void dump(std::string filepath) throw (IOException);
 